@@ -0,0 +1,503 @@
+//============================================================================
+// Name        : IrCodeDatabase.cpp
+// Description : Host tool to build the IR code database (RemoteControl/Sources/ir-code-database.h)
+//
+// The database is built from the sheets of "Data Files/Infrared Controller Codes.ods"
+// exported as CSV (one file per sheet).
+// Each key row has the key name in column B followed by the code:
+//    nec, panasonic   B = name, C = code e.g. 0xAA55FF00
+//    samsung          B = name, C = device e.g. 0x0020, D = code e.g. 0xD7287
+//    sony             B = name, C = function, D = device, E = length (12 or 15)
+// Other rows (titles, headings) are ignored.
+//
+// The fixed address fields of each device are stored once and checked to be the
+// same for every key. Redundant fields (~F) are checked and dropped.
+//
+// Usage:
+//    IrCodeDatabase <output.h> { <protocol> <device name> <sheet.csv> }
+// e.g.
+//    IrCodeDatabase ir-code-database.h nec "Laser DVD" "Laser DVD.csv" sony "Sony TV" "Sony TV.csv"
+//============================================================================
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <algorithm>
+
+#include "../../RemoteControl/Sources/ir-code-format.h"
+
+using namespace USBDM;
+
+/**
+ * Key read from a sheet
+ */
+struct Key {
+   std::string name;       ///< Key name e.g. ON_OFF
+   uint8_t     function;   ///< Function field
+   uint8_t     data;       ///< Additional field (see IrCodeFormat::KeyCode)
+};
+
+/**
+ * Device read from a sheet
+ */
+struct Device {
+   std::string           name;        ///< Device name e.g. "Laser DVD"
+   std::string           sheet;       ///< CSV file
+   IrCodeFormat::Protocol protocol;   ///< Protocol
+   unsigned              device;      ///< Device field (D)
+   unsigned              subDevice;   ///< Sub-device field (S)
+   unsigned              extension;   ///< Extension field (E)
+   std::vector<Key>      keys;        ///< Keys
+};
+
+/**
+ * Report error and exit
+ *
+ * @param device  Device being processed
+ * @param line    Line in CSV file (0 => none)
+ * @param message Message to report
+ */
+[[noreturn]] static void error(const Device &device, unsigned line, const char *message) {
+   if (line != 0) {
+      fprintf(stderr, "%s:%u: %s\n", device.sheet.c_str(), line, message);
+   }
+   else {
+      fprintf(stderr, "%s: %s\n", device.sheet.c_str(), message);
+   }
+   exit(EXIT_FAILURE);
+}
+
+/**
+ * Split a CSV line into fields.
+ * Quoted fields may contain commas and doubled quotes. Fields do not span lines.
+ *
+ * @param line Line to split
+ *
+ * @return Fields
+ */
+static std::vector<std::string> splitCsv(const std::string &line) {
+
+   std::vector<std::string> fields(1);
+   bool quoted = false;
+   for (unsigned index=0; index<line.size(); index++) {
+      char ch = line[index];
+      if (quoted) {
+         if ((ch == '"') && (index+1<line.size()) && (line[index+1] == '"')) {
+            fields.back() += '"';
+            index++;
+         }
+         else if (ch == '"') {
+            quoted = false;
+         }
+         else {
+            fields.back() += ch;
+         }
+      }
+      else if (ch == '"') {
+         quoted = true;
+      }
+      else if (ch == ',') {
+         fields.emplace_back();
+      }
+      else if ((ch != '\r') && (ch != '\n')) {
+         fields.back() += ch;
+      }
+   }
+   return fields;
+}
+
+/**
+ * Check if a field is a key name i.e. upper-case identifier
+ *
+ * @param field Field to check
+ *
+ * @return true => key name
+ */
+static bool isKeyName(const std::string &field) {
+   if (field.empty() || !isupper(field[0])) {
+      return false;
+   }
+   for (char ch : field) {
+      if (!isupper(ch) && !isdigit(ch) && (ch != '_')) {
+         return false;
+      }
+   }
+   return true;
+}
+
+/**
+ * Convert a number field
+ *
+ * @param field   Field to convert e.g. "0xAA55FF00" or "15"
+ * @param value   Value of field
+ *
+ * @return true => field is a number
+ */
+static bool getNumber(const std::string &field, uint32_t &value) {
+   if (field.empty()) {
+      return false;
+   }
+   char *end;
+   value = strtoul(field.c_str(), &end, 0);
+   return *end == '\0';
+}
+
+/**
+ * Set a fixed address field checking it is the same for every key
+ *
+ * @param device  Device being processed
+ * @param line    Line in CSV file
+ * @param field   Field to set (~0U => not yet set)
+ * @param value   Value for this key
+ */
+static void setFixed(const Device &device, unsigned line, unsigned &field, unsigned value) {
+   if ((field != ~0U) && (field != value)) {
+      error(device, line, "Address differs from earlier keys");
+   }
+   field = value;
+}
+
+/**
+ * Read device keys from CSV file
+ *
+ * @param device Device to read (name, sheet and protocol are set)
+ */
+static void readSheet(Device &device) {
+
+   FILE *fp = fopen(device.sheet.c_str(), "r");
+   if (fp == nullptr) {
+      error(device, 0, "Failed to open");
+   }
+   device.device    = ~0U;
+   device.subDevice = ~0U;
+   device.extension = ~0U;
+
+   char     buffer[1000];
+   unsigned line = 0;
+   while (fgets(buffer, sizeof(buffer), fp) != nullptr) {
+      line++;
+      std::vector<std::string> fields = splitCsv(buffer);
+      fields.resize(std::max<size_t>(fields.size(), 5));
+
+      uint32_t values[3];
+      if (!isKeyName(fields[1]) || !getNumber(fields[2], values[0])) {
+         // Not a key row
+         continue;
+      }
+      Key key{fields[1], 0, 0};
+      switch(device.protocol) {
+         case IrCodeFormat::Protocol_Nec: {
+            // D:8,S:8,F:8,~F:8
+            key.function = values[0]>>16;
+            if (uint8_t(values[0]>>24) != uint8_t(~key.function)) {
+               error(device, line, "~F does not match F");
+            }
+            setFixed(device, line, device.device,    values[0]&0xFF);
+            setFixed(device, line, device.subDevice, (values[0]>>8)&0xFF);
+            setFixed(device, line, device.extension, 0);
+            break;
+         }
+         case IrCodeFormat::Protocol_Samsung: {
+            // Device D:8,S:8 Code E:4,F:8,~F:8
+            if (!getNumber(fields[3], values[1])) {
+               error(device, line, "Code expected in column D");
+            }
+            key.function = values[1]>>4;
+            if (uint8_t(values[1]>>12) != uint8_t(~key.function)) {
+               error(device, line, "~F does not match F");
+            }
+            setFixed(device, line, device.device,    values[0]&0xFF);
+            setFixed(device, line, device.subDevice, (values[0]>>8)&0xFF);
+            setFixed(device, line, device.extension, values[1]&0xF);
+            break;
+         }
+         case IrCodeFormat::Protocol_Panasonic: {
+            // D:8,S:8,F:8,X:8
+            key.function = values[0]>>16;
+            key.data     = values[0]>>24;
+            setFixed(device, line, device.device,    values[0]&0xFF);
+            setFixed(device, line, device.subDevice, (values[0]>>8)&0xFF);
+            setFixed(device, line, device.extension, 0);
+            break;
+         }
+         default: {
+            // Function, Device, Length
+            if (!getNumber(fields[3], values[1]) || !getNumber(fields[4], values[2])) {
+               error(device, line, "Device and length expected in columns D and E");
+            }
+            if ((values[0] > 0x7F) || ((values[2] == 12) && (values[1] > 0x1F)) || (values[1] > 0xFF)) {
+               error(device, line, "Function or device too large");
+            }
+            if ((values[2] != 12) && (values[2] != 15)) {
+               error(device, line, "Length must be 12 or 15");
+            }
+            key.function = values[0]|((values[2] == 15)?IrCodeFormat::SONY15:0);
+            key.data     = values[1];
+            setFixed(device, line, device.device,    0);
+            setFixed(device, line, device.subDevice, 0);
+            setFixed(device, line, device.extension, 0);
+            break;
+         }
+      }
+      for (const Key &other : device.keys) {
+         if (other.name == key.name) {
+            error(device, line, "Duplicate key");
+         }
+      }
+      device.keys.push_back(key);
+   }
+   fclose(fp);
+
+   if (device.keys.empty()) {
+      error(device, 0, "No keys found");
+   }
+   if (device.keys.size() > 255) {
+      error(device, 0, "Too many keys");
+   }
+}
+
+/**
+ * Convert device name to C identifier e.g. "Laser DVD" => laserDvd
+ *
+ * @param name Device name
+ *
+ * @return Identifier
+ */
+static std::string identifier(const std::string &name) {
+   std::string result;
+   bool startWord = false;
+   for (char ch : name) {
+      if (!isalnum(ch)) {
+         startWord = !result.empty();
+         continue;
+      }
+      // Words are capitalised except the first which is lower-case
+      result   += startWord?toupper(ch):tolower(ch);
+      startWord = false;
+   }
+   return result;
+}
+
+/**
+ * Write database header file
+ *
+ * @param fp         File to write
+ * @param devices    Devices
+ * @param keyNames   Key names (sorted)
+ */
+static void writeDatabase(FILE *fp, const std::vector<Device> &devices, const std::vector<std::string> &keyNames) {
+
+   static const char *protocolNames[] = {
+         "Protocol_Nec", "Protocol_Samsung", "Protocol_Panasonic", "Protocol_Sony", "Protocol_Sony20",
+   };
+
+   std::map<std::string, unsigned> keyIndex;
+   for (unsigned index=0; index<keyNames.size(); index++) {
+      keyIndex[keyNames[index]] = index;
+   }
+
+   // Hash index
+   std::vector<std::pair<uint32_t, unsigned>> hashes;
+   for (unsigned index=0; index<keyNames.size(); index++) {
+      hashes.push_back({IrCodeFormat::hashName(keyNames[index].c_str()), index});
+   }
+   std::sort(hashes.begin(), hashes.end());
+   for (unsigned index=1; index<hashes.size(); index++) {
+      if (hashes[index].first == hashes[index-1].first) {
+         fprintf(stderr, "Hash of %s and %s are the same\n",
+               keyNames[hashes[index].second].c_str(), keyNames[hashes[index-1].second].c_str());
+         exit(EXIT_FAILURE);
+      }
+   }
+
+   unsigned keyCount = 0;
+   for (const Device &device : devices) {
+      keyCount += device.keys.size();
+   }
+
+   fprintf(fp,
+         "/**\n"
+         " * @file    ir-code-database.h\n"
+         " * @brief   IR code database\n"
+         " *\n"
+         " * Generated by IrCodeDatabase from \"Data Files/Infrared Controller Codes.ods\" exported as CSV\n"
+         " */\n"
+         "\n"
+         "/*\n"
+         " * *****************************\n"
+         " * *** DO NOT EDIT THIS FILE ***\n"
+         " * *****************************\n"
+         " *\n"
+         " * This file is generated automatically.\n"
+         " * Any manual changes will be lost.\n"
+         " */\n"
+         "#pragma once\n"
+         "\n"
+         "#include \"ir-code-format.h\"\n"
+         "\n"
+         "namespace USBDM {\n"
+         "\n"
+         "/**\n"
+         " * IR code database - %u devices, %u keys, %u key names\n"
+         " */\n"
+         "class IrCodeDatabase : public IrCodeFormat {\n"
+         "\n"
+         "private:\n"
+         "   IrCodeDatabase() = delete;\n"
+         "   IrCodeDatabase(const IrCodeDatabase &) = delete;\n"
+         "\n"
+         "public:\n"
+         "   /**\n"
+         "    * Keys common to all devices (index of key name).\n"
+         "    * A device only provides codes for some keys.\n"
+         "    */\n"
+         "   enum Key : uint8_t {\n",
+         unsigned(devices.size()), keyCount, unsigned(keyNames.size()));
+
+   std::string line = "     ";
+   for (const std::string &name : keyNames) {
+      if (line.size()+name.size()+2 > 100) {
+         fprintf(fp, "%s\n", line.c_str());
+         line = "     ";
+      }
+      line += " "+name+",";
+   }
+   fprintf(fp, "%s\n   };\n\n", line.c_str());
+
+   fprintf(fp,
+         "protected:\n"
+         "   /// Number of keys\n"
+         "   static constexpr unsigned KEY_COUNT = %u;\n"
+         "\n"
+         "   /// Key names indexed by Key\n"
+         "   static constexpr const char *keyNames[KEY_COUNT] = {\n",
+         unsigned(keyNames.size()));
+   line = "     ";
+   for (const std::string &name : keyNames) {
+      if (line.size()+name.size()+4 > 100) {
+         fprintf(fp, "%s\n", line.c_str());
+         line = "     ";
+      }
+      line += " \""+name+"\",";
+   }
+   fprintf(fp,
+         "%s\n"
+         "   };\n"
+         "\n"
+         "   /// Hash of key names (see hashName()) in increasing order\n"
+         "   static constexpr uint32_t keyHashes[KEY_COUNT] = {\n",
+         line.c_str());
+   for (unsigned index=0; index<hashes.size(); index++) {
+      fprintf(fp, "%s0x%08X,%s", ((index%8)==0)?"      ":" ", hashes[index].first, ((index%8)==7)?"\n":"");
+   }
+   fprintf(fp,
+         "%s   };\n"
+         "\n"
+         "   /// Key for each entry in keyHashes[]\n"
+         "   static constexpr Key hashKeys[KEY_COUNT] = {\n",
+         ((hashes.size()%8)!=0)?"\n":"");
+   for (const auto &hash : hashes) {
+      fprintf(fp, "      %s,\n", keyNames[hash.second].c_str());
+   }
+   fprintf(fp, "   };\n");
+
+   for (const Device &device : devices) {
+      std::vector<Key> keys = device.keys;
+      std::sort(keys.begin(), keys.end(), [&](const Key &a, const Key &b) {
+         return keyIndex[a.name] < keyIndex[b.name];
+      });
+      bool sony = (device.protocol == IrCodeFormat::Protocol_Sony);
+      fprintf(fp,
+            "\n"
+            "   /// %s key codes in key order\n"
+            "   static constexpr KeyCode %sKeys[] = {\n"
+            "      //  Key                  F               %s\n",
+            device.name.c_str(), identifier(device.name).c_str(),
+            sony?"D":(device.protocol == IrCodeFormat::Protocol_Panasonic)?"X":"");
+      for (const Key &key : keys) {
+         char function[20];
+         if (sony && (key.function & IrCodeFormat::SONY15)) {
+            snprintf(function, sizeof(function), "SONY15|0x%02X", key.function & ~IrCodeFormat::SONY15);
+         }
+         else {
+            snprintf(function, sizeof(function), "       0x%02X", key.function);
+         }
+         fprintf(fp, "      {   %-20s %s,    0x%02X },\n", (key.name+",").c_str(), function, key.data);
+      }
+      fprintf(fp, "   };\n");
+   }
+
+   fprintf(fp,
+         "\n"
+         "   /// Devices\n"
+         "   static constexpr Device devices[] = {\n"
+         "      //  Name              Protocol            D     S     E     Keys\n");
+   for (const Device &device : devices) {
+      std::string id = identifier(device.name);
+      fprintf(fp, "      {   %-18s %-19s 0x%02X, 0x%02X, 0x%X,  sizeof(%sKeys)/sizeof(%sKeys[0]), %sKeys },\n",
+            ("\""+device.name+"\",").c_str(), (std::string(protocolNames[device.protocol])+",").c_str(),
+            device.device, device.subDevice, device.extension, id.c_str(), id.c_str(), id.c_str());
+   }
+   fprintf(fp,
+         "   };\n"
+         "};\n"
+         "\n"
+         "} // End namespace USBDM\n");
+}
+
+int main(int argc, char *argv[]) {
+
+   if ((argc < 5) || (((argc-2)%3) != 0)) {
+      fprintf(stderr, "Usage: IrCodeDatabase <output.h> { <nec|samsung|panasonic|sony> <device name> <sheet.csv> }\n");
+      return EXIT_FAILURE;
+   }
+
+   static const std::map<std::string, IrCodeFormat::Protocol> protocols = {
+         {"nec",       IrCodeFormat::Protocol_Nec},
+         {"samsung",   IrCodeFormat::Protocol_Samsung},
+         {"panasonic", IrCodeFormat::Protocol_Panasonic},
+         {"sony",      IrCodeFormat::Protocol_Sony},
+   };
+
+   std::vector<Device> devices;
+   std::set<std::string> names;
+   for (int arg=2; arg<argc; arg+=3) {
+      Device device{};
+      device.name  = argv[arg+1];
+      device.sheet = argv[arg+2];
+      auto protocol = protocols.find(argv[arg]);
+      if (protocol == protocols.end()) {
+         error(device, 0, "Unknown protocol");
+      }
+      device.protocol = protocol->second;
+      readSheet(device);
+      for (const Key &key : device.keys) {
+         names.insert(key.name);
+      }
+      devices.push_back(device);
+   }
+   if (names.size() > 256) {
+      fprintf(stderr, "Too many key names\n");
+      return EXIT_FAILURE;
+   }
+   std::vector<std::string> keyNames(names.begin(), names.end());
+
+   FILE *fp = fopen(argv[1], "w");
+   if (fp == nullptr) {
+      fprintf(stderr, "Failed to open %s\n", argv[1]);
+      return EXIT_FAILURE;
+   }
+   writeDatabase(fp, devices, keyNames);
+   fclose(fp);
+
+   for (const Device &device : devices) {
+      printf("%-16s %3u keys\n", device.name.c_str(), unsigned(device.keys.size()));
+   }
+   printf("%u key names\n", unsigned(keyNames.size()));
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,1242 @@
+//============================================================================
+// Name        : IrSimulator.cpp
+// Description : Host simulation of IR transmissions from RemoteControl/Sources/cmt-remote.h
+//
+// Each protocol is transmitted through a simulated CMT that records every
+// modulator cycle (mark, space, extended-space).
+// The waveform is listed in IRP-like notation (+mark -space, us) for comparison
+// with the IRP description in the protocol source.
+// The interpreted (interrupt and DMA) and compile-time rendered transmissions
+// are compared and the call-back cost per emitted edge is measured.
+// Held keys are simulated by releasing the key part way through the transmission.
+// Pre-emption is simulated by replacing a key press part way through the transmission.
+// Payload (byte buffer) transmissions are checked against equivalent data item transmissions.
+// Transmissions are captured by the learning receiver and the timings compared with the waveform.
+// A corpus of captured transmissions with receiver distortion is decoded and the decoder timed.
+// Every key of the device registry is checked against the transmission of the device class
+// and every key name is looked up in the generated code database.
+// Codes converted from Pronto hex are decoded and compared with the codes of the device classes.
+// The CMT handler timing instrumentation is checked against a simulated cycle counter.
+// The LED on-time per frame is measured for each device with the protocol carrier profile.
+// A burst of transmissions rendered as a single transmission is compared with sending each in turn.
+// Device settling times are timed by the microsecond clock and a sequence is planned so steps for
+// other devices are sent while the TV starts up.
+// Each protocol is compared with a golden waveform expanded by hand from its IRP description.
+// The exit status is non-zero if any check fails.
+//============================================================================
+
+#include <stdio.h>
+#include <algorithm>
+#include <cstdlib>
+#include <initializer_list>
+#include <chrono>
+#include <vector>
+
+#define USE_IR_TIMING 1
+
+#include "Sources/cmt-remote.h"
+#include "Sources/ir-learner.h"
+#include "Sources/ir-decoder.h"
+#include "Sources/ir-registry.h"
+#include "Sources/ir-pronto-codes.h"
+#include "Sources/ir-device.h"
+
+using namespace USBDM;
+
+/// Delay used at end of each transmission (us)
+static constexpr unsigned DELAY = 10000;
+
+/// Number of transmissions used for timing
+static constexpr unsigned BENCHMARK_REPEATS = 2000;
+
+/**
+ * Modulator cycle as produced by the CMT
+ */
+struct Cycle {
+   unsigned mark;       ///< Mark period (us)
+   unsigned space;      ///< Space period (us)
+   bool     extended;   ///< Mark period is transmitted as space
+   unsigned segment;    ///< CMT start count when cycle was produced
+
+   bool operator==(const Cycle &other) const {
+      return (mark == other.mark) && (space == other.space) && (extended == other.extended);
+   }
+};
+
+/// Cycles recorded by runCmt()
+static std::vector<Cycle> trace;
+
+/// Carrier frequency of last transmission (Hz)
+static unsigned carrierFrequency;
+
+/// Segment number used for delays timed by the PIT
+static constexpr unsigned DELAY_SEGMENT = ~0U;
+
+/// Simulated CPU clock (cycles/us) - Must agree with SystemCoreClock
+static constexpr unsigned CPU_CYCLES_PER_US = 48;
+
+/// Simulated latency from start of modulator cycle to entry of CMT handler (CPU cycles)
+static constexpr unsigned HANDLER_LATENCY = 12;
+
+/// Simulated time of start of current modulator cycle or delay (CPU cycles)
+static uint32_t cpuTime = 0;
+
+/// Number of checks that failed
+static unsigned failures = 0;
+
+/**
+ * Record the result of a check.
+ *
+ * @param matches Result of check
+ *
+ * @return Description of result
+ */
+static const char *checked(bool matches) {
+   if (!matches) {
+      failures++;
+   }
+   return matches?"matches":"DOES NOT MATCH";
+}
+
+/**
+ * Run the simulated CMT and delay timer until all queued transmissions are complete.
+ * A delay is recorded as a single extended cycle in DELAY_SEGMENT.
+ *
+ * @param record        Record each cycle in trace
+ * @param actionAfter   Number of cycles after which action is executed
+ * @param action        Action e.g. releasing a held key
+ *
+ * @return Number of CMT cycles produced
+ */
+static unsigned runCmt(bool record, unsigned actionAfter=~0U, void (*action)()=nullptr) {
+
+   unsigned cycleCount = 0;
+
+   if (record) {
+      trace.clear();
+      carrierFrequency = 8000000/Cmt::carrierPeriod;
+   }
+   for(;;) {
+      if (Cmt::running) {
+         if (record) {
+            trace.push_back({Cmt::markPeriod, Cmt::spacePeriod, Cmt::extendedSpace, Cmt::startCount});
+         }
+         if ((cycleCount++ == actionAfter) && (action != nullptr)) {
+            action();
+         }
+         // Handler runs in zero time after a fixed latency
+         unsigned period = unsigned(Cmt::markPeriod)+unsigned(Cmt::spacePeriod);
+         DWT->CYCCNT = cpuTime+HANDLER_LATENCY;
+         Cmt::endOfCycle();
+         cpuTime += period*CPU_CYCLES_PER_US;
+         DWT->CYCCNT = cpuTime;
+         continue;
+      }
+      if (IrDelayChannel::callback != nullptr) {
+         if (record) {
+            trace.push_back({0, IrDelayChannel::interval, true, DELAY_SEGMENT});
+         }
+         cpuTime += IrDelayChannel::interval*CPU_CYCLES_PER_US;
+         DWT->CYCCNT = cpuTime;
+         IrDelayChannel::timeout();
+         continue;
+      }
+      break;
+   }
+   return cycleCount;
+}
+
+/**
+ * Count the edges in a set of cycles.
+ * Each cycle with a transmitted mark produces a rising and falling edge.
+ *
+ * @param cycles Cycles to examine
+ *
+ * @return Number of edges
+ */
+static unsigned countEdges(const std::vector<Cycle> &cycles) {
+   unsigned edges = 0;
+   for (const Cycle &cycle : cycles) {
+      if (!cycle.extended && (cycle.mark > 0)) {
+         edges += 2;
+      }
+   }
+   return edges;
+}
+
+/**
+ * List one transmission segment in IRP-like notation.
+ * Adjacent spaces are merged. The final completion cycle is not shown.
+ *
+ * @param title   Title for segment
+ * @param first   Index of first cycle in trace
+ * @param last    Index after last cycle in trace
+ */
+static void listSegment(const char *title, unsigned first, unsigned last) {
+
+   unsigned total = 0;
+   unsigned space = 0;
+   unsigned items = 0;
+
+   printf("   %-6s (%3u cycles) :", title, last-first);
+
+   auto emit = [&](char sign, unsigned value) {
+      if ((items > 0) && ((items%16) == 0)) {
+         printf("\n%24s", "");
+      }
+      printf(" %c%u", sign, value);
+      items++;
+   };
+   auto flushSpace = [&]() {
+      if (space > 0) {
+         emit('-', space);
+         space = 0;
+      }
+   };
+   for (unsigned index=first; index<last-1; index++) {
+      const Cycle &cycle = trace[index];
+      total += cycle.mark+cycle.space;
+      if (cycle.extended) {
+         space += cycle.mark+cycle.space;
+         continue;
+      }
+      flushSpace();
+      emit('+', cycle.mark);
+      space = cycle.space;
+   }
+   flushSpace();
+   printf("\n%24s Total = %u us\n", "", total);
+}
+
+/**
+ * List a trace by transmission segment
+ */
+static void listTrace() {
+   unsigned index = 0;
+   while (index < trace.size()) {
+      unsigned first = index;
+      while ((index < trace.size()) && (trace[index].segment == trace[first].segment)) {
+         index++;
+      }
+      if (trace[first].segment == DELAY_SEGMENT) {
+         printf("   %-6s (PIT)        : -%u\n", "Delay", trace[first].space);
+      }
+      else {
+         listSegment("Tx", first, index);
+      }
+   }
+}
+
+/**
+ * Get the transmitted timings of the trace.
+ * Marks are positive and spaces negative (us). Adjacent spaces are merged.
+ * Delays and the final completion cycle of each transmission are not included.
+ *
+ * @return Timings
+ */
+static std::vector<int> traceTimings() {
+   std::vector<int> timings;
+   unsigned index = 0;
+   while (index < trace.size()) {
+      unsigned first = index;
+      while ((index < trace.size()) && (trace[index].segment == trace[first].segment)) {
+         index++;
+      }
+      if (trace[first].segment == DELAY_SEGMENT) {
+         continue;
+      }
+      for (unsigned item=first; item<index-1; item++) {
+         const Cycle &cycle = trace[item];
+         if (cycle.extended) {
+            timings.back() -= cycle.mark+cycle.space;
+            continue;
+         }
+         timings.push_back(cycle.mark);
+         timings.push_back(-int(cycle.space));
+      }
+   }
+   return timings;
+}
+
+/**
+ * Expected waveform expanded by hand from an IRP description.
+ * This does not use the IRP compiler or protocol sequences of cmt-remote.h.
+ * Marks are positive and spaces negative (us). Adjacent spaces are merged.
+ */
+class Golden {
+
+   std::vector<int> timings;
+
+   const unsigned unit;                  ///< Time unit (us)
+   const int      zero[2], one[2];       ///< Bit encodings in units e.g. <1,-1|1,-3>
+   unsigned       frameTime = 0;         ///< Duration of current frame (us)
+
+public:
+   /**
+    * @param unit  Time unit (us)
+    * @param zero  Mark and space for 0 bit (units)
+    * @param one   Mark and space for 1 bit (units)
+    */
+   Golden(unsigned unit, std::initializer_list<int> zero, std::initializer_list<int> one) :
+      unit(unit), zero{zero.begin()[0], zero.begin()[1]}, one{one.begin()[0], one.begin()[1]} {
+   }
+
+   /// Start a frame i.e. '(' of IRP
+   Golden &frame() {
+      frameTime = 0;
+      return *this;
+   }
+
+   /// Mark or space in units e.g. 16 or -8
+   Golden &units(int duration) {
+      return us(duration*int(unit));
+   }
+
+   /// Mark or space in us e.g. -59000
+   Golden &us(int duration) {
+      if ((duration < 0) && !timings.empty() && (timings.back() < 0)) {
+         timings.back() += duration;
+      }
+      else {
+         timings.push_back(duration);
+      }
+      frameTime += std::abs(duration);
+      return *this;
+   }
+
+   /// Bit-field sent LSB first e.g. D:8
+   Golden &bits(uint32_t value, unsigned length) {
+      for (unsigned bit=0; bit<length; bit++) {
+         const int *encoding = ((value>>bit)&1)?one:zero;
+         units(encoding[0]).units(encoding[1]);
+      }
+      return *this;
+   }
+
+   /// Space completing the frame to a total extent e.g. ^108m
+   Golden &extent(unsigned total) {
+      return us(-int(total-frameTime));
+   }
+
+   const std::vector<int> &get() const {
+      return timings;
+   }
+};
+
+/**
+ * NEC (Laser, Blaupunkt, Teac DVD and Teac PVR)
+ * {38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*
+ *
+ * @param d       Device
+ * @param s       Sub-device
+ * @param f       Function
+ * @param repeats Number of repeat frames
+ */
+static std::vector<int> goldenNec(uint8_t d, uint8_t s, uint8_t f, unsigned repeats) {
+   Golden golden(564, {1,-1}, {1,-3});
+   golden.frame().units(16).units(-8).bits(d,8).bits(s,8).bits(f,8).bits(uint8_t(~f),8).units(1).extent(108000);
+   for (unsigned repeat=0; repeat<repeats; repeat++) {
+      golden.frame().units(16).units(-4).units(1).extent(108000);
+   }
+   return golden.get();
+}
+
+/**
+ * Samsung DVD
+ * {38k,500u}<1,-1|1,-3>(9,-9,D:8,S:8,1,-9,E:4,F:8,~F:8,1,-118)+
+ *
+ * @param d       Device
+ * @param s       Sub-device
+ * @param e       Extension
+ * @param f       Function
+ * @param frames  Number of frames
+ */
+static std::vector<int> goldenSamsung(uint8_t d, uint8_t s, uint8_t e, uint8_t f, unsigned frames) {
+   Golden golden(500, {1,-1}, {1,-3});
+   for (unsigned frame=0; frame<frames; frame++) {
+      golden.frame().units(9).units(-9).bits(d,8).bits(s,8).units(1).units(-9)
+            .bits(e,4).bits(f,8).bits(uint8_t(~f),8).units(1).units(-118);
+   }
+   return golden.get();
+}
+
+/**
+ * Panasonic DVD
+ * {37k,432}<1,-1|1,-3>(8,-4,2:8,32:8,D:8,S:8,F:8,(2^32^D^S^F):8,1,-173)+
+ *
+ * @param d       Device
+ * @param s       Sub-device
+ * @param f       Function
+ * @param frames  Number of frames
+ */
+static std::vector<int> goldenPanasonic(uint8_t d, uint8_t s, uint8_t f, unsigned frames) {
+   Golden golden(432, {1,-1}, {1,-3});
+   for (unsigned frame=0; frame<frames; frame++) {
+      golden.frame().units(8).units(-4).bits(2,8).bits(32,8).bits(d,8).bits(s,8).bits(f,8)
+            .bits(2^32^d^s^f,8).units(1).units(-173);
+   }
+   return golden.get();
+}
+
+/**
+ * Sony TV
+ * Sony-12  {40k,600}<1,-1|2,-1>(4,-1,F:7,D:5,^45m)+
+ * Sony-15  {40k,600}<1,-1|2,-1>(4,-1,F:7,D:8,^45m)+
+ *
+ * @param length  Frame length (12 or 15 bits)
+ * @param d       Device
+ * @param f       Function
+ * @param frames  Number of frames
+ */
+static std::vector<int> goldenSony(unsigned length, uint8_t d, uint8_t f, unsigned frames) {
+   Golden golden(600, {1,-1}, {2,-1});
+   for (unsigned frame=0; frame<frames; frame++) {
+      golden.frame().units(4).units(-1).bits(f,7).bits(d,length-7).extent(45000);
+   }
+   return golden.get();
+}
+
+/**
+ * Simulate transmission of a command using both the interpreter and the compile-time rendered table.
+ * The interpreted transmission is compared with the golden waveform expected from the IRP description.
+ *
+ * @tparam IrClass   Protocol class
+ * @tparam code      Command to send
+ *
+ * @param name       Description of command
+ * @param golden     Expected timings (see traceTimings())
+ */
+template<typename IrClass, typename IrClass::Code code>
+static void simulate(const char *name, const std::vector<int> &golden) {
+
+   using namespace std::chrono;
+
+   // Interpreted transmission
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Interrupt);
+   IrClass::send(code, DELAY);
+   runCmt(true);
+   std::vector<Cycle> interpreted = trace;
+
+   // Rendered transmission
+   IrClass::template send<code>(DELAY);
+   runCmt(true);
+   std::vector<Cycle> rendered = trace;
+
+   // Interpreted transmission rendered a frame at a time for DMA
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Dma);
+   IrClass::send(code, DELAY);
+   runCmt(true);
+   std::vector<Cycle> dma = trace;
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Interrupt);
+
+   trace = interpreted;
+
+   printf("\n%s : %u Hz, %u edges, IRP golden %s, rendered %s, DMA %s\n",
+         name, carrierFrequency, countEdges(interpreted),
+         checked(traceTimings() == golden),
+         checked(rendered == interpreted),
+         checked(dma == interpreted));
+
+   listTrace();
+
+   // Measure call-back cost
+   const unsigned edges = countEdges(interpreted);
+
+   auto benchmark = [&](const char *title, void (*send)()) {
+      unsigned cycles = 0;
+      auto startTime = steady_clock::now();
+      for (unsigned count=0; count<BENCHMARK_REPEATS; count++) {
+         send();
+         cycles += runCmt(false);
+      }
+      double elapsed = duration<double, std::nano>(steady_clock::now()-startTime).count();
+      printf("   %-12s : %6.1f ns/cycle, %6.1f ns/edge\n",
+            title, elapsed/cycles, elapsed/(edges*BENCHMARK_REPEATS));
+   };
+   benchmark("Interpreted", []() { IrClass::send(code, DELAY); });
+   benchmark("Rendered",    []() { IrClass::template send<code>(DELAY); });
+
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Dma);
+   benchmark("DMA",         []() { IrClass::send(code, DELAY); });
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Interrupt);
+}
+
+/**
+ * Simulate a key held for a number of modulator cycles.
+ * The transmission should end within one frame of the release.
+ *
+ * @tparam IrClass   Protocol class
+ * @tparam code      Command to send
+ *
+ * @param name          Description of command
+ * @param releaseAfter  Number of cycles before the key is released
+ */
+template<typename IrClass, typename IrClass::Code code>
+static void simulateHold(const char *name, unsigned releaseAfter) {
+
+   IrClass::hold(code, DELAY);
+   unsigned cycles = runCmt(true, releaseAfter, IrRemote::release);
+
+   printf("\n%s : held for %u cycles, %u cycles sent\n", name, releaseAfter, cycles);
+   listTrace();
+}
+
+/**
+ * Simulate a key press replacing an earlier key press part way through its transmission.
+ * The earlier transmission should end at a frame boundary and its delay is skipped.
+ *
+ * @tparam IrClass   Protocol class
+ * @tparam code      Command to send first
+ * @tparam newCode   Command that replaces it
+ *
+ * @param name          Description of commands
+ * @param replaceAfter  Number of cycles before the new key is pressed
+ */
+template<typename IrClass, typename IrClass::Code code, typename IrClass::Code newCode>
+static void simulateReplace(const char *name, unsigned replaceAfter) {
+
+   IrClass::replace(code, DELAY);
+   unsigned cycles = runCmt(true, replaceAfter, []() { IrClass::replace(newCode, DELAY); });
+
+   printf("\n%s : replaced after %u cycles, %u cycles sent\n", name, replaceAfter, cycles);
+   listTrace();
+}
+
+/**
+ * Long frame with mixed bit order taken from a payload e.g. an air-conditioner state frame
+ */
+class IrLongFrame : public IrRemote {
+
+   /// Protocol description in IRP notation. Payload provides A:8 (MSB first), B:8 (LSB first), C:136 (MSB first)
+   static constexpr char irp[] = "{38k,500,msb}<1,-1|1,-3>(8,-4,A:8,B:-8,C:136,1,-20m)";
+
+   static constexpr auto compiledSequence = compileIrp<irp, IrpFields_Payload>();
+
+public:
+   static void send(const uint8_t payload[], unsigned delay) {
+      runPayload(compiledSequence.sequence, payload, 1, delay);
+   }
+};
+
+/**
+ * Simulate transmissions using payloads
+ */
+static void simulatePayload() {
+
+   // Kaseikyo payload equivalent to Panasonic DVD ON_OFF (0x8D3D20B2)
+   static constexpr IrKaseikyo::Frame panasonicOnOff = IrKaseikyo::makeFrame(0x2002, 0xB2, 0x20, 0x3D, 0x8D);
+
+   IrPanasonicDVD::send(IrPanasonicDVD::ON_OFF, DELAY);
+   runCmt(true);
+   std::vector<Cycle> dataItems = trace;
+
+   IrKaseikyo::send(panasonicOnOff, DELAY);
+   runCmt(true);
+
+   printf("\nKaseikyo payload (Panasonic DVD ON_OFF) : %u edges, %s data item transmission\n",
+         countEdges(trace), checked(trace == dataItems));
+
+   // 152-bit frame. Expect A = 00000001, B = 10000000, C = 1 followed by 135 zeroes
+   static constexpr uint8_t longFrame[19] = {0x01, 0x01, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0x80};
+
+   IrLongFrame::send(longFrame, DELAY);
+   runCmt(true);
+
+   printf("\nLong payload (152 bits, mixed bit order) : %u edges\n", countEdges(trace));
+   listTrace();
+}
+
+/// Timer ticks per microsecond used by IrLearner (48 MHz bus clock / 32)
+static constexpr unsigned LEARN_TICKS_PER_2US = 3;
+
+/// Timer count when the overflow handler executes
+static constexpr uint16_t OVERFLOW_LATENCY = 40;
+
+/// Timings passed to the learning call-back
+static std::vector<uint16_t> learnt;
+
+/**
+ * Get the times of the edges at the IR receiver output for the trace.
+ * The receiver output is active during each mark.
+ *
+ * @param startTime Time of first edge (us)
+ *
+ * @return Edge times (us)
+ */
+static std::vector<unsigned> traceEdges(unsigned startTime) {
+   std::vector<unsigned> edges;
+   unsigned time = startTime;
+   for (const Cycle &cycle : trace) {
+      if (!cycle.extended && (cycle.mark > 0)) {
+         edges.push_back(time);
+         edges.push_back(time+cycle.mark);
+      }
+      time += cycle.mark+cycle.space;
+   }
+   return edges;
+}
+
+/**
+ * Capture the transmission in the trace with the learning receiver.
+ * The receiver output is played into the simulated timer channel with the timer overflowing
+ * as time passes. The learnt timings are left in learnt.
+ *
+ * @param edges      Edge times at receiver output (us)
+ * @param silence    Silence gap ending capture (us)
+ *
+ * @return true => Capture completed
+ */
+static bool learnEdges(const std::vector<unsigned> &edges, unsigned silence) {
+
+   learnt.clear();
+   IrLearner::start([](const uint16_t timings[], unsigned count) { learnt.assign(timings, timings+count); }, Ticks(silence));
+
+   uint64_t nextOverflow = 0x10000;
+   for (unsigned edge : edges) {
+      uint64_t ticks = (uint64_t(edge)*LEARN_TICKS_PER_2US)/2;
+      while ((nextOverflow+OVERFLOW_LATENCY) <= ticks) {
+         Ftm0::overflow(OVERFLOW_LATENCY);
+         nextOverflow += 0x10000;
+      }
+      IrCaptureChannel::capture(uint16_t(ticks));
+   }
+   // Idle until silence is detected
+   for (unsigned count=0; IrLearner::isBusy() && (count<100); count++) {
+      Ftm0::overflow(OVERFLOW_LATENCY);
+   }
+   return !IrLearner::isBusy();
+}
+
+/**
+ * Capture a transmission with the learning receiver.
+ * The learnt timings are compared with the transmitted waveform up to the silence gap.
+ *
+ * @tparam IrClass   Protocol class
+ * @tparam code      Command to send
+ *
+ * @param name       Description of command
+ * @param silence    Silence gap ending capture (us)
+ */
+template<typename IrClass, typename IrClass::Code code>
+static void simulateLearn(const char *name, unsigned silence) {
+
+   IrClass::send(code, DELAY);
+   runCmt(true);
+
+   // Start part way through a timer period
+   std::vector<unsigned> edges = traceEdges(30000);
+
+   std::vector<unsigned> expected;
+   for (unsigned index=1; index<edges.size(); index++) {
+      unsigned interval = edges[index]-edges[index-1];
+      if (interval >= silence) {
+         break;
+      }
+      expected.push_back(interval);
+   }
+
+   bool     matches  = learnEdges(edges, silence) && (learnt.size() == expected.size());
+   unsigned maxError = 0;
+   for (unsigned index=0; matches && (index<expected.size()); index++) {
+      unsigned error = (expected[index]>learnt[index])?expected[index]-learnt[index]:learnt[index]-expected[index];
+      if (error > maxError) {
+         maxError = error;
+      }
+   }
+   matches = matches && (maxError <= 1);
+
+   printf("\n%s : learnt %u timings (%u ms silence), %s, maximum error %u us\n",
+         name, unsigned(learnt.size()), silence/1000, checked(matches), maxError);
+}
+
+/**
+ * Recorded transmission for decoder benchmark
+ */
+struct Recording {
+   IrDecoder::IrProtocol  protocol;   ///< Expected protocol
+   uint32_t               code;       ///< Expected code
+   unsigned               frames;     ///< Expected number of frames
+   std::vector<uint16_t>  timings;    ///< Learnt timings
+};
+
+/// Recordings for decoder benchmark
+static std::vector<Recording> corpus;
+
+/// Seed for receiver distortion
+static uint32_t noiseSeed = 1;
+
+/**
+ * Pseudo-random number for receiver distortion
+ *
+ * @param range Range of result
+ *
+ * @return Value in [0, range)
+ */
+static unsigned noise(unsigned range) {
+   noiseSeed = noiseSeed*1103515245+12345;
+   return (noiseSeed>>16)%range;
+}
+
+/**
+ * Record a transmission in the decoder corpus.
+ * Each recording is repeated with the receiver distorting the edges.
+ * Marks are stretched (as by a typical receiver) and each edge is moved randomly.
+ *
+ * @tparam IrClass   Protocol class
+ * @tparam code      Command to send
+ *
+ * @param protocol   Expected protocol
+ * @param frames     Expected number of frames captured before the silence gap (sent 3 times)
+ */
+template<typename IrClass, typename IrClass::Code code>
+static void record(IrDecoder::IrProtocol protocol, unsigned frames) {
+
+   static constexpr unsigned SILENCE = 60000;
+
+   IrClass::send(code, DELAY);
+   runCmt(true);
+
+   std::vector<unsigned> edges = traceEdges(30000);
+
+   for (unsigned variant=0; variant<8; variant++) {
+      std::vector<unsigned> distorted = edges;
+      unsigned stretch = variant*15;
+      for (unsigned index=0; index<distorted.size(); index++) {
+         // Falling edge (end of mark) is delayed
+         distorted[index] += ((index&1)?stretch:0)+noise(60);
+      }
+      learnEdges(distorted, SILENCE);
+      corpus.push_back({protocol, code, frames, learnt});
+   }
+}
+
+/**
+ * Decode a corpus of recorded transmissions and measure the decoder speed
+ */
+static void simulateDecode() {
+
+   using namespace std::chrono;
+
+   record<IrLaserDVD,     IrLaserDVD::ON_OFF>        (IrDecoder::IrProtocol_Nec,       2);
+   record<IrLaserDVD,     IrLaserDVD::NUM7>          (IrDecoder::IrProtocol_Nec,       2);
+   record<IrBlaupunktDVD, IrBlaupunktDVD::EJECT>     (IrDecoder::IrProtocol_Nec,       2);
+   record<IrTeacPVR,      IrTeacPVR::AUDIO>          (IrDecoder::IrProtocol_Nec,       2);
+   record<IrTeacDVD,      IrTeacDVD::ON_OFF>         (IrDecoder::IrProtocol_Nec,       2);
+   record<IrSamsungDVD,   IrSamsungDVD::ON_OFF>      (IrDecoder::IrProtocol_Samsung,   3);
+   record<IrSamsungDVD,   IrSamsungDVD::A_B>         (IrDecoder::IrProtocol_Samsung,   3);
+   record<IrPanasonicDVD, IrPanasonicDVD::ON_OFF>    (IrDecoder::IrProtocol_Panasonic, 1);
+   record<IrPanasonicDVD, IrPanasonicDVD::NUM5>      (IrDecoder::IrProtocol_Panasonic, 1);
+   record<IrSonyTV,       IrSonyTV::ON_OFF>          (IrDecoder::IrProtocol_Sony12,    3);
+   record<IrSonyTV,       IrSonyTV::APPS>            (IrDecoder::IrProtocol_Sony15,    3);
+   record<IrSonyTV,       IrSonyTV::PLAY>            (IrDecoder::IrProtocol_Sony15,    3);
+
+   unsigned decoded = 0;
+   unsigned timings = 0;
+   for (const Recording &recording : corpus) {
+      IrDecoder::Result result;
+      bool success = IrDecoder::decode(recording.timings.data(), recording.timings.size(), result) &&
+            (result.protocol == recording.protocol) && (result.code == recording.code) && (result.frames == recording.frames);
+      if (success) {
+         decoded++;
+      }
+      else {
+         failures++;
+         printf("   Failed to decode 0x%X (protocol %u, code 0x%X, %u frames)\n",
+               recording.code, result.protocol, result.code, result.frames);
+      }
+      timings += recording.timings.size();
+   }
+   printf("\nDecoder : %u of %u recordings decoded correctly (%u timings)\n",
+         decoded, unsigned(corpus.size()), timings);
+
+   // Measure decoder cost
+   unsigned found = 0;
+   auto startTime = steady_clock::now();
+   for (unsigned count=0; count<BENCHMARK_REPEATS; count++) {
+      for (const Recording &recording : corpus) {
+         IrDecoder::Result result;
+         found += IrDecoder::decode(recording.timings.data(), recording.timings.size(), result);
+      }
+   }
+   double elapsed = duration<double, std::nano>(steady_clock::now()-startTime).count();
+   printf("   %-12s : %6.1f ns/recording, %6.1f ns/timing (%u)\n",
+         "Decode", elapsed/(corpus.size()*BENCHMARK_REPEATS), elapsed/(double(timings)*BENCHMARK_REPEATS), found/BENCHMARK_REPEATS);
+}
+
+/**
+ * Transmit a code using a device class
+ *
+ * @tparam IrClass   Device class
+ *
+ * @param code       Command to send
+ */
+template<typename IrClass>
+static void sendUsingClass(uint32_t code) {
+   IrClass::send(typename IrClass::Code(code), DELAY);
+}
+
+// Registry codes are the same as the device class codes
+static_assert(IrRegistry::getCode(IrRegistry::getDevice(0), IrRegistry::ON_OFF) == IrLaserDVD::ON_OFF);
+static_assert(IrRegistry::getCode(IrRegistry::getDevice(2), IrRegistry::NUM7)   == IrTeacPVR::NUM7);
+static_assert(IrRegistry::getCode(IrRegistry::getDevice(4), IrRegistry::A_B)    == IrSamsungDVD::A_B);
+static_assert(IrRegistry::getCode(IrRegistry::getDevice(5), IrRegistry::NUM5)   == IrPanasonicDVD::NUM5);
+static_assert(IrRegistry::getCode(IrRegistry::getDevice(6), IrRegistry::APPS)   == IrSonyTV::APPS);
+static_assert(IrRegistry::getCode(IrRegistry::getDevice(6), IrRegistry::ZOOM)   == IrRegistry::NO_CODE);
+
+/**
+ * Send every key in the device registry and compare the transmission with that of the device class
+ */
+static void simulateRegistry() {
+
+   // Device class for each registry entry
+   static constexpr void (*sendFunctions[])(uint32_t code) = {
+         sendUsingClass<IrLaserDVD>,
+         sendUsingClass<IrBlaupunktDVD>,
+         sendUsingClass<IrTeacPVR>,
+         sendUsingClass<IrTeacDVD>,
+         sendUsingClass<IrSamsungDVD>,
+         sendUsingClass<IrPanasonicDVD>,
+         sendUsingClass<IrSonyTV>,
+   };
+   static_assert(sizeof(sendFunctions)/sizeof(sendFunctions[0]) == IrRegistry::getDeviceCount());
+
+   unsigned keys    = 0;
+   unsigned matches = 0;
+   for (unsigned index=0; index<IrRegistry::getDeviceCount(); index++) {
+      const IrRegistry::Device &device = IrRegistry::getDevice(index);
+      for (unsigned keyIndex=0; keyIndex<device.keyCount; keyIndex++) {
+         const IrRegistry::KeyCode &keyCode = device.keys[keyIndex];
+
+         sendFunctions[index](IrRegistry::makeCode(device, keyCode));
+         runCmt(true);
+         std::vector<Cycle> classTrace = trace;
+
+         IrRegistry::send(*IrRegistry::findDevice(device.name), IrRegistry::Key(keyCode.key), DELAY);
+         runCmt(true);
+
+         keys++;
+         if (trace == classTrace) {
+            matches++;
+         }
+         else {
+            failures++;
+            printf("   %s key %u DOES NOT MATCH\n", device.name, keyCode.key);
+         }
+      }
+   }
+   bool missingKey = IrRegistry::send(IrRegistry::getDevice(0), IrRegistry::APPS, DELAY) == E_ILLEGAL_PARAM;
+   if (!missingKey) {
+      failures++;
+   }
+
+   printf("\nRegistry : %u devices, %u keys (%u bytes of key codes), %u of %u transmissions match device class, %s\n",
+         IrRegistry::getDeviceCount(), keys, unsigned(keys*sizeof(IrRegistry::KeyCode)), matches, keys,
+         missingKey?"missing key rejected":"MISSING KEY NOT REJECTED");
+
+   // Look up every key by name
+   unsigned names = 0;
+   unsigned found = 0;
+   for (unsigned index=0; index<=IrRegistry::ZOOM; index++) {
+      IrRegistry::Key key;
+      names++;
+      if (IrRegistry::findKey(IrRegistry::getKeyName(IrRegistry::Key(index)), key) && (key == index)) {
+         found++;
+      }
+   }
+   IrRegistry::Key key;
+   bool missingName = !IrRegistry::findKey("ON_OF", key) && !IrRegistry::findKey("", key);
+   if ((found != names) || !missingName) {
+      failures++;
+   }
+
+   printf("   %u of %u key names found, %s\n", found, names, missingName?"unknown names rejected":"UNKNOWN NAME FOUND");
+}
+
+/**
+ * Simulate transmission of a code converted from Pronto hex.
+ * The transmission is decoded and compared with the code of the device class.
+ *
+ * @param name       Description of code
+ * @param code       Code to send
+ * @param repeat     Number of times to send repeat sequence
+ * @param protocol   Expected protocol (IrProtocol_None => not expected to decode)
+ * @param expected   Expected code
+ * @param frames     Expected number of frames
+ */
+static void simulatePronto(
+      const char                 *name,
+      const IrPronto::ProntoCode &code,
+      unsigned                    repeat,
+      IrDecoder::IrProtocol       protocol,
+      uint32_t                    expected,
+      unsigned                    frames) {
+
+   // Pre-rendered cycles transmitted by interrupt and DMA
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Dma);
+   IrPronto::send(code, repeat, DELAY);
+   runCmt(true);
+   std::vector<Cycle> dma = trace;
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Interrupt);
+   IrPronto::send(code, repeat, DELAY);
+   runCmt(true);
+
+   // Decode transmission
+   std::vector<unsigned> edges = traceEdges(0);
+   std::vector<uint16_t> timings;
+   for (unsigned index=1; index<edges.size(); index++) {
+      timings.push_back(uint16_t(std::min(edges[index]-edges[index-1], 0xFFFFU)));
+   }
+   IrDecoder::Result result;
+   bool decoded = IrDecoder::decode(timings.data(), timings.size(), result);
+   bool success = (protocol == IrDecoder::IrProtocol_None)?!decoded:
+         (decoded && (result.protocol == protocol) && (result.code == expected) && (result.frames == frames));
+   if (!success) {
+      failures++;
+   }
+
+   printf("\n%s : %u Hz, %u edges, DMA %s, decoded (protocol %u, code 0x%X, %u frames) %s\n",
+         name, carrierFrequency, countEdges(trace),
+         checked(dma == trace),
+         result.protocol, result.code, result.frames, success?"as expected":"NOT AS EXPECTED");
+   listTrace();
+}
+
+/**
+ * Measure the time the IR LED is driven for the last transmission recorded by runCmt().
+ * The carrier duty cycle is that configured in the simulated CMT.
+ *
+ * @return LED on-time (us)
+ */
+static uint32_t measureLedOnTime() {
+   uint64_t markTime = 0;
+   for (const Cycle &cycle : trace) {
+      if ((cycle.segment != DELAY_SEGMENT) && !cycle.extended) {
+         markTime += cycle.mark;
+      }
+   }
+   return uint32_t((markTime*Cmt::carrierHighTime)/Cmt::carrierPeriod);
+}
+
+/**
+ * Report the time the IR LED is driven for a single frame of the first key of each registry device.
+ * Each key is sent with the carrier profile of the protocol.
+ * The on-time measured from the simulated CMT is compared with the estimate.
+ */
+static void simulateLedOnTime() {
+
+   printf("\nLED on-time per frame\n");
+
+   for (unsigned index=0; index<IrRegistry::getDeviceCount(); index++) {
+      const IrRegistry::Device &device = IrRegistry::getDevice(index);
+      const IrRegistry::Key     key    = IrRegistry::Key(device.keys[0].key);
+
+      IrRegistry::send(device, key, DELAY, 1);
+      runCmt(true);
+      unsigned duty      = (100*Cmt::carrierHighTime+Cmt::carrierPeriod/2)/Cmt::carrierPeriod;
+      bool     highDrive = (Cmt::driveStrength == PinDriveStrength_High);
+      uint32_t onTime    = measureLedOnTime();
+      bool     matches   = (onTime == IrRegistry::estimateLedOnTime(device, key));
+
+      printf("   %-16s : %2u%% duty %s drive %6u us, estimate %s\n",
+            device.name, duty, highDrive?"high":"low ", onTime, checked(matches));
+   }
+}
+
+/// Sony TV start-up page dismissed and HDMI 2 selected as a single burst
+static constexpr auto sonyTvBurst = IrRemote::renderBurst<
+      IrRemote::BurstStep<IrSonyTV::rendered<IrSonyTV::HOME>,          100>,
+      IrRemote::BurstStep<IrSonyTV::rendered<IrSonyTV::RETURN>,        100>,
+      IrRemote::BurstStep<IrSonyTV::rendered<IrSonyTV::SOURCE_HDMI_2>, DELAY>>();
+
+/**
+ * Compare a burst rendered as a single transmission with sending each step in turn.
+ * The edges at the receiver should be identical while the CMT is only started once.
+ */
+static void simulateBurst() {
+
+   auto sendSteps = []() {
+      IrSonyTV::send<IrSonyTV::HOME>(100);
+      IrSonyTV::send<IrSonyTV::RETURN>(100);
+      IrSonyTV::send<IrSonyTV::SOURCE_HDMI_2>(DELAY);
+   };
+   for (IrRemote::IrTransmitMode mode : {IrRemote::IrTransmitMode_Interrupt, IrRemote::IrTransmitMode_Dma}) {
+      IrRemote::setTransmitMode(mode);
+
+      unsigned startCount = Cmt::startCount;
+      sendSteps();
+      runCmt(true);
+      unsigned stepStarts = Cmt::startCount-startCount;
+      std::vector<unsigned> stepEdges = traceEdges(0);
+
+      startCount = Cmt::startCount;
+      IrRemote::sendBurst(sonyTvBurst);
+      runCmt(true);
+      unsigned burstStarts = Cmt::startCount-startCount;
+      std::vector<unsigned> burstEdges = traceEdges(0);
+
+      if ((burstEdges != stepEdges) || (burstStarts != 1)) {
+         failures++;
+      }
+      printf("\nSony TV HOME, RETURN, SOURCE_HDMI_2 burst (%s) : %u cycles (%u bytes), %u edges %s, CMT started %u times (steps %u times)\n",
+            (mode == IrRemote::IrTransmitMode_Dma)?"DMA":"interrupt",
+            unsigned(sizeof(sonyTvBurst.cycles)/sizeof(sonyTvBurst.cycles[0])), unsigned(sizeof(sonyTvBurst.cycles)),
+            unsigned(burstEdges.size()), (burstEdges == stepEdges)?"match steps":"DO NOT MATCH STEPS",
+            burstStarts, stepStarts);
+   }
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Interrupt);
+}
+
+/// Period of the simulated button polling timer (us)
+static constexpr unsigned CLOCK_PERIOD = 10000;
+
+/// Time elapsed in current period of the simulated button polling timer (us)
+static unsigned clockElapsed = 0;
+
+/**
+ * Advance the time of the simulated button polling timer used by IrClock
+ *
+ * @param time Time to advance (us)
+ */
+static void advanceClock(unsigned time) {
+   while (time > 0) {
+      unsigned step = std::min(time, CLOCK_PERIOD-clockElapsed);
+      clockElapsed += step;
+      time         -= step;
+      if (clockElapsed == CLOCK_PERIOD) {
+         clockElapsed = 0;
+         IrClock::tick(CLOCK_PERIOD);
+      }
+      ButtonTimerChannel::counter = (CLOCK_PERIOD-clockElapsed)*(SystemCoreClock/1000000)-1;
+   }
+}
+
+/**
+ * Step of a simulated sequence (see IrDevice::isRunnable())
+ */
+struct PlanStep {
+   const char *name;     ///< Name of step
+   IrDevice   *device;   ///< Device the step sends to (nullptr => no transmission e.g. page change)
+   unsigned    settle;   ///< Settling time of device after the transmission (us)
+
+   IrDevice *getDevice() const {
+      return device;
+   }
+   bool usesDevice(const IrDevice *other) const {
+      return device == other;
+   }
+};
+
+/**
+ * Check the settling time of a device is timed with microsecond resolution
+ * i.e. finer than the period of the button polling timer.
+ */
+static void simulateSettling() {
+
+   static constexpr unsigned SETTLE = 300;
+
+   IrDevice device;
+
+   // Start part way through a timer period
+   advanceClock(CLOCK_PERIOD+CLOCK_PERIOD/2+7);
+   device.transmit(SETTLE);
+   bool pendingReady = device.isReady();
+   device.transmitted();
+   uint64_t start = IrClock::now();
+   advanceClock(SETTLE-1);
+   bool earlyReady = device.isReady();
+   advanceClock(1);
+   bool ready = device.isReady();
+   uint64_t settled = IrClock::now()-start;
+
+   printf("\nDevice settling %u us : ready while pending %s, after %u us %s, after %u us %s - %s\n",
+         SETTLE, pendingReady?"yes":"no", SETTLE-1, earlyReady?"yes":"no", unsigned(settled), ready?"yes":"no",
+         checked(!pendingReady && !earlyReady && ready && (settled == SETTLE)));
+}
+
+/**
+ * Plan a sequence as for the Watch PVR sequence and check the steps for other devices are
+ * sent while the TV starts up.
+ *
+ * The scheduler is polled every 10 ms as for the main loop. A transmission occupies the shared
+ * IR queue for TRANSMISSION and the device then settles for the time of the step.
+ */
+static void simulatePlanner() {
+
+   static constexpr unsigned POLL         = 10000;
+   static constexpr unsigned TRANSMISSION = 70000;
+   static constexpr unsigned START_UP     = 5000000;
+
+   IrDevice tv, pvr, laserDvd, samsungDvd;
+
+   const PlanStep steps[] = {
+         {"TV On",              &tv,         START_UP},
+         {"TV Source HDMI 2",   &tv,         100},
+         {"PVR On",             &pvr,        100},
+         {"Laser DVD Off",      &laserDvd,   100},
+         {"PVR page",           nullptr,     0},
+         {"Samsung DVD Off",    &samsungDvd, 100},
+   };
+   static constexpr unsigned stepCount = sizeof(steps)/sizeof(steps[0]);
+   const PlanStep *plan[stepCount];
+   for (unsigned index=0; index<stepCount; index++) {
+      plan[index] = &steps[index];
+   }
+
+   // Serial time - each step waits for the previous transmission and settling time
+   unsigned serialTime = 0;
+   for (const PlanStep &step : steps) {
+      if (step.device != nullptr) {
+         serialTime += TRANSMISSION+step.settle;
+      }
+   }
+
+   uint64_t  startTime = IrClock::now();
+   uint64_t  sentAt[stepCount];
+   unsigned  order[stepCount];
+   unsigned  executed  = 0;
+   unsigned  sent      = 0;
+   IrDevice *sending   = nullptr;
+   uint64_t  sendEnd   = 0;
+
+   while ((sent < stepCount) || (sending != nullptr)) {
+      uint64_t now = IrClock::now();
+      if ((sending != nullptr) && (now >= sendEnd)) {
+         sending->transmitted();
+         sending = nullptr;
+      }
+      for (unsigned index=0; (sending == nullptr) && (index<stepCount); index++) {
+         if ((executed & (1U<<index)) || !IrDevice::isRunnable(plan, executed, index)) {
+            continue;
+         }
+         executed        |= 1U<<index;
+         sentAt[index]    = now-startTime;
+         order[sent++]    = index;
+         if (steps[index].device != nullptr) {
+            sending = steps[index].device;
+            sending->transmit(steps[index].settle);
+            sendEnd = now+TRANSMISSION;
+         }
+      }
+      advanceClock(POLL);
+   }
+   unsigned planTime = unsigned(IrClock::now()-startTime);
+
+   printf("\nPlanned Watch PVR sequence (TV start-up %u ms)\n", START_UP/1000);
+   for (unsigned index=0; index<stepCount; index++) {
+      printf("  %-18s at %5u ms\n", steps[order[index]].name, unsigned(sentAt[order[index]]/1000));
+   }
+   // Steps 2, 3 and 5 are sent during the TV start-up. Step 1 waits for it.
+   bool overlapped = (sentAt[2] < START_UP) && (sentAt[3] < START_UP) && (sentAt[5] < START_UP);
+   bool waited     = sentAt[1] >= (sentAt[0]+TRANSMISSION+START_UP);
+   printf("Other devices during TV start-up %s, TV source after start-up %s, %u ms planned, %u ms in order - %s\n",
+         overlapped?"yes":"no", waited?"yes":"no", planTime/1000, serialTime/1000,
+         checked(overlapped && waited && (planTime < serialTime)));
+}
+
+/**
+ * Check the CMT handler timing instrumentation.
+ * The handler is entered a fixed latency after the start of each modulator cycle so the latency
+ * should not drift and the slack should be the period of each cycle less the latency.
+ * An interpreted and a rendered transmission are checked.
+ *
+ * @tparam IrClass   Protocol class
+ * @tparam code      Command to send
+ *
+ * @param name       Description of command
+ */
+template<typename IrClass, typename IrClass::Code code>
+static void simulateTiming(const char *name) {
+
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Interrupt);
+   IrTiming::clear();
+   IrClass::send(code, DELAY);
+   IrClass::template send<code>(DELAY);
+   runCmt(true);
+
+   // Each cycle is programmed by the handler for the preceding cycle of the same transmission
+   unsigned cycles = 0, programmed = 0;
+   uint32_t minSlack = -1U, maxSlack = 0;
+   for (unsigned index=0; index<trace.size(); index++) {
+      if (trace[index].segment == DELAY_SEGMENT) {
+         continue;
+      }
+      cycles++;
+      if ((index+1 < trace.size()) && (trace[index+1].segment == trace[index].segment)) {
+         uint32_t slack = (trace[index].mark+trace[index].space)*CPU_CYCLES_PER_US-HANDLER_LATENCY;
+         programmed++;
+         minSlack = std::min(minSlack, slack);
+         maxSlack = std::max(maxSlack, slack);
+      }
+   }
+   const IrTiming::Histogram &latency = IrTiming::getPredictedLatency();
+   const IrTiming::Histogram &slack   = IrTiming::getSlack();
+
+   bool matches =
+         (latency.count == cycles) && (latency.minimum == HANDLER_LATENCY) && (latency.maximum == HANDLER_LATENCY) &&
+         (slack.count == programmed) && (slack.minimum == minSlack) && (slack.maximum == maxSlack) &&
+         (IrTiming::getLateCount() == 0);
+
+   printf("\n%s : handler timing %s\n", name, checked(matches));
+   printf("   Predicted latency : n=%u, min=%u, max=%u cycles\n", latency.count, latency.minimum, latency.maximum);
+   printf("   Slack             : n=%u, min=%u, max=%u cycles\n", slack.count, slack.minimum, slack.maximum);
+   printf("   Late              : n=%u\n", IrTiming::getLateCount());
+}
+
+int main() {
+
+   IrTiming::initialise();
+
+   // Golden fields are decoded by hand from the code constants e.g. Sony12(1,21) (3 repeats)
+   simulate<IrLaserDVD,     IrLaserDVD::ON_OFF>    ("Laser DVD ON_OFF",          goldenNec(0x00, 0xFF, 0x0C, 3));
+   simulate<IrBlaupunktDVD, IrBlaupunktDVD::ON_OFF>("Blaupunkt DVD ON_OFF",      goldenNec(0x00, 0xFF, 0x00, 3));
+   simulate<IrTeacPVR,      IrTeacPVR::ON_OFF>     ("Teac PVR ON_OFF",           goldenNec(0x00, 0xBF, 0x59, 3));
+   simulate<IrTeacDVD,      IrTeacDVD::ON_OFF>     ("Teac DVD ON_OFF",           goldenNec(0x00, 0xFF, 0x04, 3));
+   simulate<IrSamsungDVD,   IrSamsungDVD::ON_OFF>  ("Samsung DVD ON_OFF",        goldenSamsung(0x20, 0x00, 0x7, 0x00, 3));
+   simulate<IrPanasonicDVD, IrPanasonicDVD::ON_OFF>("Panasonic DVD ON_OFF",      goldenPanasonic(0xB2, 0x20, 0x3D, 3));
+   simulate<IrSonyTV,       IrSonyTV::ON_OFF>      ("Sony TV ON_OFF (Sony12)",   goldenSony(12, 1, 21, 3));
+   simulate<IrSonyTV,       IrSonyTV::APPS>        ("Sony TV APPS (Sony15)",     goldenSony(15, 26, 125, 3));
+
+   simulateHold<IrLaserDVD, IrLaserDVD::VOLUME_UP>     ("Laser DVD VOLUME_UP (held)", 60);
+   simulateHold<IrSonyTV,   IrSonyTV::VOLUME_UP>       ("Sony TV VOLUME_UP (held)",   100);
+
+   simulateReplace<IrLaserDVD, IrLaserDVD::UP, IrLaserDVD::DOWN>("Laser DVD UP -> DOWN",     20);
+   simulateReplace<IrSonyTV,   IrSonyTV::UP,   IrSonyTV::DOWN>  ("Sony TV UP -> DOWN",       20);
+
+   simulatePayload();
+
+   simulateLearn<IrLaserDVD,     IrLaserDVD::ON_OFF>    ("Learn Laser DVD ON_OFF",     20000);
+   simulateLearn<IrLaserDVD,     IrLaserDVD::ON_OFF>    ("Learn Laser DVD ON_OFF",     60000);
+   simulateLearn<IrPanasonicDVD, IrPanasonicDVD::ON_OFF>("Learn Panasonic DVD ON_OFF", 20000);
+   simulateLearn<IrSonyTV,       IrSonyTV::ON_OFF>      ("Learn Sony TV ON_OFF",       60000);
+
+   simulateDecode();
+
+   simulateRegistry();
+
+   simulatePronto("Pronto Laser DVD ON_OFF", IrProntoCodes::LaserDvd_ON_OFF,   2,
+         IrDecoder::IrProtocol_Nec,    IrLaserDVD::ON_OFF,    3);
+   simulatePronto("Pronto Laser DVD VOLUME_UP", IrProntoCodes::LaserDvd_VOLUME_UP, 0,
+         IrDecoder::IrProtocol_Nec,    IrLaserDVD::VOLUME_UP, 1);
+   simulatePronto("Pronto Sony TV ON_OFF", IrProntoCodes::SonyTv_ON_OFF,       3,
+         IrDecoder::IrProtocol_Sony12, IrSonyTV::ON_OFF,      3);
+   simulatePronto("Pronto Philips TV STANDBY (RC5)", IrProntoCodes::PhilipsTv_STANDBY, 2,
+         IrDecoder::IrProtocol_None,   0,                     0);
+
+   simulateLedOnTime();
+
+   simulateBurst();
+
+   simulateSettling();
+   simulatePlanner();
+
+   simulateTiming<IrLaserDVD, IrLaserDVD::ON_OFF>("Laser DVD ON_OFF");
+   simulateTiming<IrSonyTV,   IrSonyTV::VOLUME_UP>("Sony TV VOLUME_UP");
+
+   // DMA with frames rendered as transmission proceeds
+   IrRemote::setTransmitMode(IrRemote::IrTransmitMode_Dma);
+   simulateHold<IrSonyTV,   IrSonyTV::VOLUME_UP>       ("Sony TV VOLUME_UP (held, DMA)", 100);
+   simulateReplace<IrSonyTV,   IrSonyTV::UP,   IrSonyTV::DOWN>  ("Sony TV UP -> DOWN (DMA)", 20);
+
+   printf("\n%u checks failed\n", failures);
+   return (failures == 0)?0:1;
+}
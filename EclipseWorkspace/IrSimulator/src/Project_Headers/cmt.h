@@ -0,0 +1,179 @@
+/**
+ * @file     cmt.h (IrSimulator/src/Project_Headers/cmt.h)
+ * @brief    Simulated Carrier Modulator Transmitter
+ *
+ * Host replacement for the USBDM CMT interface.
+ * The modulator registers are recorded rather than driving hardware.
+ * The simulator steps the modulator by calling Cmt::endOfCycle().
+ * DMA requests at end-of-cycle are passed to the simulated DMA controller.
+ */
+#pragma once
+
+#include "../Sources/hardware.h"
+#include "dma.h"
+
+#define CMT_MSC_MCGEN_MASK   (0x01U)
+#define CMT_MSC_EOCIE_MASK   (0x02U)
+#define CMT_MSC_EXSPC_MASK   (0x10U)
+
+namespace USBDM {
+
+enum CmtEnable                : uint8_t { CmtEnable_Disabled = 0, CmtEnable_Enabled = CMT_MSC_MCGEN_MASK, };
+enum CmtMode                  : uint8_t { CmtMode_Time = 0, CmtMode_Baseband = 0x04, };
+enum CmtClockPrescaler        : uint8_t { CmtClockPrescaler_Auto = 0, };
+enum CmtIntermediatePrescaler : uint8_t { CmtIntermediatePrescaler_DivBy1 = 0, };
+enum CmtOutput                : uint8_t { CmtOutput_Disabled = 0, CmtOutput_ActiveHigh = 0x60, };
+enum CmtExtendedSpace         : uint8_t { CmtExtendedSpace_Disabled = 0, CmtExtendedSpace_Enabled = CMT_MSC_EXSPC_MASK, };
+enum CmtStatus                : uint8_t { CmtStatus_Clear = 0, CmtStatus_Set = 1, };
+
+enum CmtEndOfCycleAction : uint8_t {
+   CmtEndOfCycleAction_None        = 0,
+   CmtEndOfCycleAction_Interrupt   = CMT_MSC_EOCIE_MASK,
+   CmtEndOfCycleAction_DmaTransfer = CMT_MSC_EOCIE_MASK|1,
+};
+
+struct CmtPrimaryCarrierHighTime {
+   unsigned value;
+   constexpr CmtPrimaryCarrierHighTime(unsigned value) : value(value) {}
+};
+
+struct CmtPrimaryCarrierLowTime {
+   unsigned value;
+   constexpr CmtPrimaryCarrierLowTime(unsigned value) : value(value) {}
+};
+
+/**
+ * CMT register layout
+ */
+struct CMT_Type {
+   uint8_t CGH1, CGL1, CGH2, CGL2, OC, MSC, CMD1, CMD2, CMD3, CMD4, PPS, DMA;
+};
+
+/**
+ * Simulated CMT
+ */
+class Cmt {
+
+public:
+   /**
+    * Configuration values for CMT (only those used by the simulator are retained)
+    */
+   struct Init {
+      CallbackFunction           callback;
+      CmtPrimaryCarrierHighTime  carrierHighTime;
+      CmtPrimaryCarrierLowTime   carrierLowTime;
+
+      constexpr Init(
+            NvicPriority, CallbackFunction callback,
+            CmtEnable, CmtMode, CmtClockPrescaler, CmtIntermediatePrescaler, CmtOutput, CmtEndOfCycleAction,
+            CmtPrimaryCarrierHighTime carrierHighTime, CmtPrimaryCarrierLowTime carrierLowTime) :
+         callback(callback), carrierHighTime(carrierHighTime), carrierLowTime(carrierLowTime) {
+      }
+   };
+
+   /// Simulated CMT register address (DMA is not simulated)
+   static constexpr uint32_t baseAddress = 0x40062000;
+
+   /// Call-back for end-of-cycle interrupt
+   static inline CallbackFunction callback = nullptr;
+
+   /// Carrier period in 8MHz CMT clocks
+   static inline unsigned carrierPeriod = 0;
+
+   /// Carrier high time in 8MHz CMT clocks
+   static inline unsigned carrierHighTime = 0;
+
+   /// Drive strength of output pin
+   static inline PinDriveStrength driveStrength = PinDriveStrength_Low;
+
+   /// Mark period for next cycle
+   static inline Ticks markPeriod = Ticks(0);
+
+   /// Space period for next cycle
+   static inline Ticks spacePeriod = Ticks(0);
+
+   /// Mark period is transmitted as space for next cycle
+   static inline bool extendedSpace = false;
+
+   /// Modulator is running
+   static inline bool running = false;
+
+   /// Number of times the modulator has been started from idle
+   static inline unsigned startCount = 0;
+
+   /// Action at end of each cycle
+   static inline CmtEndOfCycleAction endOfCycleAction = CmtEndOfCycleAction_Interrupt;
+
+   /// Register image written by DMA
+   static inline CMT_Type registers = {};
+
+   static void configure(const Init &init) {
+      callback         = init.callback;
+      endOfCycleAction = CmtEndOfCycleAction_Interrupt;
+      carrierPeriod    = init.carrierHighTime.value+init.carrierLowTime.value;
+      carrierHighTime  = init.carrierHighTime.value;
+   }
+
+   static void setOutput(PcrValue pcrValue) {
+      driveStrength = PinDriveStrength(pcrValue);
+   }
+
+   static void setPrimaryTiming(Ticks highTime, Ticks lowTime) {
+      carrierPeriod   = highTime+lowTime;
+      carrierHighTime = highTime;
+   }
+
+   static void disable() {
+      running = false;
+   }
+
+   static CmtStatus getEndOfCycleFlag() {
+      return CmtStatus_Set;
+   }
+
+   static void clearEndOfCycleFlag() {
+   }
+
+   static void setMarkSpacePeriods(Ticks mark, Ticks space) {
+      markPeriod  = mark;
+      spacePeriod = space;
+   }
+
+   static void setExtendedSpace(CmtExtendedSpace cmtExtendedSpace) {
+      extendedSpace = (cmtExtendedSpace == CmtExtendedSpace_Enabled);
+   }
+
+   static void setEndOfCycleAction(CmtEndOfCycleAction action) {
+      endOfCycleAction = action;
+   }
+
+   static void start() {
+      if (!running) {
+         startCount++;
+      }
+      running = true;
+   }
+
+   static void stop() {
+      running = false;
+   }
+
+   /**
+    * Simulate the end of the current modulator cycle.
+    * The registers are latched for the following cycle and either a DMA transfer
+    * loads the next cycle or the end-of-cycle call-back is executed.
+    */
+   static void endOfCycle() {
+      if ((endOfCycleAction == CmtEndOfCycleAction_DmaTransfer) && Dma0::transfer(Dma0Slot_CMT, nullptr, &registers.MSC)) {
+         markPeriod    = Ticks((registers.CMD1<<8)|registers.CMD2);
+         spacePeriod   = Ticks((registers.CMD3<<8)|registers.CMD4);
+         extendedSpace = (registers.MSC&CMT_MSC_EXSPC_MASK) != 0;
+         return;
+      }
+      if (callback != nullptr) {
+         callback();
+      }
+   }
+};
+
+} // End namespace USBDM
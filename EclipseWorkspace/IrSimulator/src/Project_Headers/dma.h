@@ -0,0 +1,202 @@
+/**
+ * @file     dma.h (IrSimulator/src/Project_Headers/dma.h)
+ * @brief    Direct Memory Access (DMA) placeholder
+ *
+ * Host replacement for the USBDM DMA interface.
+ * Only hardware requested transfers as used by IrRemote and IrLearner are simulated.
+ * A simulated peripheral requests one minor loop by calling Dma0::transfer() with its DMAMUX slot.
+ */
+#pragma once
+
+#include "../Sources/hardware.h"
+
+namespace USBDM {
+
+enum DmaChannelNum : uint8_t {
+   DmaChannelNum_0    = 0,
+   DmaChannelNum_1    = 1,
+   DmaChannelNum_None = 0x80,
+};
+
+enum DmaSize                  { DmaSize_8bit, DmaSize_16bit, DmaSize_32bit, };
+enum DmaMinorLoopMapping      { DmaMinorLoopMapping_Disabled = 0, DmaMinorLoopMapping_Enabled = 0x80, };
+enum DmaMinorLoopOffsetSelect { DmaMinorLoopOffsetSelect_None, DmaMinorLoopOffsetSelect_Destination, };
+enum DmaStopOnComplete        { DmaStopOnComplete_Disabled, DmaStopOnComplete_Enabled, };
+enum DmaIntMajor              { DmaIntMajor_Disabled, DmaIntMajor_Enabled, };
+enum DmamuxMode               { DmamuxMode_Disabled, DmamuxMode_Continuous, };
+enum DmaSlot                  { Dma0Slot_None = 0, Dma0Slot_FTM0_Ch1 = 25, Dma0Slot_CMT = 47, };
+
+typedef void (*DmaCallbackFunction)(DmaChannelNum channel);
+
+struct DmaInfo {
+   uint32_t address;
+   int32_t  lastAdjustment;
+   constexpr DmaInfo(uint32_t address, int32_t, DmaSize, int32_t lastAdjustment=0) :
+      address(address), lastAdjustment(lastAdjustment) {}
+};
+
+struct DmaTcdCsr {
+   DmaStopOnComplete stopOnComplete;
+   constexpr DmaTcdCsr(DmaStopOnComplete stopOnComplete=DmaStopOnComplete_Enabled, DmaIntMajor=DmaIntMajor_Enabled) :
+      stopOnComplete(stopOnComplete) {}
+};
+
+struct DmaTcd {
+   uint32_t  source;       ///< Source address
+   uint32_t  destination;  ///< Destination address
+   int32_t   dlast;        ///< Destination adjustment at end of major loop
+   uint32_t  nbytes;       ///< Bytes per minor loop
+   uint16_t  citer;        ///< Major loop count
+   uint16_t  biter;        ///< Initial major loop count
+   DmaTcdCsr csr;          ///< Control and status
+
+   constexpr DmaTcd(DmaInfo source, DmaInfo destination, uint32_t nbytes, DmaMinorLoopOffsetSelect, int32_t, uint16_t citer, DmaTcdCsr csr) :
+      source(source.address), destination(destination.address), dlast(destination.lastAdjustment),
+      nbytes(nbytes), citer(citer), biter(citer), csr(csr) {}
+};
+
+constexpr uint16_t dmaCiter(unsigned count) {
+   return uint16_t(count);
+}
+
+/// Number of simulated channels
+static constexpr unsigned DMA_CHANNELS = 2;
+
+struct DMA_TCD_Type {
+   uint32_t DADDR;
+};
+
+struct DMA_Type {
+   uint32_t     CR;
+   DMA_TCD_Type TCD[DMA_CHANNELS];
+};
+
+class Dma0Info {
+public:
+   enum IrqNum { IrqNum_Ch0, IrqNum_Ch1, IrqNum_Ch2, IrqNum_Ch3, IrqNum_Error, };
+   typedef DmaCallbackFunction CallbackFunction;
+   static inline DMA_Type dmaRegisters = {};
+   static inline DMA_Type *dma = &dmaRegisters;
+};
+
+class Dma0 : public Dma0Info {
+
+   /// Transfer for each channel
+   static inline DmaTcd tcds[DMA_CHANNELS] = {
+      {{0, 0, DmaSize_8bit}, {0, 0, DmaSize_8bit}, 0, DmaMinorLoopOffsetSelect_None, 0, 0, {}},
+      {{0, 0, DmaSize_8bit}, {0, 0, DmaSize_8bit}, 0, DmaMinorLoopOffsetSelect_None, 0, 0, {}},
+   };
+
+   /// Hardware requests are enabled
+   static inline bool requestEnabled[DMA_CHANNELS] = {};
+
+   /// Call-back on completion of major loop
+   static inline DmaCallbackFunction callbacks[DMA_CHANNELS] = {};
+
+   /// Number of channels allocated
+   static inline unsigned allocated = 0;
+
+   /**
+    * Convert 32-bit target address to host address.
+    * The upper bits are restored from a static object as buffers are in the same data segment.
+    */
+   static uint8_t *hostAddress(uint32_t address) {
+      uintptr_t upper = uintptr_t(&dmaRegisters)&~uintptr_t(0xFFFFFFFFU);
+      return reinterpret_cast<uint8_t *>(upper|address);
+   }
+
+public:
+   /// DMA is simulated (false => no channel is available so IrRemote uses interrupts)
+   static inline bool available = true;
+
+   /// Slot connected to each channel by DMAMUX
+   static inline DmaSlot slots[DMA_CHANNELS] = {};
+
+   static void enableClock() {}
+
+   static void setMinorLoopMapping(DmaMinorLoopMapping) {}
+
+   static DmaChannelNum allocateChannel() {
+      if (!available || (allocated >= DMA_CHANNELS)) {
+         return DmaChannelNum_None;
+      }
+      return DmaChannelNum(allocated++);
+   }
+
+   static void configureTransfer(DmaChannelNum channel, const DmaTcd &newTcd) {
+      tcds[channel] = newTcd;
+      dmaRegisters.TCD[channel].DADDR = newTcd.destination;
+   }
+
+   static void enableRequest(DmaChannelNum channel) {
+      requestEnabled[channel] = true;
+   }
+
+   static void disableRequest(DmaChannelNum channel) {
+      requestEnabled[channel] = false;
+   }
+
+   static void clearInterruptRequest(DmaChannelNum) {}
+
+   static void setCallback(DmaChannelNum channel, DmaCallbackFunction cb) {
+      callbacks[channel] = cb;
+   }
+
+   static void enableNvicInterrupts(IrqNum, NvicPriority) {}
+
+   /**
+    * Simulate a hardware request i.e. transfer one minor loop.
+    * Requests are disabled and the call-back executed on completion of the major loop if
+    * stop on complete is selected. Otherwise the destination is adjusted and the transfer restarts.
+    *
+    * @param slot          DMAMUX slot making the request
+    * @param source        Source of peripheral register (nullptr => use TCD source address)
+    * @param destination   Destination of peripheral register (nullptr => use TCD destination address)
+    *
+    * @return false => No transfer as requests are disabled
+    */
+   static bool transfer(DmaSlot slot, const uint8_t *source, uint8_t *destination) {
+      unsigned channel = 0;
+      while ((channel < allocated) && (slots[channel] != slot)) {
+         channel++;
+      }
+      if ((channel >= allocated) || !requestEnabled[channel]) {
+         return false;
+      }
+      DmaTcd &tcd = tcds[channel];
+      const uint8_t *from = (source != nullptr)?source:hostAddress(tcd.source);
+      uint8_t       *to   = (destination != nullptr)?destination:hostAddress(tcd.destination);
+      for (unsigned index=0; index<tcd.nbytes; index++) {
+         to[index] = from[index];
+      }
+      if (source == nullptr) {
+         tcd.source += tcd.nbytes;
+      }
+      if (destination == nullptr) {
+         tcd.destination += tcd.nbytes;
+      }
+      if (--tcd.citer == 0) {
+         if (tcd.csr.stopOnComplete == DmaStopOnComplete_Enabled) {
+            requestEnabled[channel] = false;
+            if (callbacks[channel] != nullptr) {
+               callbacks[channel](DmaChannelNum(channel));
+            }
+         }
+         else {
+            tcd.destination += tcd.dlast;
+            tcd.citer        = tcd.biter;
+         }
+      }
+      dmaRegisters.TCD[channel].DADDR = tcd.destination;
+      return true;
+   }
+};
+
+class Dmamux0 {
+public:
+   static void configure(DmaChannelNum channel, DmaSlot slot, DmamuxMode) {
+      Dma0::slots[channel] = slot;
+   }
+};
+
+} // End namespace USBDM
@@ -0,0 +1,165 @@
+/**
+ * @file     ftm.h (IrSimulator/src/Project_Headers/ftm.h)
+ * @brief    Simulated FlexTimer
+ *
+ * Host replacement for the USBDM FTM interface.
+ * Only the free-running counter, timer overflow and input capture with DMA as used by IrLearner are simulated.
+ * The simulator sets the counter and calls Ftm0::overflow() and Ftm0::Channel<n>::capture() as time passes.
+ */
+#pragma once
+
+#include "../Sources/hardware.h"
+#include "dma.h"
+
+namespace USBDM {
+
+enum FtmCountMode     : uint8_t  { FtmCountMode_LeftAligned, };
+enum FtmClockSource   : uint8_t  { FtmClockSource_Disabled, FtmClockSource_SystemClock, };
+enum FtmPrescale      : uint8_t  { FtmPrescale_DivBy1 = 0, FtmPrescale_DivBy32 = 5, };
+enum FtmChannelMode   : uint16_t { FtmChannelMode_Disabled, FtmChannelMode_InputCaptureEitherEdge, };
+enum FtmChannelAction : uint16_t { FtmChannelAction_None, FtmChannelAction_Dma, };
+
+/**
+ * Simulated FTM0
+ */
+class Ftm0 {
+
+public:
+   typedef void (*CallbackFunction)();
+
+   /// Simulated bus clock
+   static constexpr uint32_t busClock = 48'000'000;
+
+   /// Counter value
+   static inline uint16_t counter = 0;
+
+   /// Counter is running
+   static inline bool running = false;
+
+   /// Tick frequency
+   static inline uint32_t tickFrequency = busClock;
+
+   /// Timer overflow interrupt is enabled
+   static inline bool overflowInterruptEnabled = false;
+
+   /// Call-back on timer overflow
+   static inline CallbackFunction overflowCallback = nullptr;
+
+   static void configure(FtmCountMode, FtmClockSource ftmClockSource, FtmPrescale ftmPrescale) {
+      running       = (ftmClockSource != FtmClockSource_Disabled);
+      tickFrequency = busClock>>ftmPrescale;
+   }
+
+   static void setCounterMaximumValue(const Ticks &) {
+   }
+
+   static void resetTime() {
+      counter = 0;
+   }
+
+   static uint16_t getTime() {
+      return counter;
+   }
+
+   static void stopCounter() {
+      running = false;
+   }
+
+   static uint32_t getTickFrequencyAsInt() {
+      return tickFrequency;
+   }
+
+   static uint32_t convertTicksToMicroseconds(Ticks timeInTicks) {
+      return (static_cast<uint64_t>((unsigned)timeInTicks)*1000000)/tickFrequency;
+   }
+
+   static void setTimerOverflowCallback(CallbackFunction callback) {
+      overflowCallback = callback;
+   }
+
+   static void clearOverflowFlag() {
+   }
+
+   static void enableTimerOverflowInterrupts() {
+      overflowInterruptEnabled = true;
+   }
+
+   static void disableTimerOverflowInterrupts() {
+      overflowInterruptEnabled = false;
+   }
+
+   static void enableNvicInterrupts(NvicPriority) {
+   }
+
+   /**
+    * Simulate timer overflow interrupt
+    *
+    * @param latency Counter value when the interrupt handler executes
+    */
+   static void overflow(uint16_t latency) {
+      counter = latency;
+      if (running && overflowInterruptEnabled && (overflowCallback != nullptr)) {
+         overflowCallback();
+      }
+   }
+
+   /**
+    * Simulated timer channel
+    *
+    * @tparam channel Timer channel number
+    */
+   template<int channel>
+   class Channel {
+
+   public:
+      /** Allow access owning FTM */
+      using OwningFtm = Ftm0;
+
+      /**
+       * Pin control (ignored)
+       */
+      struct Pcr {
+         static void setPCR() {}
+      };
+
+      /// Channel value register
+      static inline uint16_t CnV = 0;
+
+      /// Channel mode
+      static inline FtmChannelMode mode = FtmChannelMode_Disabled;
+
+      /// Channel action
+      static inline FtmChannelAction action = FtmChannelAction_None;
+
+      static constexpr uint32_t ftmCnV() {
+         return 0x40038010+8*channel;
+      }
+
+      static void configure(FtmChannelMode ftmChannelMode, FtmChannelAction ftmChannelAction) {
+         mode   = ftmChannelMode;
+         action = ftmChannelAction;
+      }
+
+      static void disable() {
+         mode = FtmChannelMode_Disabled;
+      }
+
+      /**
+       * Simulate input capture
+       *
+       * @param time Counter value at time of edge
+       */
+      static void capture(uint16_t time) {
+         counter = time;
+         if (!running || (mode != FtmChannelMode_InputCaptureEitherEdge)) {
+            return;
+         }
+         CnV = time;
+         if (action == FtmChannelAction_Dma) {
+            Dma0::transfer(Dma0Slot_FTM0_Ch1, reinterpret_cast<const uint8_t *>(&CnV), nullptr);
+         }
+      }
+   };
+};
+
+} // End namespace USBDM
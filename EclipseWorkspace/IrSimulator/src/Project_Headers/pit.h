@@ -0,0 +1,75 @@
+/**
+ * @file     pit.h (IrSimulator/src/Project_Headers/pit.h)
+ * @brief    Simulated Programmable Interrupt Timer
+ *
+ * Host replacement for the USBDM PIT interface.
+ * Only one-shot operation is simulated. The simulator expires the timer by calling
+ * PitChannel::timeout().
+ * The down-counter of a periodic timer is set by the simulator (see PitChannel::counter).
+ */
+#pragma once
+
+#include "../Sources/hardware.h"
+
+namespace USBDM {
+
+/**
+ * Simulated PIT channel
+ *
+ * @tparam channel Timer channel number
+ */
+template<int channel>
+class PitChannel {
+
+public:
+   /// Allow access to the shared timer information
+   using Owner = PitChannel;
+
+   /// Down-counter value (set by the simulator)
+   static inline uint32_t counter = 0;
+
+   /// Call-back for pending one-shot (nullptr => timer idle)
+   static inline CallbackFunction callback = nullptr;
+
+   /// Interval of pending one-shot (us)
+   static inline uint32_t interval = 0;
+
+   static void defaultConfigureIfNeeded() {
+   }
+
+   static uint32_t getClockFrequency() {
+      return SystemCoreClock;
+   }
+
+   static uint32_t readCounter() {
+      return counter;
+   }
+
+   static void enableNvicInterrupts(NvicPriority) {
+   }
+
+   static void oneShotInMicroseconds(CallbackFunction callback, uint32_t microseconds) {
+      PitChannel::callback = callback;
+      interval             = microseconds;
+   }
+
+   static void disable() {
+      callback = nullptr;
+   }
+
+   static void clearInterruptFlag() {
+   }
+
+   /**
+    * Simulate expiry of one-shot timer
+    */
+   static void timeout() {
+      CallbackFunction cb = callback;
+      callback = nullptr;
+      if (cb != nullptr) {
+         cb();
+      }
+   }
+};
+
+} // End namespace USBDM
@@ -0,0 +1,22 @@
+/**
+ * @file     smc.h (IrSimulator/src/Project_Headers/smc.h)
+ * @brief    System Mode Controller placeholder
+ *
+ * Host replacement for the USBDM SMC interface.
+ */
+#pragma once
+
+#include "../Sources/hardware.h"
+
+namespace USBDM {
+
+class Smc {
+public:
+   /**
+    * The simulator is single threaded so there is nothing to wait for
+    */
+   static void enterWaitMode() {
+   }
+};
+
+} // End namespace USBDM
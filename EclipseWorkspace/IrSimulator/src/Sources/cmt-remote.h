@@ -0,0 +1 @@
+../../../RemoteControl/Sources/cmt-remote.h
\ No newline at end of file
@@ -0,0 +1,160 @@
+/**
+ * @file      hardware.h (IrSimulator/src/Sources/hardware.h)
+ *
+ * Host replacement for the USBDM library main header.
+ * Provides just enough of the library for cmt-remote.h and ir-device.h to be compiled and run on a PC.
+ */
+#ifndef INCLUDE_USBDM_HARDWARE_H_
+#define INCLUDE_USBDM_HARDWARE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * Report failed assertion
+ * Usable in constexpr code - a failure during constant evaluation is a compile error
+ */
+#define usbdm_assert(cond, msg) ((cond)?(void)0:(void)printf("Assertion failed: %s\n", msg))
+
+namespace USBDM {
+
+/// Time in ticks 1_tick = 1us
+enum Ticks : unsigned {};
+
+using Seconds = float;
+using Hertz   = float;
+
+constexpr Ticks operator+(const Ticks &left, const Ticks &right) { return Ticks(unsigned(left)+unsigned(right)); }
+constexpr Ticks operator-(const Ticks &left, const Ticks &right) { return Ticks(unsigned(left)-unsigned(right)); }
+constexpr Ticks operator*(const Ticks &left, const int &right)   { return Ticks(unsigned(left)*right); }
+constexpr Ticks operator*(const int &left, const Ticks &right)   { return Ticks(left*unsigned(right)); }
+
+consteval Ticks   operator""_ticks(unsigned long long int num) { return static_cast<Ticks>((unsigned)num); }
+consteval Hertz   operator""_kHz(unsigned long long int num)   { return static_cast<Hertz>((double)(num*1000)); }
+consteval Hertz   operator""_MHz(unsigned long long int num)   { return static_cast<Hertz>((double)(num*1000000)); }
+consteval Seconds operator""_ms(unsigned long long int num)    { return static_cast<Seconds>((double)(num*0.001)); }
+
+enum ErrorCode {
+   E_NO_ERROR,
+   E_NO_RESOURCE,
+   E_ILLEGAL_PARAM,
+   E_WRONG_STATE,
+};
+
+static inline ErrorCode setErrorCode(ErrorCode errorCode) {
+   return errorCode;
+}
+
+typedef void (*CallbackFunction)();
+
+enum NvicPriority {
+   NvicPriority_Normal,
+   NvicPriority_High,
+   NvicPriority_Low,
+};
+
+enum PinDriveStrength { PinDriveStrength_Low, PinDriveStrength_High, };
+enum PinDriveMode     { PinDriveMode_PushPull, PinDriveMode_OpenDrain, };
+enum PinSlewRate      { PinSlewRate_Slow, PinSlewRate_Fast, };
+
+typedef uint32_t PcrValue;
+
+/**
+ * Pin configuration - Only the drive strength is retained
+ */
+struct PcrInit {
+   PinDriveStrength driveStrength = PinDriveStrength_Low;
+
+   template<typename... Types>
+   constexpr PcrInit(Types... types) { (set(types), ...); }
+   constexpr void set(PinDriveStrength value) { driveStrength = value; }
+   template<typename Type>
+   constexpr void set(Type) {}
+   constexpr operator PcrValue() const { return driveStrength; }
+};
+
+/**
+ * Critical section - the simulator is single threaded
+ */
+struct CriticalSection {
+   CriticalSection() {}
+   ~CriticalSection() {}
+};
+
+enum Width   { Width_2, Width_4, Width_8, Width_10, };
+enum Padding { Padding_LeadingSpaces, Padding_LeadingZeroes, };
+enum Radix   { Radix_10, Radix_16, };
+
+/**
+ * Integer formatting (ignored)
+ */
+struct IntegerFormat {
+   template<typename... Types>
+   constexpr IntegerFormat(Types...) {}
+};
+
+/**
+ * Console - Output is discarded so it doesn't disturb the simulator report
+ */
+struct Console {
+   template<typename... Types>
+   Console &write(Types...) { return *this; }
+   template<typename... Types>
+   Console &writeln(Types...) { return *this; }
+};
+
+inline Console console;
+
+} // End namespace USBDM
+
+static inline void __disable_irq() {}
+static inline void __enable_irq()  {}
+static inline uint32_t __get_IPSR()    { return 0; }
+static inline uint32_t __get_PRIMASK() { return 0; }
+
+/**
+ * DWT cycle counter - Advanced by the simulator as modulator cycles are produced
+ */
+struct DWT_Type {
+   uint32_t CTRL;
+   uint32_t CYCCNT;
+};
+
+struct CoreDebug_Type {
+   uint32_t DEMCR;
+};
+
+inline DWT_Type       dwtRegisters;
+inline CoreDebug_Type coreDebugRegisters;
+
+#define DWT       (&dwtRegisters)
+#define CoreDebug (&coreDebugRegisters)
+
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+/// Core clock (Hz)
+inline uint32_t SystemCoreClock = 48000000;
+
+#include "../Project_Headers/pit.h"
+#include "../Project_Headers/ftm.h"
+
+namespace USBDM {
+
+typedef PitChannel<0> ButtonTimerChannel;
+
+typedef PitChannel<1> IrDelayChannel;
+
+typedef Ftm0::Channel<1> IrCaptureChannel;
+
+/**
+ * IR receiver pin (ignored)
+ */
+struct IrReceiver {
+   static void setInput() {}
+};
+
+} // End namespace USBDM
+
+#endif /* INCLUDE_USBDM_HARDWARE_H_ */
@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-code-database.h
\ No newline at end of file
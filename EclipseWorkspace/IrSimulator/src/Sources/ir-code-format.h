@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-code-format.h
\ No newline at end of file
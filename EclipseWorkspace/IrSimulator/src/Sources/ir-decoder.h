@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-decoder.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-device.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-learner.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-pronto-codes.h
\ No newline at end of file
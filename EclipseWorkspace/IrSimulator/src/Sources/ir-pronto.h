@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-pronto.h
\ No newline at end of file
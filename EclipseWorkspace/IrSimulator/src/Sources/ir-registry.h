@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-registry.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../../RemoteControl/Sources/ir-timing.h
\ No newline at end of file
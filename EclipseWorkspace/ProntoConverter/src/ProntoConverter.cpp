@@ -0,0 +1,395 @@
+//============================================================================
+// Name        : ProntoConverter.cpp
+// Description : Host tool to convert Pronto hex codes to modulator cycles (RemoteControl/Sources/ir-pronto-codes.h)
+//
+// The input is a list of Pronto hex codes e.g. "Data Files/Pronto Codes.txt":
+//    # Comment
+//    [Device name]
+//    KEY_NAME 0000 006D 0022 0002 0156 00AB ...
+//
+// Only learned codes (0000) are supported:
+//    0000 <frequency> <once pairs> <repeat pairs> { <mark> <space> }
+// Mark and space are in carrier periods. The carrier period is frequency * 0.241246 us.
+//
+// Each sequence is converted to the modulator cycles used by IrRemote (1_tick = 1us).
+// Spaces too long for a single cycle are continued by extended space cycles as done by
+// the IrRemote interpreter. A dummy cycle completes each sequence.
+//
+// All sequences are placed in a single table of cycles. A sequence that is the same as
+// (or the end of) an earlier sequence shares its cycles.
+//
+// Usage:
+//    ProntoConverter <output.h> <codes.txt> ...
+// e.g.
+//    ProntoConverter ir-pronto-codes.h "Pronto Codes.txt"
+//============================================================================
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/// Carrier period unit of Pronto frequency word (us)
+static constexpr double PRONTO_UNIT = 0.241246;
+
+/// Longest space in a modulator cycle (us)
+static constexpr unsigned MAX_SPACE = 0xFFFF;
+
+/// Longest extended space cycle (us) - As used by IrRemote interpreter
+static constexpr unsigned MAX_EXTENDED = 2*65000;
+
+/**
+ * Modulator cycle (see IrRemote::Interval)
+ */
+struct Cycle {
+   unsigned mark;       ///< Mark period (us)
+   unsigned space;      ///< Space period (us)
+   bool     extended;   ///< Mark period is replaced by space
+
+   bool operator==(const Cycle &other) const {
+      return (mark == other.mark) && (space == other.space) && (extended == other.extended);
+   }
+};
+
+/**
+ * Sequence of cycles and location in the cycle table
+ */
+struct Sequence {
+   std::vector<Cycle> cycles;   ///< Cycles including dummy cycle (empty => no sequence)
+   unsigned           offset;   ///< Offset of sequence in cycle table
+};
+
+/**
+ * Code read from file
+ */
+struct Code {
+   std::string device;      ///< Device name e.g. "Philips TV"
+   std::string key;         ///< Key name e.g. STANDBY
+   unsigned    frequency;   ///< Carrier frequency (Hz)
+   Sequence    once;        ///< Once sequence
+   Sequence    repeat;      ///< Repeat sequence
+};
+
+/// File being processed
+static const char *fileName;
+
+/// Line being processed
+static unsigned lineNumber;
+
+/**
+ * Report error and exit
+ *
+ * @param message Message to report
+ */
+[[noreturn]] static void error(const char *message) {
+   fprintf(stderr, "%s:%u: %s\n", fileName, lineNumber, message);
+   exit(EXIT_FAILURE);
+}
+
+/**
+ * Convert Pronto burst pairs to modulator cycles
+ *
+ * @param words   Burst pairs (carrier periods)
+ * @param pairs   Number of burst pairs
+ * @param period  Carrier period (us)
+ *
+ * @return Cycles including dummy cycle (empty if pairs == 0)
+ */
+static std::vector<Cycle> convert(const uint16_t words[], unsigned pairs, double period) {
+
+   std::vector<Cycle> cycles;
+   if (pairs == 0) {
+      return cycles;
+   }
+   for (unsigned pair=0; pair<pairs; pair++) {
+      unsigned mark  = unsigned(lround(words[2*pair]*period));
+      unsigned space = unsigned(lround(words[2*pair+1]*period));
+      if ((mark == 0) || (mark > 0xFFFF)) {
+         error("Mark out of range");
+      }
+      unsigned remainder = (space > MAX_SPACE)?space-MAX_SPACE:0;
+      cycles.push_back({mark, space-remainder, false});
+
+      // Continue space with extended cycles
+      while (remainder > 0) {
+         unsigned high = std::min(remainder, MAX_EXTENDED);
+         unsigned low  = high/2;
+         cycles.push_back({high-low, low, true});
+         remainder -= high;
+      }
+   }
+   // Dummy cycle to wait for Tx complete
+   cycles.push_back({1, 0, true});
+   return cycles;
+}
+
+/**
+ * Read codes from file
+ *
+ * @param codes   Codes read are added to this
+ */
+static void readCodes(std::vector<Code> &codes) {
+
+   FILE *fp = fopen(fileName, "r");
+   if (fp == nullptr) {
+      fprintf(stderr, "Failed to open %s\n", fileName);
+      exit(EXIT_FAILURE);
+   }
+   std::string device;
+   char        buffer[2000];
+   lineNumber = 0;
+   while (fgets(buffer, sizeof(buffer), fp) != nullptr) {
+      lineNumber++;
+      char *line = buffer;
+      while (isspace(*line)) {
+         line++;
+      }
+      if ((*line == '\0') || (*line == '#')) {
+         continue;
+      }
+      if (*line == '[') {
+         char *end = strchr(line, ']');
+         if (end == nullptr) {
+            error("Missing ']'");
+         }
+         device = std::string(line+1, end);
+         continue;
+      }
+      if (device.empty()) {
+         error("Code before [Device name]");
+      }
+      Code code{};
+      code.device = device;
+      while ((*line != '\0') && !isspace(*line)) {
+         if (!isupper(*line) && !isdigit(*line) && (*line != '_')) {
+            error("Key name must be an upper-case identifier");
+         }
+         code.key += *line++;
+      }
+      std::vector<uint16_t> words;
+      for(;;) {
+         char *end;
+         unsigned long word = strtoul(line, &end, 16);
+         if (end == line) {
+            break;
+         }
+         if (word > 0xFFFF) {
+            error("Pronto word too large");
+         }
+         words.push_back(uint16_t(word));
+         line = end;
+      }
+      while (isspace(*line)) {
+         line++;
+      }
+      if (*line != '\0') {
+         error("Unexpected character in Pronto code");
+      }
+      if ((words.size() < 4) || (words[0] != 0x0000)) {
+         error("Only learned Pronto codes (0000) are supported");
+      }
+      if (words[1] == 0) {
+         error("Carrier frequency missing");
+      }
+      unsigned oncePairs   = words[2];
+      unsigned repeatPairs = words[3];
+      if ((oncePairs+repeatPairs == 0) || (words.size() != 4+2*(oncePairs+repeatPairs))) {
+         error("Number of Pronto words doesn't match burst pair counts");
+      }
+      double period  = words[1]*PRONTO_UNIT;
+      code.frequency = unsigned(lround(1'000'000/period));
+      if (code.frequency > 0xFFFF) {
+         error("Carrier frequency too high");
+      }
+      code.once.cycles   = convert(words.data()+4,             oncePairs,   period);
+      code.repeat.cycles = convert(words.data()+4+2*oncePairs, repeatPairs, period);
+      for (const Code &other : codes) {
+         if ((other.device == code.device) && (other.key == code.key)) {
+            error("Duplicate key");
+         }
+      }
+      codes.push_back(code);
+   }
+   fclose(fp);
+}
+
+/**
+ * Place sequences in the cycle table.
+ * Longest sequences are placed first so that shorter sequences may share their cycles.
+ *
+ * @param codes   Codes to place (sequence offsets are updated)
+ *
+ * @return Cycle table
+ */
+static std::vector<Cycle> placeSequences(std::vector<Code> &codes) {
+
+   std::vector<Sequence *> sequences;
+   for (Code &code : codes) {
+      sequences.push_back(&code.once);
+      sequences.push_back(&code.repeat);
+   }
+   std::stable_sort(sequences.begin(), sequences.end(), [](const Sequence *a, const Sequence *b) {
+      return a->cycles.size() > b->cycles.size();
+   });
+   std::vector<Cycle> table;
+   for (Sequence *sequence : sequences) {
+      if (sequence->cycles.empty()) {
+         sequence->offset = 0;
+         continue;
+      }
+      auto match = std::search(table.begin(), table.end(), sequence->cycles.begin(), sequence->cycles.end());
+      sequence->offset = unsigned(match-table.begin());
+      if (match == table.end()) {
+         table.insert(table.end(), sequence->cycles.begin(), sequence->cycles.end());
+      }
+   }
+   return table;
+}
+
+/**
+ * Convert device name to C identifier e.g. "Philips TV" => PhilipsTv
+ *
+ * @param name Device name
+ *
+ * @return Identifier
+ */
+static std::string identifier(const std::string &name) {
+   std::string result;
+   bool startWord = true;
+   for (char ch : name) {
+      if (!isalnum(ch)) {
+         startWord = true;
+         continue;
+      }
+      // Words are capitalised
+      result   += startWord?toupper(ch):tolower(ch);
+      startWord = false;
+   }
+   return result;
+}
+
+/**
+ * Get reference to sequence in cycle table
+ *
+ * @param sequence Sequence
+ *
+ * @return Reference e.g. "cycles+35" or "nullptr" if no sequence
+ */
+static std::string reference(const Sequence &sequence) {
+   if (sequence.cycles.empty()) {
+      return "nullptr";
+   }
+   return "cycles+"+std::to_string(sequence.offset);
+}
+
+/**
+ * Write codes header file
+ *
+ * @param fp      File to write
+ * @param codes   Codes
+ * @param table   Cycle table
+ */
+static void writeCodes(FILE *fp, const std::vector<Code> &codes, const std::vector<Cycle> &table) {
+
+   fprintf(fp,
+         "/**\n"
+         " * @file    ir-pronto-codes.h\n"
+         " * @brief   IR codes converted from Pronto hex\n"
+         " *\n"
+         " * Generated by ProntoConverter from \"Data Files/Pronto Codes.txt\"\n"
+         " */\n"
+         "\n"
+         "/*\n"
+         " * *****************************\n"
+         " * *** DO NOT EDIT THIS FILE ***\n"
+         " * *****************************\n"
+         " *\n"
+         " * This file is generated automatically.\n"
+         " * Any manual changes will be lost.\n"
+         " */\n"
+         "#pragma once\n"
+         "\n"
+         "#include \"ir-pronto.h\"\n"
+         "\n"
+         "namespace USBDM {\n"
+         "\n"
+         "/**\n"
+         " * IR codes converted from Pronto hex - %u codes, %u cycles\n"
+         " */\n"
+         "class IrProntoCodes : public IrPronto {\n"
+         "\n"
+         "private:\n"
+         "   IrProntoCodes() = delete;\n"
+         "   IrProntoCodes(const IrProntoCodes &) = delete;\n"
+         "\n"
+         "   /// Modulator cycles of all sequences 1_tick = 1us\n"
+         "   static constexpr CmtCycle cycles[] = {\n"
+         "      //  Mark   Space  Extended\n",
+         unsigned(codes.size()), unsigned(table.size()));
+
+   for (unsigned index=0; index<table.size(); index++) {
+      const Cycle &cycle = table[index];
+      fprintf(fp, "      {{ %5u, %5u, %-5s }},  // %u\n",
+            cycle.mark, cycle.space, cycle.extended?"true":"false", index);
+   }
+   fprintf(fp,
+         "   };\n"
+         "\n"
+         "public:");
+
+   std::string device;
+   for (const Code &code : codes) {
+      if (code.device != device) {
+         device = code.device;
+         fprintf(fp, "\n   // %s\n", device.c_str());
+      }
+      std::string name = identifier(code.device)+"_"+code.key;
+      fprintf(fp, "   static constexpr ProntoCode %-24s = { %5u, %3u, %3u, %-11s, %-11s };\n",
+            name.c_str(), code.frequency,
+            unsigned(code.once.cycles.size()), unsigned(code.repeat.cycles.size()),
+            reference(code.once).c_str(), reference(code.repeat).c_str());
+   }
+   fprintf(fp,
+         "};\n"
+         "\n"
+         "} // End namespace USBDM\n");
+}
+
+int main(int argc, char *argv[]) {
+
+   if (argc < 3) {
+      fprintf(stderr, "Usage: ProntoConverter <output.h> <codes.txt> ...\n");
+      return EXIT_FAILURE;
+   }
+
+   std::vector<Code> codes;
+   for (int arg=2; arg<argc; arg++) {
+      fileName = argv[arg];
+      readCodes(codes);
+   }
+   if (codes.empty()) {
+      fprintf(stderr, "No codes found\n");
+      return EXIT_FAILURE;
+   }
+   std::vector<Cycle> table = placeSequences(codes);
+
+   FILE *fp = fopen(argv[1], "w");
+   if (fp == nullptr) {
+      fprintf(stderr, "Failed to open %s\n", argv[1]);
+      return EXIT_FAILURE;
+   }
+   writeCodes(fp, codes, table);
+   fclose(fp);
+
+   unsigned cycleCount = 0;
+   for (const Code &code : codes) {
+      cycleCount += code.once.cycles.size()+code.repeat.cycles.size();
+   }
+   printf("%u codes, %u cycles (%u before sharing)\n", unsigned(codes.size()), unsigned(table.size()), cycleCount);
+   return EXIT_SUCCESS;
+}
@@ -25,7 +25,7 @@
 
 namespace USBDM {
 
-#if false // /DMA/_BasicInfoGuard
+#if true // /DMA/_BasicInfoGuard
 
 /**
  * @addtogroup DMA_Group DMA, Direct Memory Access (DMA)
@@ -355,10 +355,136 @@ namespace USBDM {
       DmaMinorLoopOffsetSelect_Both          = DMA_NBYTES_MLOFFYES_SMLOE(1)|DMA_NBYTES_MLOFFYES_DMLOE(1),  ///< Offset Source and Destination
    };
 
+/**
+ * Class used to do initialisation of the DMA controller
+ *
+ * This class has a templated constructor that accepts various values.
+ *
+ * @note This constructor may be used to create a const instance in Flash
+ *
+ * Example:
+ * @code
+ * static const DmaConfig dmaConfig {
+ *    DmaActionOnError_Halt,
+ *    DmaMinorLoopMapping_Enabled,
+ *    DmaArbitration_Fixed,
+ * };
+ *
+ * // Initialise DMA controller from values specified above
+ * Dma0::configure(dmaConfig)
+ * @endcode
+ */
+class DmaConfig {
+
+public:
+   /**
+    * Copy Constructor
+    */
+   constexpr DmaConfig(const DmaConfig &other) = default;
+
+   /**
+    * Default Constructor
+    */
+   constexpr DmaConfig() = default;
+
+   /// Control Register
+   uint32_t cr = 0;
+
+   /**
+    * Constructor for DMA halt on error
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaActionOnError Whether to halt transfer when a DMA error occurs
+    */
+   template <typename... Types>
+   constexpr DmaConfig(DmaActionOnError dmaActionOnError, Types... rest) : DmaConfig(rest...) {
+
+      cr = (cr&~DMA_CR_HOE_MASK) | dmaActionOnError;
+   }
+
+   /**
+    * Constructor for Continuous Link mode
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaContinuousLink Whether to enable continuous link mode
+    */
+   template <typename... Types>
+   constexpr DmaConfig(DmaContinuousLink dmaContinuousLink, Types... rest) : DmaConfig(rest...) {
+
+      cr = (cr&~DMA_CR_CLM_MASK) | dmaContinuousLink;
+   }
+
+   /**
+    * Constructor for Minor loop mapping
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaMinorLoopMapping Whether to enable minor loop mapping
+    */
+   template <typename... Types>
+   constexpr DmaConfig(DmaMinorLoopMapping dmaMinorLoopMapping, Types... rest) : DmaConfig(rest...) {
+
+      cr = (cr&~DMA_CR_EMLM_MASK) | dmaMinorLoopMapping;
+   }
+
+   /**
+    * Constructor for Channel Arbitration
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaArbitration How to arbitrate between requests from different channels
+    */
+   template <typename... Types>
+   constexpr DmaConfig(DmaArbitration dmaArbitration, Types... rest) : DmaConfig(rest...) {
+
+      cr = (cr&~DMA_CR_ERCA_MASK) | dmaArbitration;
+   }
+
+   /**
+    * Constructor for Operation in Debug mode
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaInDebug Control DMA operation in debug mode
+    */
+   template <typename... Types>
+   constexpr DmaConfig(DmaInDebug dmaInDebug, Types... rest) : DmaConfig(rest...) {
+
+      cr = (cr&~DMA_CR_EDBG_MASK) | dmaInDebug;
+   }
+
+}; // class DmaConfig
+
 class DmaBasicInfo {
 
 public:
 
+   //! Common class based callback code has been generated for this class of peripheral
+   // (_BasicInfoIrqGuard)
+   static constexpr bool irqHandlerInstalled = true;
+   
+   /**
+    * Type definition for DMA interrupt call back.
+    *
+    * @param dmaChannelNum Channel causing the interrupt
+    *                      For the error interrupt this is the channel that caused the error
+    */
+   typedef void (*CallbackFunction)(DmaChannelNum dmaChannelNum);
+   
+   /**
+    * Callback to catch unhandled interrupt
+    */
+   static void unhandledCallback(DmaChannelNum) {
+      setAndCheckErrorCode(E_NO_HANDLER);
+   }
+   
 }; // class DmaBasicInfo 
 
 class Dma0Info : public DmaBasicInfo {
@@ -415,6 +541,87 @@ public:
       NVIC_DisableIRQ(irqNums[irqNum]);
    }
    
+   /** Callback function for Dma0 */
+   static inline CallbackFunction sCallbacks[5] = {
+      unhandledCallback,  // DMA0_Ch0_IRQn 
+      unhandledCallback,  // DMA0_Ch1_IRQn 
+      unhandledCallback,  // DMA0_Ch2_IRQn 
+      unhandledCallback,  // DMA0_Ch3_IRQn 
+      unhandledCallback,  // DMA0_Error_IRQn 
+   };
+   
+   /**
+    * Set interrupt callback function.
+    *
+    * @param irqNum Select amongst interrupts associated with the peripheral
+    * @param  dmaCallback Callback function to execute on interrupt
+    *                             Use nullptr to remove callback.
+    */
+   static void setCallback(IrqNum irqNum, CallbackFunction dmaCallback) {
+      if (dmaCallback == nullptr) {
+         dmaCallback = unhandledCallback;
+      }
+      // Allow either no handler set yet, setting same handler or removing handler
+      usbdm_assert(
+            (sCallbacks[irqNum] == unhandledCallback) ||
+            (sCallbacks[irqNum] == dmaCallback) ||
+            (dmaCallback == unhandledCallback),
+            "Handler already set");
+      sCallbacks[irqNum] = dmaCallback;
+   }
+   
+   /**
+    * Set interrupt callback function for a channel.
+    * This is executed on completion of the major loop (if enabled in the TCD).
+    *
+    * @param dmaChannelNum Channel to set callback for
+    * @param dmaCallback   Callback function to execute on interrupt
+    *                      Use nullptr to remove callback.
+    */
+   static void setCallback(DmaChannelNum dmaChannelNum, CallbackFunction dmaCallback) {
+      usbdm_assert(dmaChannelNum<NumChannels, "Illegal DMA channel");
+      setCallback(IrqNum(dmaChannelNum), dmaCallback);
+   }
+   
+   /**
+    * Set error callback function.
+    * This is executed when a DMA error occurs on any channel.
+    *
+    * @param dmaCallback   Callback function to execute on interrupt
+    *                      Use nullptr to remove callback.
+    */
+   static void setErrorCallback(CallbackFunction dmaCallback) {
+      setCallback(IrqNum_Error, dmaCallback);
+   }
+   
+   /**
+    * DMA interrupt handler -  Calls DMA callback
+    * Used when each channel has an individual handler (IRQ vector)
+    *
+    * @tparam irqNum Interrupt being handled
+    */
+   template<IrqNum irqNum>
+   static void irqHandler() {
+   
+      if constexpr (irqNum == IrqNum_Error) {
+         // Channel that caused error
+         DmaChannelNum dmaChannelNum = DmaChannelNum((dma->ES&DMA_ES_ERRCHN_MASK)>>DMA_ES_ERRCHN_SHIFT);
+   
+         // Clear error flag
+         dma->CERR = dmaChannelNum;
+   
+         // Call handler
+         sCallbacks[irqNum](dmaChannelNum);
+      }
+      else {
+         // Clear interrupt flag
+         dma->CINT = irqNum;
+   
+         // Call handler
+         sCallbacks[irqNum](DmaChannelNum(irqNum));
+      }
+   }
+   
    /**
     *  Enable clock to Dma0
     */
@@ -449,6 +656,18 @@ public:
    //! Whether vectors are paired wrt channels i.e. Ch0_Ch16, Ch1_Ch17 etc
    static constexpr bool VectorsPaired = 4>5;
 
+   /**
+    * Default initialisation value for Dma0
+    * This value is created from Configure.usbdmProject settings
+    */
+   static constexpr DmaConfig DefaultDmaConfigValue = {
+      DmaActionOnError_Continue ,      // (dma_cr_hoe)               DMA halt on error - Transfer continues on any error
+      DmaContinuousLink_Disabled ,     // (dma_cr_clm)               Continuous Link mode - Continuous Link disabled
+      DmaMinorLoopMapping_Disabled ,   // (dma_cr_emlm)              Minor loop mapping - Mapping disabled
+      DmaArbitration_Fixed ,           // (dma_cr_erca)              Channel Arbitration - Fixed (within group)
+      DmaInDebug_Continue,             // (dma_cr_edbg)              Operation in Debug mode - Continue in debug
+   };
+
 }; // class Dma0Info
 
 
@@ -725,6 +944,145 @@ struct __attribute__((__packed__)) DmaTcdAttr {
    }
 };
 
+/**
+ * Transfer Control Descriptor Control and Status value
+ *
+ * This has a templated constructor that accepts the CSR options in any order.
+ * Inactive options may be omitted.
+ *
+ * Example:
+ * @code
+ * static constexpr DmaTcdCsr dmaTcdCsr {
+ *    DmaStopOnComplete_Enabled,
+ *    DmaIntMajor_Enabled,
+ * };
+ * @endcode
+ */
+struct __attribute__((__packed__)) DmaTcdCsr {
+
+   /// CSR value
+   uint16_t data = 0;
+
+   /**
+    * Default constructor
+    */
+   constexpr DmaTcdCsr() = default;
+
+   /**
+    * Default copy constructor
+    */
+   constexpr DmaTcdCsr(const DmaTcdCsr &other) = default;
+
+   DmaTcdCsr &operator=(const DmaTcdCsr &other) = default;
+
+   /**
+    * Constructor for Software start of channel
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaStart Software start of channel
+    */
+   template <typename... Types>
+   constexpr DmaTcdCsr(DmaStart dmaStart, Types... rest) : DmaTcdCsr(rest...) {
+
+      data = (data&~DMA_CSR_START_MASK) | dmaStart;
+   }
+
+   /**
+    * Constructor for Disable hardware request on major loop completion
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaStopOnComplete Disable hardware request on major loop completion
+    */
+   template <typename... Types>
+   constexpr DmaTcdCsr(DmaStopOnComplete dmaStopOnComplete, Types... rest) : DmaTcdCsr(rest...) {
+
+      data = (data&~DMA_CSR_DREQ_MASK) | dmaStopOnComplete;
+   }
+
+   /**
+    * Constructor for Interrupt request on major loop completion
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaIntMajor Interrupt request on major loop completion
+    */
+   template <typename... Types>
+   constexpr DmaTcdCsr(DmaIntMajor dmaIntMajor, Types... rest) : DmaTcdCsr(rest...) {
+
+      data = (data&~DMA_CSR_INTMAJOR_MASK) | dmaIntMajor;
+   }
+
+   /**
+    * Constructor for Interrupt request on major loop half completion
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaIntHalf Interrupt request on major loop half completion
+    */
+   template <typename... Types>
+   constexpr DmaTcdCsr(DmaIntHalf dmaIntHalf, Types... rest) : DmaTcdCsr(rest...) {
+
+      data = (data&~DMA_CSR_INTHALF_MASK) | dmaIntHalf;
+   }
+
+   /**
+    * Constructor for Bandwidth (speed) Control
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaSpeed Control how channel monopolises the bus
+    */
+   template <typename... Types>
+   constexpr DmaTcdCsr(DmaSpeed dmaSpeed, Types... rest) : DmaTcdCsr(rest...) {
+
+      data = (data&~DMA_CSR_BWC_MASK) | dmaSpeed;
+   }
+
+   /**
+    * Constructor for Scatter/Gather operations
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaScatterGather Enable Scatter/Gather operations
+    */
+   template <typename... Types>
+   constexpr DmaTcdCsr(DmaScatterGather dmaScatterGather, Types... rest) : DmaTcdCsr(rest...) {
+
+      data = (data&~DMA_CSR_ESG_MASK) | dmaScatterGather;
+   }
+
+   /**
+    * Constructor for Major loop link
+    *
+    * @tparam   Types
+    * @param    rest
+    *
+    * @param dmaMajorLink Enable linking to another channel on major loop completion
+    */
+   template <typename... Types>
+   constexpr DmaTcdCsr(DmaMajorLink dmaMajorLink, Types... rest) : DmaTcdCsr(rest...) {
+
+      data = (data&~(DMA_CSR_MAJORELINK_MASK|DMA_CSR_MAJORLINKCH_MASK)) | dmaMajorLink;
+   }
+
+   /**
+    * Get CSR value
+    *
+    * @return Value suitable for writing to TCD.CSR
+    */
+   constexpr operator uint16_t() const {
+      return data;
+   }
+};
+
 /**
  *  Used to create transfer information for source or destination
  */
@@ -1062,7 +1420,7 @@ public:
     *
     * @param dmaActionOnError Whether to halt transfer when a DMA error occurs
     */
-   void SetActionOnError(DmaActionOnError dmaActionOnError) {
+   static void SetActionOnError(DmaActionOnError dmaActionOnError) {
    
       dma->CR = (dma->CR & ~DMA_CR_HOE_MASK)|dmaActionOnError;
    }
@@ -1075,7 +1433,7 @@ public:
     *        channel has a minor loop channel link enabled and the link channel is itself. 
     *        This effectively applies the minor loop offsets and restarts the next minor loop
     */
-   void SetLinkMode(DmaContinuousLink dmaContinuousLink) {
+   static void SetLinkMode(DmaContinuousLink dmaContinuousLink) {
    
       dma->CR = (dma->CR & ~DMA_CR_CLM_MASK)|dmaContinuousLink;
    }
@@ -1089,7 +1447,7 @@ public:
     *        applied to the source address, the destination address, or both.  
     *        The NBYTES field is reduced when either offset is enabled.
     */
-   void SetMinorLoopMapping(DmaMinorLoopMapping dmaMinorLoopMapping) {
+   static void SetMinorLoopMapping(DmaMinorLoopMapping dmaMinorLoopMapping) {
    
       dma->CR = (dma->CR & ~DMA_CR_EMLM_MASK)|dmaMinorLoopMapping;
    }
@@ -1099,7 +1457,7 @@ public:
     *
     * @param dmaArbitration How to arbitrate between requests from different channels
     */
-   void SetArbitration(DmaArbitration dmaArbitration) {
+   static void SetArbitration(DmaArbitration dmaArbitration) {
    
       dma->CR = (dma->CR & ~DMA_CR_ERCA_MASK)|dmaArbitration;
    }
@@ -1109,7 +1467,7 @@ public:
     *
     * @param dmaInDebug Control DMA operation in debug mode
     */
-   void SetActionInDebug(DmaInDebug dmaInDebug) {
+   static void SetActionInDebug(DmaInDebug dmaInDebug) {
    
       dma->CR = (dma->CR & ~DMA_CR_EDBG_MASK)|dmaInDebug;
    }
@@ -1120,7 +1478,7 @@ public:
     *
     * @param[in] dmaMinorLoopMapping Whether to enable minor loop mapping
     */
-   void setMinorLoopMapping(DmaMinorLoopMapping  dmaMinorLoopMapping) {
+   static void setMinorLoopMapping(DmaMinorLoopMapping  dmaMinorLoopMapping) {
       dma->CR = (dma->CR&~(DMA_CR_EMLM(1)))|dmaMinorLoopMapping;
    }
 
@@ -1129,7 +1487,7 @@ public:
     *
     * @param[in] dmaActionOnError Whether to halt when a DMA error occurs
     */
-   void setErrorHandling(DmaActionOnError dmaActionOnError) {
+   static void setErrorHandling(DmaActionOnError dmaActionOnError) {
       dma->CR = (dma->CR&~(DMA_CR_HOE(1)))|dmaActionOnError;
    }
 
@@ -1139,7 +1497,7 @@ public:
     *
     * @param[in] dmaContinuousLink       Whether to enable continuous link mode
     */
-   void setLinking(DmaContinuousLink dmaContinuousLink) {
+   static void setLinking(DmaContinuousLink dmaContinuousLink) {
       dma->CR = (dma->CR&~(DMA_CR_CLM(1)))|dmaContinuousLink;
    }
 
@@ -1508,6 +1866,63 @@ constexpr DmaSlot inline operator+(DmaSlot slot, int offset) {
 /** Bit-mask of allocated channels */
 template<class Info> uint32_t DmaBase_T<Info>::allocatedChannels = (1<<Info::NumChannels)-1;
 
+/**
+ * Class representing a DMA multiplexor.
+ *
+ * @tparam Info Information describing DMA multiplexor
+ */
+template<class Info>
+class DmamuxBase_T : public Info {
+
+protected:
+   /** Hardware instance pointer */
+   static constexpr HardwarePtr<DMAMUX_Type> dmamux = Info::baseAddress;
+
+public:
+   /**
+    * Configure the DMA channel source and mode.
+    * This enables the clock to the DMAMUX.
+    *
+    * @param[in] dmaChannelNum   DMA channel to configure
+    * @param[in] dmaSlot         Hardware trigger source (slot) for the channel
+    * @param[in] dmamuxMode      Mode of operation of the channel
+    *
+    * @note The channel is disabled while being changed as required by the hardware.
+    */
+   static void configure(DmaChannelNum dmaChannelNum, DmaSlot dmaSlot, DmamuxMode dmamuxMode=DmamuxMode_Continuous) {
+
+      usbdm_assert(dmaChannelNum<Info::NumChannels, "Illegal DMA channel");
+      usbdm_assert((dmamuxMode != DmamuxMode_Throttled)||(dmaChannelNum<Info::NumPeriodicChannels), "Channel does not support throttling");
+
+      Info::enableClock();
+      dmamux->CHCFG[dmaChannelNum] = 0;
+      __DSB();
+      dmamux->CHCFG[dmaChannelNum] = dmamuxMode|DMAMUX_CHCFG_SOURCE(dmaSlot);
+   }
+
+   /**
+    * Disable the DMA channel source.
+    *
+    * @param[in] dmaChannelNum   DMA channel to disable
+    */
+   static void disable(DmaChannelNum dmaChannelNum) {
+
+      usbdm_assert(dmaChannelNum<Info::NumChannels, "Illegal DMA channel");
+
+      dmamux->CHCFG[dmaChannelNum] = 0;
+   }
+};
+
+/**
+ * Class representing DMA0
+ */
+typedef DmaBase_T<Dma0Info> Dma0;
+
+/**
+ * Class representing DMAMUX0
+ */
+typedef DmamuxBase_T<Dmamux0Info> Dmamux0;
+
 
 
 
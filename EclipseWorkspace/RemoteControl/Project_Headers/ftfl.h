@@ -225,11 +225,11 @@ public:
    
    /// FlexNVM - EEPROM size
    static constexpr FlashEepromSize eepromSize = 
-      FlashEepromSize_2KBytes;  // (eeprom_size)              FlexNVM - EEPROM size - 2 KiB
+      FlashEepromSize_32Bytes;  // (eeprom_size)              FlexNVM - EEPROM size - 32 bytes
    
    /// FlexNVM - Flash EEPROM partitioning
    static constexpr FlashPartition flashPartition = 
-      FlashPartition_Flash0K_eeprom32K;  // (flash_partition)          FlexNVM - Flash EEPROM partitioning - flash=0B eeprom backing=32KiB
+      FlashPartition_Flash24K_eeprom8K;  // (flash_partition)          FlexNVM - Flash EEPROM partitioning - flash=24KiB eeprom backing=8KiB
    
 }; // class FtflInfo
 
@@ -20,7 +20,7 @@
 #include "pin_mapping.h"
 #include "gpio.h"
 
-#if false // /FTM/_BasicInfoGuard
+#if true // /FTM/_BasicInfoGuard
 
 // No handler defined for FTM0
 // No handler defined for FTM1
@@ -1053,6 +1053,138 @@ class FtmBasicInfo : public FtmCommonInfo {
 
 public:
 
+   //! Common class based callback code has been generated for this class of peripheral
+   // (_BasicInfoIrqGuard)
+   static constexpr bool irqHandlerInstalled = true;
+   
+   /**
+    * Type definition for FTM timer overflow interrupt call back.
+    */
+   typedef void (*CallbackFunction)();
+   
+   /**
+    * Type definition for FTM channel interrupt call back.
+    *
+    * @param status Flags indicating interrupt source channel(s)
+    */
+   typedef void (*ChannelCallbackFunction)(uint8_t status);
+   
+   /**
+    * Callback to catch unhandled channel interrupt
+    */
+   static void unhandledChannelCallback(uint8_t) {
+      setAndCheckErrorCode(E_NO_HANDLER);
+   }
+   
+   /**
+    * Class used to do initialisation of a Ftm channel
+    *
+    * This class has a templated constructor that accepts various values:
+    *
+    * @note This constructor may be used to create a const instance in ROM
+    *
+    * Example:
+    * @code
+    * // Initialisation values for Ftm channel
+    * static const Ftm0::ChannelInit channelInit {
+    *       FtmChannelNum_1,
+    *
+    *       FtmChannelMode_InputCaptureEitherEdge , // Channel Mode - Input Capture Either-edge
+    *       FtmChannelAction_Dma ,                  // Action on Channel Event - DMA request
+    * };
+    *
+    * // Initialise Ftm channel from values specified above
+    * Ftm0::configure(channelInit)
+    * @endcode
+    */
+   class ChannelInit {
+   
+   private:
+      /**
+       * Prevent implicit parameter conversions
+       */
+      template <typename... Types>
+      ChannelInit(Types...) = delete;
+   
+   public:
+      /**
+       * Copy Constructor
+       */
+      constexpr ChannelInit(const ChannelInit &other) = default;
+   
+      /**
+       * Default Constructor
+       */
+      constexpr ChannelInit() = default;
+   
+      // Channel Mode (ftm_cnsc_mode_independent[0])
+      // Action on Channel Event (ftm_cnsc_action_independent[0])
+      uint16_t cnsc = 0;
+
+      // Channel Value (ftm_cnv)
+      uint16_t cnv = 0;
+
+      // Ftm Channel Number (ftm_channel_number)
+      FtmChannelNum channelnumber = FtmChannelNum_None;
+
+      /**
+       * Constructor for Ftm Channel Number
+       *
+       * @tparam   Types
+       * @param    rest
+       *
+       * @param ftmChannelNum Selected FTM channel
+       */
+      template <typename... Types>
+      constexpr ChannelInit(FtmChannelNum ftmChannelNum, Types... rest) : ChannelInit(rest...) {
+   
+         channelnumber = ftmChannelNum;
+      }
+   
+      /**
+       * Constructor for Channel Mode
+       *
+       * @tparam   Types
+       * @param    rest
+       *
+       * @param ftmChannelMode Determines channel operation (PWM/Input capture/Output compare)
+       */
+      template <typename... Types>
+      constexpr ChannelInit(FtmChannelMode ftmChannelMode, Types... rest) : ChannelInit(rest...) {
+   
+         cnsc = (cnsc&~(FTM_CnSC_MS_MASK|FTM_CnSC_ELS_MASK)) | ftmChannelMode;
+      }
+   
+      /**
+       * Constructor for Action on Channel Event
+       *
+       * @tparam   Types
+       * @param    rest
+       *
+       * @param ftmChannelAction Enable interrupt or DMA on channel event
+       */
+      template <typename... Types>
+      constexpr ChannelInit(FtmChannelAction ftmChannelAction, Types... rest) : ChannelInit(rest...) {
+   
+         cnsc = (cnsc&~(FTM_CnSC_CHIE_MASK|FTM_CnSC_DMA_MASK)) | ftmChannelAction;
+      }
+   
+      /**
+       * Constructor for Channel Value
+       *
+       * @tparam   Types
+       * @param    rest
+       *
+       * @param ticks Initial value for channel compare register
+       */
+      template <typename... Types>
+      constexpr ChannelInit(const Ticks& ticks, Types... rest) : ChannelInit(rest...) {
+   
+         cnv = uint16_t(ticks);
+      }
+   
+   };// class FtmBasicInfo::ChannelInit
+   
 }; // class FtmBasicInfo 
 
 class Ftm0Info : public FtmBasicInfo {
@@ -1067,7 +1199,7 @@ public:
 
          //      Signal                 Pin                                  PinIndex                PCR value
          /*   0: FTM0_CH0             = --                             */  { PinIndex::UNMAPPED_PCR, PcrValue(0)         },
-         /*   1: FTM0_CH1             = --                             */  { PinIndex::UNMAPPED_PCR, PcrValue(0)         },
+         /*   1: FTM0_CH1             = PTA4(p21)                      */  { PinIndex::PTA4,         PcrValue(0x00300UL) },
          /*   2: FTM0_CH2             = --                             */  { PinIndex::UNMAPPED_PCR, PcrValue(0)         },
          /*   3: FTM0_CH3             = --                             */  { PinIndex::UNMAPPED_PCR, PcrValue(0)         },
          /*   4: FTM0_CH4             = --                             */  { PinIndex::UNMAPPED_PCR, PcrValue(0)         },
@@ -1084,6 +1216,8 @@ public:
     * @note Only the lower 16-bits of the PCR registers are affected
     */
    static void initPCRs() {
+      enablePortClocks(USBDM::PORTA_CLOCK_MASK);
+      PORTA->GPCLR = (0x0300UL|PORT_GPCLR_GPWE(0x0010UL));
    }
 
    /**
@@ -1092,6 +1226,8 @@ public:
     * @note Only the lower 16-bits of the PCR registers are affected
     */
    static void clearPCRs() {
+      enablePortClocks(USBDM::PORTA_CLOCK_MASK);
+      PORTA->GPCLR = uint32_t(PinMux_Disabled)|PORT_GPCLR_GPWE(0x0010UL);
    }
 
    class InfoFAULT {
@@ -1230,6 +1366,145 @@ public:
    // Minimum usable interval in ticks
    static constexpr uint32_t minimumInterval  = 20;
 
+   /**
+    * Basic enable of Ftm0
+    * Includes enabling clock and configuring all mapped pins if mapPinsOnEnable is selected in configuration
+    */
+   static void enable() {
+      enableClock();
+      configureAllPins();
+   }
+   
+   //! Class based interrupt code has been generated for this class of peripheral
+   // (_BasicInfoIrqGuard)
+   static constexpr bool irqHandlerInstalled = true;
+   
+   //! Channel events share a single callback
+   static constexpr bool individualChannelCallbacks = false;
+   
+   /** Callback function for timer overflow */
+   static inline CallbackFunction sToiCallback = unhandledCallback;
+   
+   /** Callback function for channel events */
+   static inline ChannelCallbackFunction sChannelCallback = unhandledChannelCallback;
+   
+   /**
+    * Set timer overflow callback function.
+    *
+    * @param[in] callback Callback function to execute on timer overflow interrupt.
+    *                     Use nullptr to remove callback.
+    */
+   static void setTimerOverflowCallback(CallbackFunction callback) {
+      if (callback == nullptr) {
+         callback = unhandledCallback;
+      }
+      usbdm_assert(
+            (sToiCallback == unhandledCallback) ||
+            (sToiCallback == callback) ||
+            (callback == unhandledCallback),
+            "Handler already set");
+      sToiCallback = callback;
+   }
+   
+   /**
+    * Set channel event callback function.
+    *
+    * @param[in] callback Callback function to execute on channel event interrupt.
+    *                     Use nullptr to remove callback.
+    *
+    * @note Channel callbacks are shared by all channels of the timer.\n
+    *       It is necessary to identify the originating channel in the callback
+    */
+   static void setChannelCallback(ChannelCallbackFunction callback) {
+      if (callback == nullptr) {
+         callback = unhandledChannelCallback;
+      }
+      usbdm_assert(
+            (sChannelCallback == unhandledChannelCallback) ||
+            (sChannelCallback == callback) ||
+            (callback == unhandledChannelCallback),
+            "Handler already set");
+      sChannelCallback = callback;
+   }
+   
+   /**
+    * FTM interrupt handler - Calls FTM callbacks
+    *
+    * @note Flags of channels configured for DMA are left for the DMA controller to clear
+    */
+   static void irqHandler() {
+   
+      const uint32_t sc = ftm->SC;
+      if ((sc&(FTM_SC_TOIE_MASK|FTM_SC_TOF_MASK)) == (FTM_SC_TOIE_MASK|FTM_SC_TOF_MASK)) {
+         // Clear TOI flag (read & w0c)
+         ftm->SC = sc & ~FTM_SC_TOF_MASK;
+         sToiCallback();
+      }
+   
+      // Channels raising interrupts rather than DMA requests
+      uint8_t interruptChannels = 0;
+      for (unsigned channel=0; channel<NumChannels; channel++) {
+         if ((ftm->CONTROLS[channel].CnSC&(FTM_CnSC_CHIE_MASK|FTM_CnSC_DMA_MASK)) == FTM_CnSC_CHIE_MASK) {
+            interruptChannels |= (1<<channel);
+         }
+      }
+      const uint8_t status = ftm->STATUS & interruptChannels;
+      if (status != 0) {
+         // Clear flags for channel events being handled (w0c register if read as 1)
+         ftm->STATUS = ~status;
+         sChannelCallback(status);
+      }
+   }
+   
+   /**
+    * Configure FTM channel from values specified in init
+    * This version allows the channel number to be explicitly given to allow
+    * sharing of an init class for channels requiring the same configuration.
+    *
+    * @param channelNum Number of channel to initialise
+    * @param init       Class containing initialisation values (channel number is ignored)
+    *
+    * @note This method has the side-effect of clearing the register update synchronisation i.e.
+    *       pending CnV register updates are discarded.
+    */
+   static void configure(FtmChannelNum channelNum, const ChannelInit &init) {
+   
+      if (channelNum>=NumChannels) {
+         // Illegal FTM channel number
+         __BKPT();
+         return;
+      }
+      ftm->CONTROLS[channelNum].CnSC = init.cnsc;
+      ftm->CONTROLS[channelNum].CnV  = init.cnv;
+   }
+   
+   /**
+    * Configure FTM channel from values specified in init.
+    *
+    * @param init Class containing initialisation values
+    */
+   static void configure(const ChannelInit &init) {
+      configure(init.channelnumber, init);
+   }
+   
+   /**
+    * Default initialisation values for FTM channels
+    * This value is created from Configure.usbdmProject settings
+    */
+   static constexpr ChannelInit DefaultChannelInitValues[] = {
+      { FtmChannelNum_0, FtmChannelMode_Disabled, },
+      { FtmChannelNum_1,
+        FtmChannelMode_InputCaptureEitherEdge , // (ftm_cnsc_mode_independent[1])   Channel Mode - Input Capture Either-edge
+        FtmChannelAction_Dma ,                  // (ftm_cnsc_action_independent[1]) Action on Channel Event - DMA request
+      },
+      { FtmChannelNum_2, FtmChannelMode_Disabled, },
+      { FtmChannelNum_3, FtmChannelMode_Disabled, },
+      { FtmChannelNum_4, FtmChannelMode_Disabled, },
+      { FtmChannelNum_5, FtmChannelMode_Disabled, },
+      { FtmChannelNum_6, FtmChannelMode_Disabled, },
+      { FtmChannelNum_7, FtmChannelMode_Disabled, },
+   }; // DefaultChannelInitValues
+
    /**
     * Enables/disable external trigger generation by a channel comparison or initialisation event
     *
@@ -4308,6 +4583,11 @@ public:
 
 };
 
+/**
+ * Class representing FTM0
+ */
+class Ftm0 : public FtmBase_T<Ftm0Info> {};
+
 #ifdef FTM_QDCTRL_QUADEN_MASK
 
 /**
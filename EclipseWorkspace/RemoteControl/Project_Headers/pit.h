@@ -19,7 +19,7 @@
 #include "derivative.h"
 #include "system.h"
 #include "pin_mapping.h"
-#if false // (/DMA/_BasicInfoGuard)
+#if true // (/DMA/_BasicInfoGuard)
 #include "dma.h"
 #endif
 
@@ -56,6 +56,7 @@ namespace USBDM {
       PitChannelNum_ButtonTimerChannel   = 0,           ///< Channel 0
       PitChannelNum_Pit_ch0              = 0,           ///< Pin PIT_CH0
       PitChannelNum_1                    = 1,           ///< Channel 1
+      PitChannelNum_IrDelayChannel       = 1,           ///< Channel 1
       PitChannelNum_Pit_ch1              = 1,           ///< Pin PIT_CH1
       PitChannelNum_2                    = 2,           ///< Channel 2
       PitChannelNum_Pit_ch2              = 2,           ///< Pin PIT_CH2
@@ -821,7 +822,7 @@ public:
       return (PitChannelNum) channelNum;
    }
 
-#if false // (/DMA/_BasicInfoGuard)
+#if true // (/DMA/_BasicInfoGuard)
    /**
     * Allocate PIT channel associated with DMA channel.
     * This is a channel that may be used to throttle the associated DMA channel.
@@ -6,9 +6,17 @@
 
 #include "hardware.h"
 #include "../Project_Headers/cmt.h"
+#include "../Project_Headers/dma.h"
+#include "../Project_Headers/smc.h"
+#include "ir-timing.h"
 
 namespace USBDM {
 
+/**
+ * Type definition for call-back on completion of an IR transmission (including delay)
+ */
+typedef void (*CallbackFunction)();
+
 /**
  * Class to wrap CMT hardware for Interval based IR code protocols e.g. NEC, Laser, Samsung etc
  */
@@ -54,11 +62,22 @@ protected:
       return (device<<24)|(subDevice<<16)|(function<<8)|(0x00<<0);
    }
 
+   /**
+    * Report error in protocol sequence.
+    * This is not constexpr so reaching it during compilation reports an error.
+    *
+    * @param message Description of error
+    */
+   static void sequenceError(const char *message) {
+      (void)message;
+   }
+
    enum Control : uint16_t {
       c_Nop            = 0,
       c_Begin          = 0b0001'0000'0000'0000U,
       c_Delay          = 0b0010'0000'0000'0000U,
       c_Duration       = 0b0011'0000'0000'0000U,
+      c_DataBuffer     = 0b0100'0000'0000'0000U,
       c_MarkSpace      = 0b0101'0000'0000'0000U,
       c_Data           = 0b0110'0000'0000'0000U,
       c_DataLiteral    = 0b0111'0000'0000'0000U,
@@ -75,6 +94,8 @@ protected:
    static constexpr Control c_Value8Mask     = Control(0b0000'0000'1111'1111U);
    static constexpr Control c_Value12Mask    = Control(0b0000'1111'1111'1111U);
    static constexpr Control c_Length4Mask    = Control(0b0000'1111'0000'0000U);
+   static constexpr Control c_Length11Mask   = Control(0b0000'0111'1111'1111U);
+   static constexpr Control c_MsbFirstMask   = Control(0b0000'1000'0000'0000U);
 
    static constexpr Control Data1(uint8_t length) {
       return Control(unsigned(c_Data)|(length<<2)|0);
@@ -84,34 +105,137 @@ protected:
       return Control(unsigned(c_Data)|(length<<2)|1);
    }
 
-   static constexpr Control DataSony() {
-      return Control(unsigned(c_Data)|(0xFF<<2)|0);
-   }
-
    static constexpr unsigned extractDataIndex(Control control) {
        return unsigned(control)&0b1;
     }
 
-   static constexpr unsigned extractDataLength(Control control, uint32_t txData) {
+   static constexpr unsigned extractDataLength(Control control) {
+       return (unsigned(control)>>2)&0xFF;
+    }
 
-       unsigned length = (unsigned(control)>>2)&0xFF;
+   /**
+    * Protocol sequence for one frame length of a protocol with variant frame lengths e.g. Sony 12/15/20.
+    *
+    * Each variant is a sequence specialised at compile time so the frame length is a constant
+    * in the sequence. The variant is selected from the length bits of the code when the
+    * transmission is queued rather than while it is being transmitted.
+    */
+   struct FrameVariant {
+      uint32_t       lengthBits;   ///< Value of the length bits of a code using this variant
+      const Control *sequence;     ///< Protocol sequence for this frame length
+   };
 
-       if (length==0xFF) {
-          switch(txData&SONY_LENGTH_MASK) {
-             case SONY_LENGTH_12: length = 12; break;
-             case SONY_LENGTH_15: length = 15; break;
-             case SONY_LENGTH_20: length = 20; break;
-             default: usbdm_assert(false, "Illegal length for Sony protocol"); break;
-          }
-       }
-       return length;
-    }
+   /**
+    * Select the protocol sequence for a code from the variants of a protocol
+    *
+    * @param variants    Variants of protocol
+    * @param lengthMask  Mask for length bits in code
+    * @param code        Code to send
+    *
+    * @return Protocol sequence or nullptr if the length bits are not valid
+    */
+   template<unsigned N>
+   static constexpr const Control *selectVariant(const FrameVariant (&variants)[N], uint32_t lengthMask, uint32_t code) {
+      for (const FrameVariant &variant : variants) {
+         if ((code&lengthMask) == variant.lengthBits) {
+            return variant.sequence;
+         }
+      }
+      return nullptr;
+   }
+
+   /**
+    * Report a code with invalid length bits.
+    * This is not constexpr so reaching it during compilation reports an error.
+    */
+   static void invalidFrameLength() {
+   }
+
+   /**
+    * Select the protocol sequence for a code from the variants of a protocol at compile time.
+    * A code with invalid length bits causes a compile error at the call to invalidFrameLength().
+    *
+    * @param variants    Variants of protocol
+    * @param lengthMask  Mask for length bits in code
+    * @param code        Code to send
+    *
+    * @return Protocol sequence
+    */
+   template<unsigned N>
+   static constexpr const Control *requireVariant(const FrameVariant (&variants)[N], uint32_t lengthMask, uint32_t code) {
+      const Control *sequence = selectVariant(variants, lengthMask, code);
+      if (sequence == nullptr) {
+         invalidFrameLength();
+      }
+      return sequence;
+   }
+
+   /**
+    * Bit-field taken from the payload buffer.
+    * Fields are packed LSB first in the buffer (bit n is in byte n/8, bit n%8).
+    * Each field starts where the previous field ended. The position returns to the
+    * start of the buffer at the start of each repeat.
+    *
+    * @param length     Length of field in bits (1-2047)
+    * @param msbFirst   Transmit the field MSB first
+    */
+   static constexpr Control DataBuffer(unsigned length, bool msbFirst=false) {
+      return Control(unsigned(c_DataBuffer)|(msbFirst?c_MsbFirstMask:0)|(length&c_Length11Mask));
+   }
+
+   static constexpr unsigned extractDataBufferLength(Control control) {
+      return unsigned(control)&c_Length11Mask;
+   }
 
-   static constexpr Control Value(uint16_t data) {
+   static constexpr Control Value(uint32_t data) {
+      if (data > 0xFFFF) {
+         sequenceError("Value too large for 16 bits");
+      }
       return Control(data);
    }
 
+   /**
+    * Drive strength of the IR LED pin
+    */
+   enum CarrierDrive : uint8_t {
+      CarrierDrive_Low,    ///< Low drive strength i.e. reduced LED current
+      CarrierDrive_High,   ///< High drive strength
+   };
+
+   static constexpr Control c_CarrierDutyMask  = Control(0b0000'0000'0111'1111U);
+   static constexpr Control c_CarrierDriveMask = Control(0b0000'0000'1000'0000U);
+
+   /**
+    * Carrier profile in sequence header.
+    * The LED current is proportional to the duty cycle (carrier high time) and depends on the drive strength.
+    * Each protocol sets its own profile. A protocol keeps 50% duty until its receivers have been
+    * verified to decode at a lower duty cycle.
+    *
+    * @param dutyPercent   Carrier duty cycle (10-50%)
+    * @param drive         Drive strength of IR LED pin
+    */
+   static constexpr Control Carrier(unsigned dutyPercent, CarrierDrive drive) {
+      if ((dutyPercent < 10) || (dutyPercent > 50)) {
+         sequenceError("Carrier duty cycle must be 10-50%");
+      }
+      return Control(dutyPercent|((drive == CarrierDrive_High)?c_CarrierDriveMask:0));
+   }
+
+   static constexpr unsigned extractCarrierDuty(Control control) {
+      return unsigned(control)&c_CarrierDutyMask;
+   }
+
+   static constexpr CarrierDrive extractCarrierDrive(Control control) {
+      return (control&c_CarrierDriveMask)?CarrierDrive_High:CarrierDrive_Low;
+   }
+
+   /// Carrier profile used for codes without a profile e.g. Pronto codes
+   static constexpr Control CARRIER_FULL = Control(50|c_CarrierDriveMask);
+
    static constexpr Control DurationHigh(uint32_t data) {
+      if (data >= (1U<<28)) {
+         sequenceError("Duration too large for 28 bits");
+      }
       return Control(c_Duration|((data>>16)&c_Value12Mask));
    }
 
@@ -120,6 +244,9 @@ protected:
    }
 
    static constexpr Control DelayHigh(uint32_t data) {
+      if (data >= (1U<<28)) {
+         sequenceError("Delay too large for 28 bits");
+      }
       return Control(c_Delay|((data>>16)&c_Value12Mask));
    }
 
@@ -167,279 +294,1821 @@ protected:
       return unsigned(control)&c_Value8Mask;
    }
 
+   /**
+    * Check a protocol sequence at compile time.
+    *
+    * The checks done here are not repeated while the sequence is interpreted (in the CMT interrupt handler):
+    *  - Label/Loop, Label/FixedLoop and Repeat/Label are balanced and not nested on the same label
+    *  - A Repeat finds its matching Label i.e. no value within the repeated block looks like the Label
+    *  - Fixed loop counts and data lengths are not zero
+    *  - Each Duration exceeds the longest time that can have elapsed since the start of the epoch.
+    *    A Duration within a repeated block must follow c_Epoch_Start within the block.
+    *
+    * Values are checked to fit in 16 bits by Value() etc. when the sequence is constructed.
+    * An invalid sequence causes a compile error at the call to sequenceError().
+    *
+    * @param sequence Protocol sequence to check
+    *
+    * @return true (Sequence is valid)
+    */
+   static consteval bool checkSequence(const Control *sequence) {
+
+      // State of each loop label
+      enum LabelState {
+         LabelState_Free,     // Not in use
+         LabelState_Loop,     // Label seen - Waiting for Loop or FixedLoop
+         LabelState_Repeat,   // Repeat seen - Waiting for Label
+      };
+      LabelState labelStates[4] = {};
+      uint64_t   labelTimes[4]  = {};     // Elapsed time at start of block
+      bool       epochStarts[4] = {};     // c_Epoch_Start seen within block
 
-private:
+      // Longest elapsed time since start of epoch (us)
+      uint64_t elapsed   = 0;
 
-   inline static Control const *sequence;
-   inline static Control const *startOfSequence;
-   inline static Control current;
+      // Elapsed time depends on number of repeats
+      bool     unbounded = false;
 
-   inline static unsigned dataCount;
-   inline static uint32_t dataBitMask;
-   inline static uint32_t data[2];
-   inline static uint32_t txData;
+      if (sequence[0] == 0) {
+         sequenceError("Carrier frequency missing");
+      }
+      if (extractCarrierDuty(sequence[1]) == 0) {
+         sequenceError("Carrier profile missing");
+      }
+      if ((sequence[2] == 0) || (sequence[4] == 0)) {
+         sequenceError("Bit mark period is zero");
+      }
+      const uint64_t zeroBit    = sequence[2]+sequence[3];
+      const uint64_t oneBit     = sequence[4]+sequence[5];
+      const uint64_t longestBit = (zeroBit>oneBit)?zeroBit:oneBit;
+
+      /**
+       * Check value is not mistaken for a label closing an enclosing Repeat
+       */
+      auto checkValue = [&](Control value) {
+         for (unsigned index=0; index<4; index++) {
+            if ((labelStates[index] == LabelState_Repeat) && (value == Label(index))) {
+               sequenceError("Value within Repeat block matches closing Label");
+            }
+         }
+      };
 
-   inline static uint16_t ZeroHigh;
-   inline static uint16_t ZeroLow;
-   inline static uint16_t OneHigh;
-   inline static uint16_t OneLow;
+      for (const Control *control=sequence+6;; control++) {
+         Control  current = *control;
+         unsigned index   = extractLabelIndex(current);
+         switch(Control(current&c_ControlMask)) {
 
-   inline static unsigned eventCount;
-   inline static Ticks    tickCount;
-   inline static Ticks    duration;
+            case c_MarkSpace:
+               checkValue(control[1]);
+               checkValue(control[2]);
+               elapsed += control[1]+control[2];
+               control += 2;
+               break;
 
-   inline static Control const *labels[4]    = {nullptr,nullptr,nullptr,nullptr,};
-   inline static uint8_t       loopCounts[4] = {0,0,0,0,};
+            case c_DataLiteral:
+               if ((extractDataLiteralLength(current) == 0) || (extractDataLiteralLength(current) > 32)) {
+                  sequenceError("Illegal literal data length");
+               }
+               checkValue(control[1]);
+               checkValue(control[2]);
+               elapsed += extractDataLiteralLength(current)*longestBit;
+               control += 2;
+               break;
 
-   inline static uint8_t repeatCount;
+            case c_Data:
+               if ((extractDataLength(current) == 0) || (extractDataLength(current) > 32)) {
+                  sequenceError("Illegal data length");
+               }
+               elapsed += extractDataLength(current)*longestBit;
+               break;
+
+            case c_DataBuffer:
+               if (extractDataBufferLength(current) == 0) {
+                  sequenceError("Illegal bit-field length");
+               }
+               elapsed += extractDataBufferLength(current)*longestBit;
+               break;
+
+            case c_Delay:
+               checkValue(control[1]);
+               elapsed += ((current&c_Value12Mask)<<16)+control[1];
+               control += 1;
+               break;
+
+            case c_Duration: {
+               checkValue(control[1]);
+               uint64_t duration = ((current&c_Value12Mask)<<16)+control[1];
+               for (unsigned label=0; label<4; label++) {
+                  if ((labelStates[label] != LabelState_Free) && !epochStarts[label]) {
+                     sequenceError("Duration within repeated block needs c_Epoch_Start");
+                  }
+               }
+               if (unbounded) {
+                  sequenceError("Duration follows a variable number of repeats");
+               }
+               if (duration <= elapsed) {
+                  sequenceError("Duration < elapsed time");
+               }
+               elapsed  = duration;
+               control += 1;
+               break;
+            }
+
+            case c_Epoch_Start:
+               elapsed   = 0;
+               unbounded = false;
+               for (bool &epochStart : epochStarts) {
+                  epochStart = true;
+               }
+               break;
+
+            case c_Label:
+               if (labelStates[index] == LabelState_Repeat) {
+                  // End of Repeat block
+                  labelStates[index] = LabelState_Free;
+                  unbounded          = unbounded || (elapsed > labelTimes[index]);
+               }
+               else if (labelStates[index] == LabelState_Free) {
+                  // Start of Loop or FixedLoop block
+                  labelStates[index] = LabelState_Loop;
+                  labelTimes[index]  = elapsed;
+                  epochStarts[index] = false;
+               }
+               else {
+                  sequenceError("Label already in use");
+               }
+               break;
+
+            case c_Loop:
+               if (labelStates[index] != LabelState_Loop) {
+                  sequenceError("Loop without Label");
+               }
+               labelStates[index] = LabelState_Free;
+               unbounded          = unbounded || (elapsed > labelTimes[index]);
+               break;
+
+            case c_LoopFixed:
+               if (labelStates[index] != LabelState_Loop) {
+                  sequenceError("FixedLoop without Label");
+               }
+               if (extractFixedLoopCount(current) == 0) {
+                  sequenceError("FixedLoop count is zero");
+               }
+               labelStates[index] = LabelState_Free;
+               if (elapsed >= labelTimes[index]) {
+                  elapsed = labelTimes[index]+(elapsed-labelTimes[index])*extractFixedLoopCount(current);
+               }
+               break;
 
-   inline static bool complete = true;
+            case c_Repeat:
+               if (labelStates[index] != LabelState_Free) {
+                  sequenceError("Label already in use");
+               }
+               labelStates[index] = LabelState_Repeat;
+               labelTimes[index]  = elapsed;
+               epochStarts[index] = false;
+               break;
+
+            case c_End:
+               for (LabelState labelState : labelStates) {
+                  if (labelState != LabelState_Free) {
+                     sequenceError("Unbalanced Label, Loop or Repeat");
+                  }
+               }
+               return true;
+
+            default:
+               sequenceError("Illegal control");
+               return false;
+         }
+      }
+   }
 
    /**
-    * Callback from CMT.
+    * Source of bit-field values in sequences compiled from IRP
+    */
+   enum IrpFields : uint8_t {
+      IrpFields_DataItems,  ///< Bit-fields are taken from the two 32-bit data items (Data1, Data2)
+      IrpFields_Payload,    ///< Bit-fields are taken in order from a payload buffer of any length
+   };
+
+   /**
+    * Compiler for protocol descriptions in IRP notation.
     *
-    * This processes each timing interval of the transmission.
+    * This translates an IRP string into a protocol sequence at compile time e.g.
+    *    {38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*
+    *
+    * The following subset is supported (no spaces):
+    *  - General spec {frequency k,unit[u][,duty%][,lsb|,msb]}. MSB first is only supported for payload bit-fields.
+    *    The duty cycle defaults to 50%
+    *  - Bit spec <a,-b|c,-d> i.e. a single mark and space for each symbol
+    *  - Bare IR streams (...) optionally followed by '*' or '+' to repeat the stream.
+    *    Only one stream may be repeated. The repeat count is provided when the sequence is sent.
+    *  - Durations n (mark), -n (space) and ^n (extent) in units or with 'u' or 'm' suffix
+    *  - Bit-fields name:length, ~name:length or (expression):length.
+    *    Consecutive bit-fields are sent from a single data item (Data1 and then Data2)
+    *    so the code must contain the fields already combined e.g. F and ~F
+    *  - Literal bit-fields value:length (length <= 8)
+    *  - Bit-fields with negative length e.g. F:-8 are sent in reverse order (payload bit-fields only)
+    *
+    * With IrpFields_Payload each non-literal bit-field is taken in turn from a payload buffer
+    * (see DataBuffer()). The field names and expressions only document the contents of the buffer.
+    *
+    * An invalid IRP string causes a compile error at the call to error().
     */
-   static void cmtCallback() {
+   class IrpCompiler {
+
+   private:
+      const char *irp;          ///< Current position in IRP string
+      Control    *output;       ///< Sequence being generated (nullptr => size only)
+      unsigned    size;         ///< Size of generated sequence
+      unsigned    unit;         ///< Unit for durations (us)
+      unsigned    mark;         ///< Mark not yet generated (us), 0 => none
+      unsigned    dataLength;   ///< Length of bit-fields not yet generated
+      unsigned    dataIndex;    ///< Index of next data item to use
+      bool        firstStream;  ///< Compiling first IR stream
+      bool        repeatUsed;   ///< A repeated IR stream has been compiled
+      IrpFields   fields;       ///< Source of bit-field values
+      bool        msbFirst;     ///< Bit-fields are sent MSB first
+      CarrierDrive drive;       ///< Drive strength of IR LED pin
+
+      /**
+       * Report error in IRP string.
+       * This is not constexpr so reaching it during compilation reports an error.
+       *
+       * @param message Description of error
+       */
+      static void error(const char *message) {
+         (void)message;
+      }
 
-//      DebugLed::on();
-      eventCount++;
+      static constexpr bool isDigit(char ch) {
+         return (ch>='0') && (ch<='9');
+      }
 
-      if (Cmt::getEndOfCycleFlag()) {
-         // Clear CMT flag if origin
-         Cmt::clearEndOfCycleFlag();
+      static constexpr bool isAlpha(char ch) {
+         return ((ch>='a') && (ch<='z')) || ((ch>='A') && (ch<='Z')) || (ch == '_');
       }
 
-      // Process events until one generating a call-back
-      for(;;) {
-         uint8_t loopIndex;
-         Control action = Control(current&c_ControlMask);
-         switch(action) {
+      constexpr void emit(Control control) {
+         if (output != nullptr) {
+            output[size] = control;
+         }
+         size++;
+      }
 
-            case c_Label:
-               loopIndex = extractLabelIndex(current); //uint8_t(current)&0b11;
+      constexpr void expect(char ch, const char *message) {
+         if (*irp != ch) {
+            error(message);
+         }
+         irp++;
+      }
 
-               if (labels[loopIndex] != nullptr) {
-                  // Repeat-label loop
+      constexpr unsigned number() {
+         if (!isDigit(*irp)) {
+            error("IRP: Number expected");
+         }
+         unsigned value = 0;
+         while (isDigit(*irp)) {
+            value = 10*value + (*irp++ - '0');
+         }
+         return value;
+      }
 
-                  // Go back to Repeat
-                  sequence = labels[loopIndex];
+      /**
+       * Parse duration in units, microseconds (u suffix) or milliseconds (m suffix)
+       *
+       * @return Duration in us
+       */
+      constexpr unsigned duration() {
+         unsigned value = number();
+         if (*irp == 'm') {
+            irp++;
+            return 1000*value;
+         }
+         if (*irp == 'u') {
+            irp++;
+            return value;
+         }
+         return unit*value;
+      }
 
-                  // Advance sequence
-                  current  = *sequence++;
-               }
-               else {
-                  // Label-Loop or Label-FixedLoop
+      constexpr void markSpace(unsigned high, unsigned low) {
+         if ((high > 0xFFFF) || (low > 0xFFFF)) {
+            error("IRP: Mark or space too long");
+         }
+         emit(c_MarkSpace);
+         emit(Value(high));
+         emit(Value(low));
+      }
 
-                  // Zero count indicates new entry to loop for later check by Loop/FixedLoop
-                  loopCounts[loopIndex] = 0;
+      /**
+       * Generate any pending data bit-fields and mark
+       */
+      constexpr void flush() {
+         if (dataLength > 0) {
+            if (dataLength > 32) {
+               error("IRP: Bit-fields exceed 32 bits");
+            }
+            if (dataIndex == 0) {
+               emit(Data1(dataLength));
+            }
+            else if (dataIndex == 1) {
+               emit(Data2(dataLength));
+            }
+            else {
+               error("IRP: Only two data items are available");
+            }
+            dataIndex++;
+            dataLength = 0;
+         }
+         if (mark > 0) {
+            markSpace(mark, 0);
+            mark = 0;
+         }
+      }
 
-                  // Save pointer to _next_ action (loop to after label!)
-                  labels[loopIndex]     = sequence;
+      constexpr void space(unsigned time) {
+         if ((mark > 0) && (time <= 0xFFFF)) {
+            markSpace(mark, time);
+            mark = 0;
+            return;
+         }
+         flush();
+         if (time >= (1U<<28)) {
+            error("IRP: Space too long");
+         }
+         emit(DelayHigh(time));
+         emit(DelayLow(time));
+      }
 
-                  // Advance sequence
-                  current  = *sequence++;
-               }
-               continue;
+      constexpr void extent(unsigned time) {
+         flush();
+         if (time >= (1U<<28)) {
+            error("IRP: Extent too long");
+         }
+         emit(DurationHigh(time));
+         emit(DurationLow(time));
+      }
 
-            case c_LoopFixed:
-               loopIndex = extractLabelIndex(current); //uint8_t(current)&0b11;
+      constexpr void bitField() {
+         bool     literal = isDigit(*irp);
+         unsigned value   = 0;
 
-               if (loopCounts[loopIndex] == 0) {
-                  // First time through loop
-                  loopCounts[loopIndex] = extractFixedLoopCount(current); //uint8_t(current>>2);
+         if (literal) {
+            value = number();
+         }
+         else if (*irp == '(') {
+            // Expression - evaluated when code is constructed
+            unsigned depth = 0;
+            do {
+               if (*irp == '(') {
+                  depth++;
                }
-               if (--loopCounts[loopIndex]>0) {
-                  // Loop sequence
-                  sequence  = labels[loopIndex];
+               else if (*irp == ')') {
+                  depth--;
                }
-               else {
-                  labels[loopIndex] = nullptr;
+               else if (*irp == '\0') {
+                  error("IRP: ')' expected");
                }
-               // Advance sequence
-               current  = *sequence++;
-               continue;
+               irp++;
+            } while (depth > 0);
+         }
+         else {
+            if (*irp == '~') {
+               irp++;
+            }
+            if (!isAlpha(*irp)) {
+               error("IRP: Bit-field expected");
+            }
+            while (isAlpha(*irp) || isDigit(*irp)) {
+               irp++;
+            }
+         }
+         expect(':', "IRP: ':' expected in bit-field");
+         bool reverse = false;
+         if (*irp == '-') {
+            irp++;
+            reverse = true;
+         }
+         unsigned length = number();
+         if (length == 0) {
+            error("IRP: Empty bit-field");
+         }
+         if (reverse && (fields != IrpFields_Payload)) {
+            error("IRP: Reversed bit-fields need IrpFields_Payload");
+         }
+         bool msb = msbFirst != reverse;
 
-            case c_Loop:
-               loopIndex = extractLabelIndex(current); //uint8_t(current)&0b11;
-               if (repeatCount-->0) {
-                  // Loop sequence
-                  sequence  = labels[loopIndex];
+         if (literal) {
+            if (length > 8) {
+               error("IRP: Literal bit-field too long");
+            }
+            if (msb) {
+               // Literals are sent LSB first
+               unsigned reversed = 0;
+               for (unsigned bit=0; bit<length; bit++) {
+                  reversed |= ((value>>bit)&0b1)<<(length-1-bit);
                }
-               // Advance sequence
-               current  = *sequence++;
-               continue;
+               value = reversed;
+            }
+            flush();
+            emit(DataImmediateLength(length));
+            emit(DataImmediateHigh(value));
+            emit(DataImmediateLow(value));
+            return;
+         }
+         if (mark > 0) {
+            markSpace(mark, 0);
+            mark = 0;
+         }
+         if (fields == IrpFields_Payload) {
+            if (length > c_Length11Mask) {
+               error("IRP: Payload bit-field too long");
+            }
+            emit(DataBuffer(length, msb));
+            return;
+         }
+         dataLength += length;
+      }
 
-            case c_Repeat:
-               loopIndex = extractLabelIndex(current); //uint8_t(current)&0b11;
+      constexpr void item() {
+         if (*irp == '-') {
+            irp++;
+            space(duration());
+            return;
+         }
+         if (*irp == '^') {
+            irp++;
+            extent(duration());
+            return;
+         }
+         if (isDigit(*irp)) {
+            const char *p = irp;
+            while (isDigit(*p)) {
+               p++;
+            }
+            if (*p != ':') {
+               // Mark
+               unsigned time = duration();
+               flush();
+               mark = time;
+               return;
+            }
+         }
+         bitField();
+      }
 
-               if (repeatCount--==0) {
-                  // Terminate loop
-                  labels[loopIndex] = nullptr;
-                  do {
-                     // Look for matching label
-                     current = *sequence++;
+      constexpr void stream() {
+         expect('(', "IRP: '(' expected");
 
-                     usbdm_assert(current != c_End, "Fallen off end!");
+         // Look ahead for extent and repeat indicator
+         bool hasExtent = false;
+         const char *p  = irp;
+         for (unsigned depth=1; depth>0; p++) {
+            if (*p == '\0') {
+               error("IRP: ')' expected");
+               return;
+            }
+            if (*p == '(') {
+               depth++;
+            }
+            else if (*p == ')') {
+               depth--;
+            }
+            else if ((*p == '^') && (depth == 1)) {
+               // Extent (not XOR in bit-field expression)
+               hasExtent = true;
+            }
+         }
+         bool repeated = (*p == '*') || (*p == '+');
 
-                  } while(current != Label(loopIndex));
+         if (repeated) {
+            if (repeatUsed) {
+               error("IRP: Only one IR stream may be repeated");
+            }
+            repeatUsed = true;
+            emit(Repeat(0));
+         }
+         if (hasExtent && (repeated || !firstStream)) {
+            // Extents are measured from start of this stream
+            emit(c_Epoch_Start);
+         }
+         firstStream = false;
+
+         for(;;) {
+            item();
+            if (*irp != ',') {
+               break;
+            }
+            irp++;
+         }
+         expect(')', "IRP: ')' expected");
+         flush();
+
+         if (repeated) {
+            irp++;
+            emit(Label(0));
+         }
+      }
+
+   public:
+      /**
+       * Constructor
+       *
+       * @param irp     IRP string to compile
+       * @param output  Buffer for sequence. May be nullptr to determine the size only.
+       * @param fields  Source of bit-field values
+       */
+      constexpr IrpCompiler(const char *irp, Control *output, IrpFields fields=IrpFields_DataItems, CarrierDrive drive=CarrierDrive_High) :
+         irp(irp), output(output), size(0), unit(1), mark(0),
+         dataLength(0), dataIndex(0), firstStream(true), repeatUsed(false),
+         fields(fields), msbFirst(false), drive(drive) {
+      }
+
+      /**
+       * Compile IRP string
+       *
+       * @return Size of protocol sequence
+       */
+      constexpr unsigned compile() {
+
+         // General spec {frequency,unit,duty,order}
+         expect('{', "IRP: '{' expected");
+         unsigned frequency = 1000*number();
+         if (*irp == '.') {
+            irp++;
+            for (unsigned scale=100; isDigit(*irp); scale /= 10) {
+               frequency += scale*(*irp++ - '0');
+            }
+         }
+         expect('k', "IRP: Frequency must be in kHz");
+         expect(',', "IRP: ',' expected");
+         unit = number();
+         if (*irp == 'u') {
+            irp++;
+         }
+         unsigned duty = 50;
+         if ((*irp == ',') && isDigit(irp[1])) {
+            irp++;
+            duty = number();
+            expect('%', "IRP: '%' expected");
+         }
+         if (*irp == ',') {
+            irp++;
+            if ((irp[0] == 'm') && (irp[1] == 's') && (irp[2] == 'b')) {
+               if (fields != IrpFields_Payload) {
+                  error("IRP: MSB first needs IrpFields_Payload");
+               }
+               msbFirst = true;
+            }
+            else if ((irp[0] != 'l') || (irp[1] != 's') || (irp[2] != 'b')) {
+               error("IRP: 'lsb' or 'msb' expected");
+            }
+            irp += 3;
+         }
+         expect('}', "IRP: '}' expected");
+         if (frequency > 0xFFFF) {
+            error("IRP: Frequency too high");
+         }
+         emit(Value(frequency));
+         emit(Carrier(duty, drive));
+
+         // Bit spec <zero-mark,-zero-space|one-mark,-one-space>
+         expect('<', "IRP: '<' expected");
+         unsigned zeroHigh = duration();
+         expect(',', "IRP: ',' expected");
+         expect('-', "IRP: '-' expected");
+         unsigned zeroLow  = duration();
+         expect('|', "IRP: '|' expected");
+         unsigned oneHigh  = duration();
+         expect(',', "IRP: ',' expected");
+         expect('-', "IRP: '-' expected");
+         unsigned oneLow   = duration();
+         expect('>', "IRP: '>' expected");
+
+         emit(Value(zeroHigh));
+         emit(Value(zeroLow));
+         emit(Value(oneHigh));
+         emit(Value(oneLow));
+
+         // IR streams
+         do {
+            stream();
+         } while (*irp == '(');
+
+         if (*irp != '\0') {
+            error("IRP: Unexpected characters at end");
+         }
+         emit(c_End);
+
+         return size;
+      }
+   };
+
+   /**
+    * Protocol sequence compiled from IRP notation
+    *
+    * @tparam N Size of sequence
+    */
+   template<unsigned N>
+   struct CompiledSequence {
+      Control sequence[N];
+   };
+
+   /**
+    * Compile protocol sequence from IRP notation at compile time.
+    * See IrpCompiler for the supported notation.
+    * The compiled sequence is checked by checkSequence().
+    *
+    * @tparam irp     IRP string
+    * @tparam fields  Source of bit-field values
+    * @tparam drive   Drive strength of IR LED pin
+    *
+    * @return Compiled protocol sequence
+    */
+   template<const char *irp, IrpFields fields=IrpFields_DataItems, CarrierDrive drive=CarrierDrive_High>
+   static consteval auto compileIrp() {
+      CompiledSequence<IrpCompiler(irp, nullptr, fields, drive).compile()> compiled{};
+      IrpCompiler(irp, compiled.sequence, fields, drive).compile();
+      checkSequence(compiled.sequence);
+      return compiled;
+   }
+
+
+   /**
+    * Describes a single modulator cycle i.e. a mark followed by a space.
+    * If extended is set the mark period is also transmitted as space (CMT extended space)
+    */
+   struct Interval {
+      uint16_t mark;       ///< Mark period  1_tick = 1us
+      uint16_t space;      ///< Space period 1_tick = 1us
+      bool     extended;   ///< Mark period is replaced by space
+   };
+
+   /**
+    * Interpreter for a protocol sequence.
+    *
+    * This expands the protocol sequence into the individual modulator cycles.
+    * It is used by the CMT call-back and to pre-render transmissions for DMA.
+    */
+   class Interpreter {
+
+   private:
+      Control const *sequence;
+      Control        current;
+
+      unsigned dataCount;
+      uint32_t dataBitMask;
+      uint32_t data[2];
+      uint32_t txData;
+
+      uint16_t ZeroHigh;
+      uint16_t ZeroLow;
+      uint16_t OneHigh;
+      uint16_t OneLow;
+
+      Control  carrier;
+
+      Ticks    tickCount;
+      Ticks    duration;
+
+      Control const *labels[4];
+      uint8_t   loopCounts[4];
+
+      unsigned repeatCount;
+
+      /// Repeat block continues after repeatCount is exhausted until release()
+      bool     holding;
+
+      const uint8_t *payload;  ///< Buffer for DataBuffer bit-fields
+      uint16_t  payloadField;  ///< Bit position of next bit-field in payload
+      uint16_t  payloadBit;    ///< Bit position of next bit in payload
+      int8_t    payloadStep;   ///< Direction through bit-field (+1 => LSB first, -1 => MSB first)
+
+      /**
+       * Get cycle for a data bit
+       *
+       * @param bit       Bit value
+       * @param interval  Cycle for bit
+       */
+      constexpr void sendBit(bool bit, Interval &interval) {
+         if (bit) {
+            interval = {OneHigh, OneLow, false};
+         }
+         else {
+            interval = {ZeroHigh, ZeroLow, false};
+         }
+         tickCount = tickCount + Ticks(interval.mark) + Ticks(interval.space);
+         if (--dataCount == 0) {
+
+            // Advance sequence
+            current = *sequence++;
+         }
+      }
+
+      /**
+       * Get cycle for next data bit
+       *
+       * @param interval  Cycle for bit
+       */
+      constexpr void nextBit(Interval &interval) {
+         sendBit(txData&dataBitMask, interval);
+         dataBitMask <<= 1;
+      }
+
+      /**
+       * Get cycle for next payload bit
+       *
+       * @param interval  Cycle for bit
+       */
+      constexpr void nextPayloadBit(Interval &interval) {
+         sendBit((payload[payloadBit>>3]>>(payloadBit&0b111))&0b1, interval);
+         payloadBit = uint16_t(payloadBit+payloadStep);
+      }
+
+   public:
+      constexpr Interpreter() :
+         sequence(nullptr), current(c_End),
+         dataCount(0), dataBitMask(0), data{0,0}, txData(0),
+         ZeroHigh(0), ZeroLow(0), OneHigh(0), OneLow(0),
+         carrier(CARRIER_FULL),
+         tickCount(0_ticks), duration(0_ticks),
+         labels{nullptr,nullptr,nullptr,nullptr,}, loopCounts{0,0,0,0,},
+         repeatCount(0), holding(false),
+         payload(nullptr), payloadField(0), payloadBit(0), payloadStep(1) {
+      }
+
+      /**
+       * Set up interpreter to expand a protocol sequence
+       *
+       * @param newSequence   Protocol sequence
+       * @param data1         First data item/code
+       * @param data2         Second data item/code
+       * @param repeat        Number of times to repeat (including original).
+       * @param hold          Continue repeating after repeat is exhausted until release()
+       * @param payloadBuffer Buffer for DataBuffer bit-fields (if used by sequence)
+       *
+       * @return Carrier frequency (Hz) from sequence header
+       */
+      constexpr unsigned start(
+            const Control *newSequence,
+            uint32_t       data1,
+            uint32_t       data2,
+            unsigned       repeat,
+            bool           hold=false,
+            const uint8_t *payloadBuffer=nullptr) {
+
+         sequence    = newSequence;
+         data[0]     = data1;
+         data[1]     = data2;
+         repeatCount = repeat;
+         holding     = hold;
+
+         payload      = payloadBuffer;
+         payloadField = 0;
+
+         dataBitMask = 0b1;
+         dataCount   = 0;
+         tickCount   = 0_ticks;
+         duration    = 0_ticks;
+
+         unsigned frequency  = uint16_t(*sequence++);
+         carrier             = *sequence++;
+
+         ZeroHigh  = uint16_t(*sequence++);
+         ZeroLow   = uint16_t(*sequence++);
+         OneHigh   = uint16_t(*sequence++);
+         OneLow    = uint16_t(*sequence++);
+
+         current = *sequence++;
+
+         return frequency;
+      }
+
+      /**
+       * Get carrier profile from sequence header
+       *
+       * @return Carrier profile (see Carrier())
+       */
+      constexpr Control getCarrier() const {
+         return carrier;
+      }
+
+      /**
+       * Stop repeating a held sequence.
+       * The repeat block completes the current frame and then exits as usual
+       * once the requested number of repeats have been sent.
+       */
+      constexpr void release() {
+         holding = false;
+      }
+
+      /**
+       * Cancel remaining repeats.
+       * The current frame completes and the repeat block then exits.
+       */
+      constexpr void cancel() {
+         repeatCount = 0;
+         holding     = false;
+      }
+
+      /**
+       * Indicates if the interpreter is between frames
+       * i.e. the next cycle starts a new repeat of the frame.
+       *
+       * @return true => At frame boundary
+       */
+      constexpr bool isFrameBoundary() const {
+         Control action = Control(current&c_ControlMask);
+         if (action == c_Repeat) {
+            return true;
+         }
+         // Label of an active Repeat-Label loop
+         return (action == c_Label) && (labels[extractLabelIndex(current)] != nullptr);
+      }
+
+      /**
+       * Get next modulator cycle
+       *
+       * @param interval  Cycle to program
+       *
+       * @return true   => interval contains the next cycle
+       * @return false  => sequence complete (last cycle has been returned)
+       */
+      constexpr bool next(Interval &interval) {
+
+         // Process actions until one generating a cycle
+         for(;;) {
+            uint8_t loopIndex;
+            Control action = Control(current&c_ControlMask);
+            switch(action) {
+
+               case c_Label:
+                  loopIndex = extractLabelIndex(current);
+
+                  if (labels[loopIndex] != nullptr) {
+                     // Repeat-label loop
+
+                     // Go back to Repeat
+                     sequence = labels[loopIndex];
+
+                     // Advance sequence
+                     current  = *sequence++;
+                  }
+                  else {
+                     // Label-Loop or Label-FixedLoop
+
+                     // Zero count indicates new entry to loop for later check by Loop/FixedLoop
+                     loopCounts[loopIndex] = 0;
+
+                     // Save pointer to _next_ action (loop to after label!)
+                     labels[loopIndex]     = sequence;
+
+                     // Advance sequence
+                     current  = *sequence++;
+                  }
+                  continue;
+
+               case c_LoopFixed:
+                  loopIndex = extractLabelIndex(current);
+
+                  if (loopCounts[loopIndex] == 0) {
+                     // First time through loop
+                     loopCounts[loopIndex] = extractFixedLoopCount(current);
+                  }
+                  if (--loopCounts[loopIndex]>0) {
+                     // Loop sequence
+                     sequence  = labels[loopIndex];
+                  }
+                  else {
+                     labels[loopIndex] = nullptr;
+                  }
+                  // Advance sequence
+                  current  = *sequence++;
+                  continue;
+
+               case c_Loop:
+                  loopIndex = extractLabelIndex(current);
+                  if ((repeatCount>0) || holding) {
+                     if (repeatCount>0) {
+                        repeatCount--;
+                     }
+                     // Loop sequence
+                     sequence  = labels[loopIndex];
+                  }
+                  // Advance sequence
+                  current  = *sequence++;
+                  continue;
+
+               case c_Repeat:
+                  loopIndex = extractLabelIndex(current);
+
+                  if ((repeatCount==0) && !holding) {
+                     // Terminate loop
+                     labels[loopIndex] = nullptr;
+                     do {
+                        // Look for matching label (presence checked by checkSequence())
+                        current = *sequence++;
+                     } while(current != Label(loopIndex));
+                  }
+                  else {
+                     if (repeatCount>0) {
+                        repeatCount--;
+                     }
+                     // New repeat - Record top of loop sequence
+                     // Points at _this_ code
+                     labels[loopIndex] = sequence-1;
+
+                     // Each repeat sends the payload from the start
+                     payloadField = 0;
+                  }
+                  // Advance sequence
+                  current  = *sequence++;
+                  continue;
+
+               case c_Epoch_Start:
+                  current   = *sequence++;
+                  tickCount = 0_ticks;
+                  continue;
+
+               default:
+                  break;
+            }
+            break;
+         };
+
+         Ticks high, low;
+
+         Control action = Control(current&c_ControlMask);
+         switch(action) {
+
+            case c_MarkSpace:
+               high    = Ticks(*sequence++);
+               low     = Ticks(*sequence++);
+
+               // Advance sequence
+               current = *sequence++;
+
+               interval  = {uint16_t(high), uint16_t(low), false};
+               tickCount = tickCount + high + low;
+               return true;
+
+            case c_DataLiteral:
+               if (dataCount == 0) {
+                  // First time - set up literal data Tx
+                  dataCount   = extractDataLiteralLength(current);
+                  high        = Ticks(*sequence++);
+                  low         = Ticks(*sequence++);
+                  txData      = (high<<16)+low;
+                  dataBitMask = 0b1;
+               }
+               nextBit(interval);
+               return true;
+
+            case  c_Data :
+               if (dataCount == 0) {
+                  // First time - set up data Tx
+                  txData      = data[extractDataIndex(current)];
+                  dataCount   = extractDataLength(current);
+                  dataBitMask = 0b1;
+               }
+               nextBit(interval);
+               return true;
+
+            case c_DataBuffer:
+               if (dataCount == 0) {
+                  // First time - set up bit-field Tx from payload
+                  dataCount = extractDataBufferLength(current);
+                  if (current&c_MsbFirstMask) {
+                     payloadBit  = uint16_t(payloadField+dataCount-1);
+                     payloadStep = -1;
+                  }
+                  else {
+                     payloadBit  = payloadField;
+                     payloadStep = 1;
+                  }
+                  payloadField = uint16_t(payloadField+dataCount);
+               }
+               nextPayloadBit(interval);
+               return true;
+
+            case c_Duration:  // Delay from last reference
+            case c_Delay:     // Absolute delay
+               if (duration == 0) {
+                  // New delay/duration
+                  high     = Ticks(current&c_Value12Mask);
+                  low      = Ticks(*sequence++);
+                  duration = Ticks((high<<16)+low);
+                  if (action == c_Duration) {
+                     // Make relative (duration > tickCount checked by checkSequence())
+                     duration = duration - tickCount;
+                  }
                }
                else {
-                  // New repeat - Record top of loop sequence
-                  // Points at _this_ code
-                  labels[loopIndex] = sequence-1;
+                  // Continuation of current
                }
-               // Advance sequence
-               current  = *sequence++;
-               continue;
 
-            case c_Epoch_Start:
-               current   = *sequence++;
-               tickCount = 0_ticks;
-               break;
+               high = duration;
+               if (high > 2*65000_ticks) {
+                  high = 2*65000_ticks;
+               }
+
+               // Split times
+               low    = Ticks(high/2);
+               high   = high - low;
+
+               interval  = {uint16_t(high), uint16_t(low), true};
+               tickCount = tickCount + high + low;
+
+               duration = duration - high - low;
+               if (duration == 0) {
+                  // Advance sequence as completed this action
+                  current  = *sequence++;
+               }
+               return true;
+
+            case c_End:
+               // Last cycle underway
+
+               // Do a dummy cycle to wait for Tx complete
+               interval = {1, 0, true};
+               current  = c_Cleanup;
+               return true;
+
+            case c_Cleanup:
+               // Dummy cycle underway
+            default:
+               return false;
+         }
+      }
+   };
+
+   /**
+    * Image of the CMT modulator registers for a single cycle.
+    * The layout matches CMT MSC, CMD1, CMD2, CMD3, CMD4 so it may be written by a single DMA minor loop.
+    */
+   struct __attribute__((__packed__)) CmtCycle {
+
+      /// MSC value used for all cycles (Time mode, modulator enabled, end-of-cycle request enabled)
+      static constexpr uint8_t mscValue =
+            uint8_t(CmtEnable_Enabled)|uint8_t(CmtMode_Time)|uint8_t(CmtIntermediatePrescaler_DivBy1)|
+            uint8_t(CMT_MSC_EOCIE_MASK&CmtEndOfCycleAction_DmaTransfer);
+
+      uint8_t msc;   ///< Modulator Status and Control (EXSPC)
+      uint8_t cmd1;  ///< Mark period high byte
+      uint8_t cmd2;  ///< Mark period low byte
+      uint8_t cmd3;  ///< Space period high byte
+      uint8_t cmd4;  ///< Space period low byte
+
+      constexpr CmtCycle() : msc(mscValue), cmd1(0), cmd2(0), cmd3(0), cmd4(0) {
+      }
+
+      /**
+       * Constructor
+       *
+       * @param interval Modulator cycle
+       */
+      constexpr CmtCycle(const Interval &interval) :
+         msc(mscValue|uint8_t(interval.extended?CmtExtendedSpace_Enabled:CmtExtendedSpace_Disabled)),
+         cmd1(uint8_t(interval.mark>>8)),
+         cmd2(uint8_t(interval.mark)),
+         cmd3(uint8_t(interval.space>>8)),
+         cmd4(uint8_t(interval.space)) {
+      }
+   };
+
+   /**
+    * Render the remainder of a transmission into a buffer of modulator cycles
+    *
+    * @param renderer   Interpreter set up with sequence to render (updated)
+    * @param buffer     Buffer for cycles
+    * @param size       Size of buffer
+    *
+    * @return Number of cycles rendered.  0 => buffer too small
+    */
+   static constexpr unsigned renderCycles(Interpreter &renderer, CmtCycle buffer[], unsigned size) {
+      Interval interval;
+      unsigned count = 0;
+      while(renderer.next(interval)) {
+         if (count >= size) {
+            return 0;
+         }
+         buffer[count++] = CmtCycle(interval);
+      }
+      return count;
+   }
+
+   /**
+    * Render the next frame of a transmission into a buffer of modulator cycles.
+    * Rendering stops at the next frame boundary or the end of the transmission.
+    *
+    * @param renderer   Interpreter set up with sequence to render (updated)
+    * @param buffer     Buffer for cycles
+    * @param size       Size of buffer
+    *
+    * @return Number of cycles rendered.  0 => transmission complete or buffer too small
+    */
+   static constexpr unsigned renderFrame(Interpreter &renderer, CmtCycle buffer[], unsigned size) {
+      Interval interval;
+      unsigned count = 0;
+      do {
+         if (!renderer.next(interval)) {
+            break;
+         }
+         if (count >= size) {
+            return 0;
+         }
+         buffer[count++] = CmtCycle(interval);
+      } while (!renderer.isFrameBoundary());
+      return count;
+   }
+
+   /**
+    * Transmission rendered at compile time
+    *
+    * @tparam N Number of modulator cycles
+    */
+   template<unsigned N>
+   struct RenderedSequence {
+      unsigned frequency;   ///< Carrier frequency (Hz)
+      Control  carrier;     ///< Carrier profile (see Carrier())
+      CmtCycle cycles[N];   ///< Modulator cycles including final dummy cycle
+   };
+
+   /**
+    * Estimate the time the IR LED is driven while transmitting marks.
+    * The LED is only driven during the carrier high time.
+    * The charge is this time multiplied by the LED current measured for the drive strength of the profile.
+    *
+    * @param frequency  Carrier frequency (Hz)
+    * @param carrier    Carrier profile (see Carrier())
+    * @param markTime   Total time of transmitted marks (us)
+    *
+    * @return LED on-time (us)
+    */
+   static constexpr uint32_t estimateLedOnTime(unsigned frequency, Control carrier, uint64_t markTime) {
+      Ticks high, low;
+      carrierTiming(frequency, carrier, high, low);
+      return uint32_t((markTime*unsigned(high))/(unsigned(high)+unsigned(low)));
+   }
+
+   /**
+    * Estimate the time the IR LED is driven for a transmission.
+    * The carrier profile of the sequence is used.
+    *
+    * @param sequence   Protocol sequence
+    * @param data1      First data item/code
+    * @param data2      Second data item/code
+    * @param repeat     Number of times to repeat (including original).
+    *
+    * @return LED on-time (us)
+    */
+   static uint32_t estimateLedOnTime(const Control *sequence, uint32_t data1, uint32_t data2, unsigned repeat) {
+      Interpreter renderer;
+      unsigned frequency = renderer.start(sequence, data1, data2, repeat);
+      Interval interval;
+      uint64_t markTime = 0;
+      while(renderer.next(interval)) {
+         if (!interval.extended) {
+            markTime += interval.mark;
+         }
+      }
+      return estimateLedOnTime(frequency, renderer.getCarrier(), markTime);
+   }
+
+   /**
+    * Count the modulator cycles in a transmission
+    *
+    * @param sequence   Protocol sequence
+    * @param data1      First data item/code
+    * @param data2      Second data item/code
+    * @param repeat     Number of times to repeat (including original).
+    *
+    * @return Number of cycles
+    */
+   static constexpr unsigned countCycles(const Control *sequence, uint32_t data1, uint32_t data2, unsigned repeat) {
+      Interpreter renderer;
+      renderer.start(sequence, data1, data2, repeat);
+      Interval interval;
+      unsigned count = 0;
+      while(renderer.next(interval)) {
+         count++;
+      }
+      return count;
+   }
+
+   /**
+    * Render a transmission at compile time.
+    * This expands all loops, repeats and data so the result may be transmitted without interpretation.
+    *
+    * @tparam sequence   Protocol sequence
+    * @tparam data1      First data item/code
+    * @tparam data2      Second data item/code
+    * @tparam repeat     Number of times to repeat (including original).
+    *
+    * @return Rendered transmission
+    */
+   template<const Control *sequence, uint32_t data1, uint32_t data2, unsigned repeat>
+   static constexpr auto renderSequence() {
+      constexpr unsigned size = countCycles(sequence, data1, data2, repeat);
+      RenderedSequence<size> rendered{};
+      Interpreter renderer;
+      rendered.frequency = renderer.start(sequence, data1, data2, repeat);
+      rendered.carrier   = renderer.getCarrier();
+      renderCycles(renderer, rendered.cycles, size);
+      return rendered;
+   }
+
+public:
+   /**
+    * Selects how modulator cycles are provided to the CMT
+    */
+   enum IrTransmitMode {
+      IrTransmitMode_Interrupt,  ///< Each cycle is calculated in the CMT interrupt handler
+      IrTransmitMode_Dma,        ///< Transmission is pre-rendered and cycles are transferred by DMA
+   };
+
+   /// Maximum number of cycles in a DMA transmission frame. Longer frames fall back to interrupt mode.
+   static constexpr unsigned MAX_DMA_CYCLES = 160;
+
+   /// Maximum number of queued IR transmissions
+   static constexpr unsigned JOB_QUEUE_SIZE = 16;
+
+private:
+
+   inline static Control const *sequence;
+   inline static Control const *startOfSequence;
+   inline static Control current;
+
+   inline static unsigned dataCount;
+   inline static uint32_t dataBitMask;
+   inline static uint32_t data[2];
+   inline static uint32_t txData;
+
+   inline static uint16_t ZeroHigh;
+   inline static uint16_t ZeroLow;
+   inline static uint16_t OneHigh;
+   inline static uint16_t OneLow;
+
+   inline static unsigned eventCount;
+   inline static Ticks    tickCount;
+
+   inline static Control const *labels[4]    = {nullptr,nullptr,nullptr,nullptr,};
+   inline static uint8_t       loopCounts[4] = {0,0,0,0,};
+
+   inline static uint8_t repeatCount;
+
+   inline static volatile bool complete = true;
+
+   /// Interpreter for current transmission
+   inline static Interpreter interpreter;
+
+   /// Pre-rendered cycles for current transmission (nullptr => use interpreter)
+   inline static const CmtCycle *txCycles = nullptr;
+
+   /// Number of pre-rendered cycles remaining
+   inline static unsigned txCyclesRemaining = 0;
+
+   /// Pre-rendered cycles are a frame of the interpreted transmission (more frames may follow)
+   inline static bool txStreaming = false;
+
+   /// How cycles are provided to the CMT
+   inline static IrTransmitMode transmitMode = IrTransmitMode_Dma;
+
+   /// DMA channel used for transmission
+   inline static DmaChannelNum dmaChannel = DmaChannelNum_None;
+
+   /// Pre-rendered cycles for DMA transmission
+   inline static CmtCycle dmaCycles[MAX_DMA_CYCLES];
+
+   /// Carrier frequency the CMT is currently configured for (0 => CMT not configured)
+   inline static unsigned configuredFrequency = 0;
+
+   /// Carrier profile the CMT is currently configured for
+   inline static Control configuredCarrier = CARRIER_FULL;
+
+   /// PIT channel used to time delays between transmissions
+   using DelayChannel = IrDelayChannel;
+
+   /**
+    * Queued IR transmission
+    */
+   struct IrJob {
+      const Control    *sequence;    ///< Protocol sequence (nullptr => pre-rendered cycles)
+      const CmtCycle   *cycles;      ///< Pre-rendered cycles
+      unsigned          cycleCount;  ///< Number of pre-rendered cycles
+      unsigned          frequency;   ///< Carrier frequency (Hz)
+      Control           carrier;     ///< Carrier profile (see Carrier())
+      uint32_t          data1;       ///< First data item/code
+      uint32_t          data2;       ///< Second data item/code
+      const uint8_t    *payload;     ///< Payload for DataBuffer bit-fields (must remain valid until transmitted)
+      unsigned          repeat;      ///< Number of times to repeat (including original)
+      unsigned          delay;       ///< Delay at end of transmission 1_tick = 1us
+      CallbackFunction  callback;    ///< Called on completion of transmission and delay
+      bool              hold;        ///< Continue repeating until release()
+      bool              preemptible; ///< May be cut short by cancel()
+   };
+
+   /**
+    * Stage of current job
+    */
+   enum JobPhase : uint8_t {
+      JobPhase_Idle,       ///< No job active
+      JobPhase_Transmit,   ///< Transmitting IR sequence
+      JobPhase_Delay,      ///< Timing delay after transmission
+   };
+
+   /// Queue of IR transmissions. jobQueue[jobHead] is the active job.
+   inline static IrJob jobQueue[JOB_QUEUE_SIZE];
+
+   /// Index of first (active) job in queue
+   inline static unsigned jobHead = 0;
+
+   /// Number of jobs in queue including active job
+   inline static volatile unsigned jobCount = 0;
+
+   /// Stage of active job
+   inline static volatile JobPhase jobPhase = JobPhase_Idle;
+
+   /**
+    * Load modulator registers for next cycle
+    *
+    * @param cycle Cycle to load
+    */
+   static void loadCycle(const CmtCycle &cycle) {
+      IrTiming::programmed(Ticks((cycle.cmd1<<8)|cycle.cmd2), Ticks((cycle.cmd3<<8)|cycle.cmd4));
+      Cmt::setMarkSpacePeriods(Ticks((cycle.cmd1<<8)|cycle.cmd2), Ticks((cycle.cmd3<<8)|cycle.cmd4));
+      Cmt::setExtendedSpace(CmtExtendedSpace(cycle.msc&CMT_MSC_EXSPC_MASK));
+   }
+
+   /**
+    * Callback from CMT.
+    *
+    * This processes each timing interval of the transmission.
+    */
+   static void cmtCallback() {
+
+      IrTiming::IsrTimer isrTimer;
+
+//      DebugLed::on();
+      eventCount++;
+
+      if (Cmt::getEndOfCycleFlag()) {
+         // Clear CMT flag if origin
+         Cmt::clearEndOfCycleFlag();
+      }
+
+      if (txCycles != nullptr) {
+         // Pre-rendered transmission
+         if (txCyclesRemaining > 0) {
+            txCyclesRemaining--;
+            loadCycle(*txCycles++);
+            return;
+         }
+         txCycles = nullptr;
+         if (!txStreaming) {
+            // Dummy cycle underway
+
+            // Disable CMT - It will continue until end of dummy cycle even if CMT stopped
+            Cmt::stop();
+            IrTiming::transmissionStopped();
+            transmissionComplete();
+            return;
+         }
+         // Frame complete - Continue with next frame
+         if (startDmaFrame()) {
+            return;
+         }
+         // Transmission complete or frame too large - Continue with interpreter
+         txStreaming = false;
+      }
+
+      Interval interval;
+      if (interpreter.next(interval)) {
+         IrTiming::programmed(Ticks(interval.mark), Ticks(interval.space));
+         Cmt::setMarkSpacePeriods(Ticks(interval.mark), Ticks(interval.space));
+         Cmt::setExtendedSpace(interval.extended?CmtExtendedSpace_Enabled:CmtExtendedSpace_Disabled);
+      }
+      else {
+         // Dummy cycle underway
+
+         // Disable CMT - It will continue until end of dummy cycle even if CMT stopped
+         Cmt::stop();
+         IrTiming::transmissionStopped();
+         transmissionComplete();
+      }
+
+//      DebugLed::off();
+   }
+
+   /**
+    * Callback from DMA on completion of major loop.
+    *
+    * All cycles apart from the final dummy cycle have been transferred.
+    * The dummy cycle is completed by the CMT call-back as usual.
+    *
+    * @param channel       DMA channel (interrupt flag already cleared)
+    */
+   static void dmaCallback(DmaChannelNum channel) {
+      (void)channel;
+
+      // No cycles remain so next call-back stops the CMT
+      Cmt::setEndOfCycleAction(CmtEndOfCycleAction_Interrupt);
+   }
+
+   /**
+    * Allocate and configure DMA channel for CMT transmission.
+    * The channel is retained for re-use.
+    *
+    * @return E_NO_ERROR on success
+    * @return E_NO_RESOURCE if failed to allocate DMA channel
+    */
+   static ErrorCode initialiseDma() {
+
+      if (dmaChannel != DmaChannelNum_None) {
+         return E_NO_ERROR;
+      }
+
+      // Allocate DMA channel to use for transmission
+      dmaChannel = Dma0::allocateChannel();
+      if (dmaChannel == DmaChannelNum_None) {
+         return setErrorCode(E_NO_RESOURCE);
+      }
+
+      // Minor loop mapping is needed to rewind the destination after each cycle
+      Dma0::enableClock();
+      Dma0::setMinorLoopMapping(DmaMinorLoopMapping_Enabled);
+
+      // Connect DMA channel to CMT
+      Dmamux0::configure(dmaChannel, Dma0Slot_CMT, DmamuxMode_Continuous);
+
+      Dma0::setCallback(dmaChannel, dmaCallback);
+      Dma0::enableNvicInterrupts(Dma0::IrqNum(dmaChannel), NvicPriority_Normal);
+
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Start DMA transmission of pre-rendered cycles
+    *
+    * @param cycles     Cycles to transmit (RAM or flash)
+    * @param cycleCount Number of cycles (at least 2)
+    */
+   static void startDmaTransmission(const CmtCycle *cycles, unsigned cycleCount) {
+
+      uint32_t cmtMscAddress = Cmt::baseAddress+offsetof(CMT_Type, MSC);
+
+      /**
+       * Structure to define the DMA transfer
+       *
+       * Each request writes one cycle to CMT.MSC,CMD1-4
+       */
+      DmaTcd tcd = DmaTcd (
+         {  /* Source */
+            /* Address                  */ (uint32_t)(uintptr_t)(cycles+1), // Source is array (1st cycle already loaded)
+            /* Offset                   */ 1,                           // Source address advances 1 byte per read
+            /* Size                     */ DmaSize_8bit,                // 8-bit read from source address
+         },
+         {  /* Destination */
+            /* Address                  */ cmtMscAddress,               // Destination is CMT.MSC
+            /* Offset                   */ 1,                           // Destination address advances through CMT.MSC,CMD1-4
+            /* Size                     */ DmaSize_8bit,                // 8-bit write to destination address
+         },
+         /* Minor loop byte count       */ sizeof(CmtCycle),            // One cycle per request
+         /* Minor loop offset select    */ DmaMinorLoopOffsetSelect_Destination,
+         /* Minor loop offset           */ -int32_t(sizeof(CmtCycle)),  // Return to CMT.MSC after each cycle
+         /* Major loop count            */ dmaCiter(cycleCount-1),      // Transfer remaining cycles
+
+         {  // CSR
+           /* Stop on complete          */ DmaStopOnComplete_Enabled,   // Disable requests when complete
+           /* Interrupt on complete     */ DmaIntMajor_Enabled,         // Interrupt when complete
+         }
+      );
+
+      Dma0::configureTransfer(dmaChannel, tcd);
+
+      // Load 1st cycle directly
+      loadCycle(cycles[0]);
+
+      Dma0::enableRequest(dmaChannel);
+      Cmt::setEndOfCycleAction(CmtEndOfCycleAction_DmaTransfer);
+
+      Cmt::start();
+      IrTiming::transmissionStarted(false);
+   }
+
+   /**
+    * Start transmission of pre-rendered cycles.
+    * The CMT should already be configured.
+    *
+    * DMA is used if selected. Otherwise each cycle is loaded by the CMT interrupt handler.
+    *
+    * @param cycles     Cycles to transmit (RAM or flash)
+    * @param cycleCount Number of cycles
+    */
+   static void startCycles(const CmtCycle *cycles, unsigned cycleCount) {
+
+      if ((transmitMode == IrTransmitMode_Dma) && (cycleCount >= 2) && (initialiseDma() == E_NO_ERROR)) {
+         // DMA transfers all cycles - call-back only does cleanup
+         txCycles          = cycles+cycleCount;
+         txCyclesRemaining = 0;
+         startDmaTransmission(cycles, cycleCount);
+         return;
+      }
+      txCycles          = cycles;
+      txCyclesRemaining = cycleCount;
+      {
+         CriticalSection cs;
+         // Prime 1st call-back
+         cmtCallback();
+      }
+      Cmt::start();
+      IrTiming::transmissionStarted(true);
+   }
+
+   /**
+    * Render the next frame of the interpreted transmission and start it.
+    *
+    * Frames are rendered one at a time as the previous frame completes.
+    * This allows held (unbounded) transmissions to use DMA and allows a
+    * transmission to be cancelled at a frame boundary.
+    *
+    * @return true  => Frame started
+    * @return false => Transmission complete or frame doesn't fit in the DMA buffer
+    */
+   static bool startDmaFrame() {
+
+      // Render from a copy so the interpreter is unchanged on failure
+      Interpreter renderer = interpreter;
+      unsigned cycleCount = renderFrame(renderer, dmaCycles, MAX_DMA_CYCLES);
+
+      if (cycleCount == 0) {
+         return false;
+      }
+      interpreter = renderer;
+      txStreaming = true;
+      startCycles(dmaCycles, cycleCount);
+      return true;
+   }
+
+   /**
+    * Start transmission of sequence already set up in interpreter.
+    * The CMT should already be configured.
+    *
+    * DMA is used if selected and each frame fits in the DMA buffer.
+    * Otherwise each cycle is produced by the CMT interrupt handler.
+    */
+   static void startTransmission() {
+
+      txStreaming = false;
+      if ((transmitMode == IrTransmitMode_Dma) && startDmaFrame()) {
+         return;
+      }
+      txCycles = nullptr;
+      {
+         CriticalSection cs;
+         // Prime 1st call-back
+         cmtCallback();
+      }
+      Cmt::start();
+      IrTiming::transmissionStarted(true);
+   }
+
+   /**
+    * Calculate carrier high and low times
+    *
+    * @param frequency  Carrier frequency (Hz)
+    * @param carrier    Carrier profile (see Carrier())
+    * @param high       Carrier high time in CMT clock cycles (Based on 8MHz CMT clock)
+    * @param low        Carrier low time in CMT clock cycles
+    */
+   static constexpr void carrierTiming(unsigned frequency, Control carrier, Ticks &high, Ticks &low) {
+      const unsigned period = 2*unsigned(8_MHz/frequency/2);
+      high = Ticks((period*extractCarrierDuty(carrier)+50)/100);
+      low  = Ticks(period-high);
+   }
+
+   /**
+    * Get PCR value for IR LED pin
+    *
+    * @param carrier Carrier profile (see Carrier())
+    *
+    * @return PCR value with drive strength from profile
+    */
+   static PcrValue carrierPcr(Control carrier) {
+      return PcrInit {
+         (extractCarrierDrive(carrier) == CarrierDrive_High)?PinDriveStrength_High:PinDriveStrength_Low,
+         PinDriveMode_PushPull,
+         PinSlewRate_Slow,
+      };
+   }
+
+   /**
+    * Configure CMT for transmission.
+    *
+    * The CMT is fully configured only on first use (or after disable()).
+    * Later transmissions only reprogram the carrier and pin if the frequency or profile changes.
+    *
+    * @param frequency  Carrier frequency (Hz)
+    * @param carrier    Carrier profile (see Carrier())
+    */
+   static void configureCmt(unsigned frequency, Control carrier) {
+
+      if ((frequency == configuredFrequency) && (carrier == configuredCarrier)) {
+         // Pins, prescaler, call-back and carrier unchanged
+         Cmt::setEndOfCycleAction(CmtEndOfCycleAction_Interrupt);
+         return;
+      }
 
-            default:
-               break;
+      /// Carrier high and low times in CMT clock cycles (Based on 8MHz CMT clock)
+      Ticks carrierHighInTicks, carrierLowInTicks;
+      carrierTiming(frequency, carrier, carrierHighInTicks, carrierLowInTicks);
+
+      if (configuredFrequency != 0) {
+         // Only carrier has changed
+         Cmt::setPrimaryTiming(carrierHighInTicks, carrierLowInTicks);
+         if (extractCarrierDrive(carrier) != extractCarrierDrive(configuredCarrier)) {
+            Cmt::setOutput(carrierPcr(carrier));
          }
-         break;
+         Cmt::setEndOfCycleAction(CmtEndOfCycleAction_Interrupt);
+         configuredFrequency = frequency;
+         configuredCarrier   = carrier;
+         return;
+      }
+
+//      DebugLed::setOutput();
+
+      Cmt::setOutput(carrierPcr(carrier));
+      //      SimInfo::setPortDPad(SimPortDPad_Double);
+
+      Cmt::Init cmtInitValue {
+
+         NvicPriority_Normal,
+         cmtCallback,
+
+         CmtEnable_Disabled,                                  // (cmt_msc_mcgen)  Enable - Disabled initially
+         CmtMode_Time ,                                       // (cmt_msc_mode)   Mode of operation - Disabled
+         CmtClockPrescaler_Auto ,                             // (cmt_pps_ppsdiv) Primary Prescaler Divider - Auto ~8MHz
+         CmtIntermediatePrescaler_DivBy1 ,                    // (cmt_msc_cmtdiv) Intermediate frequency Prescaler - Intermediate frequency /4
+         CmtOutput_ActiveHigh ,                               // (cmt_oc_output)  Output Control - Disabled
+         CmtEndOfCycleAction_Interrupt ,                      // (cmt_dma_irq)    End of Cycle Event handling - Interrupt Request
+         CmtPrimaryCarrierHighTime(carrierHighInTicks),       // (cmt_cgh1_ph)    Primary Carrier High Time Data Value
+         CmtPrimaryCarrierLowTime(carrierLowInTicks),         // (cmt_cgl1_pl)    Primary Carrier Low Time Data Value
+         // (cmt_mark)       Mark period (set by call-back)
+         // (cmt_space)      Space period (set by call-back)
       };
 
-      Ticks high, low;
-      bool bit;
+      // Configure CMT
+      Cmt::configure(cmtInitValue);
 
-      Control action = Control(current&c_ControlMask);
-      switch(action) {
+      // Timer for delays between transmissions
+      DelayChannel::defaultConfigureIfNeeded();
+      DelayChannel::enableNvicInterrupts(NvicPriority_Normal);
 
-         case c_MarkSpace:
-            high    = Ticks(*sequence++);
-            low     = Ticks(*sequence++);
+      configuredFrequency = frequency;
+      configuredCarrier   = carrier;
+   }
 
-            // Advance sequence
-            current = *sequence++;
+   /**
+    * Call-back from delay timer at end of delay after transmission
+    */
+   static void delayCallback() {
+      if (jobPhase == JobPhase_Delay) {
+         // Ignore a delay that was cancelled after expiring
+         transmissionComplete();
+      }
+   }
 
-            Cmt::setMarkSpacePeriods(high, low);
-            Cmt::setExtendedSpace(CmtExtendedSpace_Disabled);
-            Cmt::setMode(CmtMode_Time);
-            tickCount = tickCount + high + low;
-            break;
+   /**
+    * Start delay at end of transmission.
+    * The delay is timed by the PIT so the CMT is idle and the core may sleep.
+    *
+    * @param delay      Delay 1_tick = 1us
+    */
+   static void startDelay(unsigned delay) {
 
-         case c_DataLiteral:
+      if (delay == 0) {
+         transmissionComplete();
+         return;
+      }
+      DelayChannel::oneShotInMicroseconds(delayCallback, delay);
+   }
 
-            if (dataCount == 0) {
-               dataCount   = extractDataLiteralLength(current);
-               high     = Ticks(*sequence++);
-               low      = Ticks(*sequence++);
-               txData   = (high<<16)+low;
-               dataBitMask = 0b1;
-            }
-            bit = txData&dataBitMask;
-            if (bit) {
-               high = Ticks(OneHigh);
-               low  = Ticks(OneLow);
-            }
-            else {
-               high = Ticks(ZeroHigh);
-               low  = Ticks(ZeroLow);
-            }
-            Cmt::setMarkSpacePeriods(high, low);
-            Cmt::setExtendedSpace(CmtExtendedSpace_Disabled);
-            tickCount = tickCount + high + low;
-            if (--dataCount == 0) {
+   /**
+    * Start active job i.e. jobQueue[jobHead]
+    * Called with interrupts disabled or from interrupt handler
+    */
+   static void startJob() {
 
-               // Advance sequence
-               current = *sequence++;
-            }
-            dataBitMask <<= 1;
-            break;
+      IrJob &job = jobQueue[jobHead];
 
-         case  c_Data :
-            if (dataCount == 0) {
-               // First time - set up data Tx
-               txData      = data[extractDataIndex(current)];
-               dataCount   = extractDataLength(current, txData);
-               dataBitMask = 0b1;
-            }
-            bit = txData&dataBitMask;
-            if (bit) {
-               high = Ticks(OneHigh);
-               low  = Ticks(OneLow);
-            }
-            else {
-               high = Ticks(ZeroHigh);
-               low  = Ticks(ZeroLow);
-            }
-            Cmt::setMarkSpacePeriods(high, low);
-            Cmt::setExtendedSpace(CmtExtendedSpace_Disabled);
-            tickCount = tickCount + high + low;
-            if (--dataCount == 0) {
+      complete    = false;
+      eventCount  = 0;
+      jobPhase    = JobPhase_Transmit;
 
-               // Advance sequence
-               current = *sequence++;
-            }
-            dataBitMask <<= 1;
-            break;
+      if (job.sequence != nullptr) {
+         job.frequency = interpreter.start(job.sequence, job.data1, job.data2, job.repeat, job.hold, job.payload);
+         job.carrier   = interpreter.getCarrier();
+         configureCmt(job.frequency, job.carrier);
+         startTransmission();
+      }
+      else {
+         configureCmt(job.frequency, job.carrier);
+         txStreaming = false;
+         startCycles(job.cycles, job.cycleCount);
+      }
+   }
 
-         case c_Duration:  // Delay from last reference
-         case c_Delay:     // Absolute delay
-            if (duration == 0) {
-               // New delay/duration
-               high     = Ticks(current&c_Value12Mask);
-               low      = Ticks(*sequence++);
-               duration = Ticks((high<<16)+low);
-               if (action == c_Duration) {
-                  // Make relative
+   /**
+    * Called from CMT call-back when a transmission or delay completes.
+    * This advances the active job and starts the next queued job if any.
+    */
+   static void transmissionComplete() {
 
-                  usbdm_assert(duration > tickCount, "Duration < current time!");
-                  duration = duration - tickCount;
-               }
-            }
-            else {
-               // Continuation of current
-            }
+      IrJob &job = jobQueue[jobHead];
 
-            high = duration;
-            if (high > 2*65000_ticks) {
-               high = 2*65000_ticks;
-            }
+      if (jobPhase == JobPhase_Transmit) {
+         // Transmission complete - time delay
+         jobPhase = JobPhase_Delay;
+         startDelay(job.delay);
+         return;
+      }
 
-            // Split times
-            low    = Ticks(high/2);
-            high   = high - low;
+      // Delay complete - job done
+      CallbackFunction callback = job.callback;
 
-            Cmt::setMarkSpacePeriods(high, low);
-            Cmt::setExtendedSpace(CmtExtendedSpace_Enabled);
+      jobHead = (jobHead+1)%JOB_QUEUE_SIZE;
+      jobCount = jobCount-1;
 
-            tickCount = tickCount + high + low;
+      if (callback != nullptr) {
+         callback();
+      }
+      if (jobCount > 0) {
+         startJob();
+      }
+      else {
+         jobPhase = JobPhase_Idle;
+         complete = true;
+      }
+   }
 
-            duration = duration - high - low;
-            if (duration == 0) {
-               // Advance sequence as completed this action
-               current  = *sequence++;
-            }
-            break;
+   /**
+    * Indicates if the caller may sleep waiting for an IR interrupt.
+    * This requires thread mode with interrupts unmasked.
+    * Sleeping in a handler or critical section would never be woken by the CMT or PIT.
+    *
+    * @return true => May use sleepUntilInterrupt()
+    */
+   static bool canSleep() {
+      return (__get_IPSR() == 0) && (__get_PRIMASK() == 0);
+   }
 
-         case c_End:
-            // Last cycle underway
+   /**
+    * Sleep in WAIT mode until an interrupt occurs.
+    *
+    * This must be called within a critical section entered when canSleep() was true
+    * so an interrupt occurring after the wait condition was tested is not missed.
+    * WFI still wakes on a pending masked interrupt which is then taken when interrupts
+    * are unmasked.
+    */
+   static void sleepUntilInterrupt() {
+      Smc::enterWaitMode();
+      __enable_irq();
+      __disable_irq();
+   }
 
-            // Do a dummy cycle to wait for Tx complete
-            Cmt::setMarkSpacePeriods(1_ticks, 0_ticks);
-            Cmt::setExtendedSpace(CmtExtendedSpace_Enabled);
-            current = c_Cleanup;
-            return;
+   /**
+    * Add job to transmission queue.
+    * Waits for space if the queue is full.
+    *
+    * @param job Job to add
+    *
+    * @note If the queue is full when called from a handler or critical section the job
+    *       is discarded and E_NO_RESOURCE is set as waiting would deadlock.
+    */
+   static void queueJob(const IrJob &job) {
 
-         case c_Cleanup:
-            // Dummy cycle underway
+      const bool mayWait = canSleep();
 
-            // Disable CMT - It will continue until end of dummy cycle even if CMT stopped
-            Cmt::stop();
-            complete   = true;
-            return;
+      CriticalSection cs;
 
-         default:
-            break;
+      // Wait for space in queue
+      while (jobCount >= JOB_QUEUE_SIZE) {
+         if (!mayWait) {
+            usbdm_assert(false, "IR queue full in handler or critical section");
+            setErrorCode(E_NO_RESOURCE);
+            return;
+         }
+         sleepUntilInterrupt();
       }
 
-//      DebugLed::off();
+      jobQueue[(jobHead+jobCount)%JOB_QUEUE_SIZE] = job;
+      jobCount = jobCount+1;
+
+      if (jobPhase == JobPhase_Idle) {
+         startJob();
+      }
    }
 
    static void playEvent() {
@@ -617,7 +2286,7 @@ private:
          case  c_Data :
             if (dataCount == 0) {
                txData      = data[extractDataIndex(current)];
-               dataCount   = extractDataLength(current, txData);
+               dataCount   = extractDataLength(current);
                dataBitMask = 0b1;
                console.writeln('[', location, decimal2Format, "]:", tickCount, decimal8Format, ":--------------------------------------------");
                console.writeln('[', location, decimal2Format, "]:", tickCount, decimal8Format, ": data-start(d=0x", txData, hexFormat, "|c=", dataCount, ')');
@@ -684,116 +2353,426 @@ private:
 protected:
 
    /**
-    * Send an IR transmission
+    * Queue an IR transmission.
+    * This returns immediately unless the queue is full.
     *
+    * @param newSequence   Protocol sequence
     * @param data1         First data item/code
     * @param data2         Second data item/code
     * @param repeat        Number of times to repeat (including original).
     * @param delay         Delay at end of sequence 1_tick = 1us
+    * @param callback      Called (from interrupt) when transmission and delay complete
     */
-   static void runSequence(const Control *newSequence, uint32_t data1, uint32_t data2, unsigned repeat, unsigned delay) {
+   static void runSequence(
+         const Control     *newSequence,
+         uint32_t           data1,
+         uint32_t           data2,
+         unsigned           repeat,
+         unsigned           delay,
+         CallbackFunction   callback=nullptr) {
+
+      queueJob({newSequence, nullptr, 0, 0, Control(0), data1, data2, nullptr, repeat, delay, callback, false, false});
+   }
 
-      // Wait until previous Tx completes
-      waitUntilComplete();
+   /**
+    * Queue an IR transmission with bit-fields taken from a payload buffer.
+    * This returns immediately unless the queue is full.
+    *
+    * The protocol sequence uses DataBuffer() bit-fields e.g. compiled with IrpFields_Payload.
+    * The payload is not copied so it must remain unchanged until the call-back is executed.
+    *
+    * @param newSequence   Protocol sequence
+    * @param payload       Bit-fields packed LSB first (see DataBuffer())
+    * @param repeat        Number of times to repeat (including original).
+    * @param delay         Delay at end of sequence 1_tick = 1us
+    * @param callback      Called (from interrupt) when transmission and delay complete
+    */
+   static void runPayload(
+         const Control     *newSequence,
+         const uint8_t     *payload,
+         unsigned           repeat,
+         unsigned           delay,
+         CallbackFunction   callback=nullptr) {
+
+      queueJob({newSequence, nullptr, 0, 0, Control(0), 0, 0, payload, repeat, delay, callback, false, false});
+   }
 
-      complete    = false;
-      sequence    = newSequence;
-      data[0]     = data1;
-      data[1]     = data2;
-      repeatCount = repeat;
+   /**
+    * Queue an IR transmission replacing any pre-emptible transmissions in progress.
+    * This returns immediately unless the queue is full.
+    *
+    * Pre-emptible transmissions are cancelled as described for cancel().
+    * The new transmission is itself pre-emptible.
+    *
+    * @param newSequence   Protocol sequence
+    * @param data1         First data item/code
+    * @param data2         Second data item/code
+    * @param repeat        Number of times to repeat (including original).
+    * @param delay         Delay at end of sequence 1_tick = 1us
+    * @param callback      Called (from interrupt) when transmission and delay complete
+    */
+   static void replaceSequence(
+         const Control     *newSequence,
+         uint32_t           data1,
+         uint32_t           data2,
+         unsigned           repeat,
+         unsigned           delay,
+         CallbackFunction   callback=nullptr) {
+
+      cancel();
+      queueJob({newSequence, nullptr, 0, 0, Control(0), data1, data2, nullptr, repeat, delay, callback, false, true});
+   }
 
-      dataBitMask = 0b1;
-      dataCount   = 0;
-      tickCount   = 0_ticks;
-      eventCount  = 0;
+   /**
+    * Queue an IR transmission that continues while a key is held.
+    * This returns immediately unless the queue is full.
+    *
+    * The repeat block of the sequence is sent continuously until release() is called.
+    * The transmission then stops at the end of the current frame.
+    * A short press still produces the requested number of repeats.
+    *
+    * @param newSequence   Protocol sequence
+    * @param data1         First data item/code
+    * @param data2         Second data item/code
+    * @param repeat        Minimum number of times to repeat (including original).
+    * @param delay         Delay at end of sequence 1_tick = 1us
+    * @param callback      Called (from interrupt) when transmission and delay complete
+    */
+   static void holdSequence(
+         const Control     *newSequence,
+         uint32_t           data1,
+         uint32_t           data2,
+         unsigned           repeat,
+         unsigned           delay,
+         CallbackFunction   callback=nullptr) {
+
+      queueJob({newSequence, nullptr, 0, 0, Control(0), data1, data2, nullptr, repeat, delay, callback, true, false});
+   }
 
-      unsigned frequency  = uint16_t(*sequence++);
+   /**
+    * Queue a pre-rendered IR transmission.
+    * This returns immediately unless the queue is full.
+    *
+    * @param frequency     Carrier frequency (Hz)
+    * @param cycles        Modulator cycles to transmit
+    * @param cycleCount    Number of cycles
+    * @param delay         Delay at end of sequence 1_tick = 1us
+    * @param callback      Called (from interrupt) when transmission and delay complete
+    * @param carrier       Carrier profile (see Carrier())
+    */
+   static void runCycles(
+         unsigned           frequency,
+         const CmtCycle    *cycles,
+         unsigned           cycleCount,
+         unsigned           delay,
+         CallbackFunction   callback=nullptr,
+         Control            carrier=CARRIER_FULL) {
+
+      queueJob({nullptr, cycles, cycleCount, frequency, carrier, 0, 0, nullptr, 0, delay, callback, false, false});
+   }
 
-      ZeroHigh  = uint16_t(*sequence++);
-      ZeroLow   = uint16_t(*sequence++);
-      OneHigh   = uint16_t(*sequence++);
-      OneLow    = uint16_t(*sequence++);
+   /**
+    * Queue an IR transmission rendered at compile time
+    *
+    * @param rendered      Transmission from renderSequence()
+    * @param delay         Delay at end of sequence 1_tick = 1us
+    * @param callback      Called (from interrupt) when transmission and delay complete
+    */
+   template<unsigned N>
+   static void runRendered(const RenderedSequence<N> &rendered, unsigned delay, CallbackFunction callback=nullptr) {
+      runCycles(rendered.frequency, rendered.cycles, N, delay, callback, rendered.carrier);
+   }
 
-//      DebugLed::setOutput();
+   /**
+    * Report error in burst.
+    * This is not constexpr so reaching it during compilation reports an error.
+    *
+    * @param message Description of error
+    */
+   static void burstError(const char *message) {
+      (void)message;
+   }
 
+   /**
+    * Get number of modulator cycles in a transmission rendered at compile time
+    *
+    * @param rendered Transmission from renderSequence()
+    *
+    * @return Number of cycles including final dummy cycle
+    */
+   template<unsigned N>
+   static constexpr unsigned renderedSize(const RenderedSequence<N> &) {
+      return N;
+   }
 
-      static constexpr PcrInit pcrInit {
-         PinDriveStrength_High,
-         PinDriveMode_PushPull,
-         PinSlewRate_Slow,
+   /**
+    * Render a gap between transmissions as modulator cycles.
+    * Each cycle is an extended space of at most 2*65000 us as for a delay in a protocol sequence.
+    *
+    * @param gap     Gap 1_tick = 1us (at least 1)
+    * @param buffer  Buffer for cycles (nullptr => count only)
+    *
+    * @return Number of cycles
+    */
+   static constexpr unsigned renderGap(unsigned gap, CmtCycle buffer[]) {
+      unsigned count = 0;
+      do {
+         unsigned time = (gap > 2*65000)?2*65000:gap;
+         if (buffer != nullptr) {
+            buffer[count] = CmtCycle(Interval{uint16_t(time-time/2), uint16_t(time/2), true});
+         }
+         count++;
+         gap -= time;
+      } while (gap > 0);
+      return count;
+   }
+
+   /**
+    * Burst of transmissions rendered at compile time (see renderBurst())
+    *
+    * @tparam N Number of modulator cycles
+    */
+   template<unsigned N>
+   struct RenderedBurst : RenderedSequence<N> {
+      unsigned delay;       ///< Delay after last transmission 1_tick = 1us
+   };
+
+public:
+   /**
+    * Step of a burst i.e. a transmission rendered at compile time followed by a gap
+    *
+    * @tparam rendered  Transmission rendered at compile time e.g. IrSonyTV::rendered<IrSonyTV::ON>
+    * @tparam gap       Gap after transmission 1_tick = 1us
+    */
+   template<const auto &rendered, unsigned gap>
+   struct BurstStep {
+      static constexpr auto    &transmission = rendered;
+      static constexpr unsigned delay        = gap;
+   };
+
+   /**
+    * Render a burst of transmissions at compile time.
+    *
+    * The transmissions are concatenated into a single transmission with the gaps as extended spaces
+    * so the burst is sent as one job (one CMT set-up, one DMA transfer) rather than a job per step.
+    * The waveform is the same as sending each transmission in turn with the gap as the delay.
+    * The gap after the last step is the delay at the end of the burst.
+    *
+    * All transmissions must use the same carrier frequency and profile. A mismatch is a compile error
+    * at the call to burstError().
+    *
+    * Example
+    * @code
+    *    static constexpr auto burst = IrRemote::renderBurst<
+    *          IrRemote::BurstStep<IrSonyTV::rendered<IrSonyTV::ON>,   1000>,
+    *          IrRemote::BurstStep<IrSonyTV::rendered<IrSonyTV::HOME>, 100>>();
+    *
+    *    IrRemote::sendBurst(burst);
+    * @endcode
+    *
+    * @tparam Steps Steps of burst (see BurstStep)
+    *
+    * @return Rendered burst
+    */
+   template<typename... Steps>
+   static consteval auto renderBurst() {
+
+      constexpr unsigned stepCount = sizeof...(Steps);
+      static_assert(stepCount > 0, "Burst has no steps");
+
+      constexpr unsigned delays[] = {Steps::delay...};
+
+      // Each step without dummy cycle followed by gap (which includes the dummy cycle time).
+      // The last step retains the dummy cycle and the gap becomes the delay at end of burst.
+      constexpr unsigned size =
+            (0 + ... + (renderedSize(Steps::transmission)-1+renderGap(1+Steps::delay, nullptr)))
+            - renderGap(1+delays[stepCount-1], nullptr) + 1;
+
+      RenderedBurst<size> burst{};
+
+      constexpr unsigned frequencies[] = {Steps::transmission.frequency...};
+      constexpr Control  carriers[]    = {Steps::transmission.carrier...};
+      burst.frequency = frequencies[0];
+      burst.carrier   = carriers[0];
+      burst.delay     = delays[stepCount-1];
+
+      unsigned index = 0;
+      unsigned step  = 0;
+      auto addStep = [&](const auto &rendered, unsigned gap) {
+         if ((rendered.frequency != burst.frequency) || (rendered.carrier != burst.carrier)) {
+            burstError("Burst steps must use the same carrier");
+         }
+         const unsigned cycleCount = renderedSize(rendered);
+         for (unsigned cycle=0; cycle<cycleCount-1; cycle++) {
+            burst.cycles[index++] = rendered.cycles[cycle];
+         }
+         if (++step < stepCount) {
+            index += renderGap(1+gap, burst.cycles+index);
+         }
+         else {
+            burst.cycles[index++] = rendered.cycles[cycleCount-1];
+         }
       };
-      Cmt::setOutput(pcrInit);
-      //      SimInfo::setPortDPad(SimPortDPad_Double);
+      (addStep(Steps::transmission, Steps::delay), ...);
+
+      return burst;
+   }
 
-      /// Carrier half period in CMT clock cycles (Based on 8MHz CMT clock)
-      const Ticks  carrierHalfPeriodInTicks = Ticks(8_MHz/frequency/2);
+   /**
+    * Queue transmission of a burst rendered at compile time.
+    * This returns immediately unless the queue is full.
+    *
+    * @param burst      Burst from renderBurst()
+    * @param callback   Called (from interrupt) when burst and final delay are complete
+    */
+   template<unsigned N>
+   static void sendBurst(const RenderedBurst<N> &burst, CallbackFunction callback=nullptr) {
+      runRendered(burst, burst.delay, callback);
+   }
 
-      Cmt::Init cmtInitValue {
+   /**
+    * Indicates if IR transmissions are in progress or queued
+    *
+    * @return true => Busy
+    */
+   static bool isBusy() {
+      return !complete;
+   }
 
-         NvicPriority_Normal,
-         cmtCallback,
+   /**
+    * Indicates if the job queue is full i.e. queuing a transmission would wait for space
+    *
+    * @return true => Full
+    */
+   static bool isQueueFull() {
+      return jobCount >= JOB_QUEUE_SIZE;
+   }
 
-         CmtEnable_Disabled,                                  // (cmt_msc_mcgen)  Enable - Disabled initially
-         CmtMode_Time ,                                       // (cmt_msc_mode)   Mode of operation - Disabled
-         CmtClockPrescaler_Auto ,                             // (cmt_pps_ppsdiv) Primary Prescaler Divider - Auto ~8MHz
-         CmtIntermediatePrescaler_DivBy1 ,                    // (cmt_msc_cmtdiv) Intermediate frequency Prescaler - Intermediate frequency /4
-         CmtOutput_ActiveHigh ,                               // (cmt_oc_output)  Output Control - Disabled
-         CmtEndOfCycleAction_Interrupt ,                      // (cmt_dma_irq)    End of Cycle Event handling - Interrupt Request
-         CmtPrimaryCarrierHighTime(carrierHalfPeriodInTicks), // (cmt_cgh1_ph)    Primary Carrier High Time Data Value
-         CmtPrimaryCarrierLowTime(carrierHalfPeriodInTicks),  // (cmt_cgl1_pl)    Primary Carrier Low Time Data Value
-         // (cmt_mark)       Mark period (set by call-back)
-         // (cmt_space)      Space period (set by call-back)
-      };
+   /**
+    * Wait until all queued IR transmissions (including delays) are complete
+    *
+    * @return E_NO_ERROR on success
+    * @return E_WRONG_STATE if called from a handler or critical section while busy
+    */
+   static ErrorCode waitUntilComplete() {
 
-      // Configure CMT
-      Cmt::configure(cmtInitValue);
+      const bool mayWait = canSleep();
 
-      {
-         CriticalSection cs;
-      // Prime 1st call-back
-      current = *sequence++;
-      cmtCallback();
-      }
+      CriticalSection cs;
 
-      Cmt::start();
+      while (!complete) {
+         if (!mayWait) {
+            usbdm_assert(false, "IR wait in handler or critical section");
+            return setErrorCode(E_WRONG_STATE);
+         }
+         sleepUntilInterrupt();
+      }
+      return E_NO_ERROR;
+   }
 
-      waitUntilComplete();
+   /**
+    * Release a held key.
+    * A held transmission stops at the end of the current frame.
+    * Held transmissions that are still queued are sent with their normal repeat count.
+    */
+   static void release() {
 
-      static Control delaySequence[3];
+      CriticalSection cs;
 
-      delaySequence[0] = DelayHigh(Ticks(delay));  // delay us
-      delaySequence[1] = DelayLow(Ticks(delay));   //
-      delaySequence[2] = c_End;
+      for (unsigned index=0; index<jobCount; index++) {
+         jobQueue[(jobHead+index)%JOB_QUEUE_SIZE].hold = false;
+      }
+      interpreter.release();
+   }
 
-      sequence   = delaySequence;
-      complete   = false;
-      tickCount  = 0_ticks;
+   /**
+    * Cancel pre-emptible transmissions e.g. those queued by replaceSequence().
+    *
+    * Pre-emptible jobs waiting at the end of the queue are discarded. Their call-backs are still executed
+    * so callers tracking completion are not left waiting.
+    * If the active job is pre-emptible, its transmission stops at the end of the current frame and
+    * the delay after it is skipped. The frame's trailing gap is always completed so the minimum
+    * spacing required by the protocol is honoured.
+    * Other jobs are not affected.
+    */
+   static void cancel() {
 
-      // Configure CMT
-      Cmt::configure(cmtInitValue);
+      CriticalSection cs;
 
-      // Prime 1st call-back
-      current = *sequence++;
-      cmtCallback();
+      // Discard queued pre-emptible jobs (not the active job)
+      while ((jobCount > 1) && jobQueue[(jobHead+jobCount-1)%JOB_QUEUE_SIZE].preemptible) {
+         CallbackFunction callback = jobQueue[(jobHead+jobCount-1)%JOB_QUEUE_SIZE].callback;
+         jobCount = jobCount-1;
+         if (callback != nullptr) {
+            callback();
+         }
+      }
+      if ((jobCount != 1) || !jobQueue[jobHead].preemptible) {
+         return;
+      }
+      jobQueue[jobHead].delay = 0;
 
-      Cmt::start();
+      if (jobPhase == JobPhase_Transmit) {
+         // Stop at end of current frame
+         interpreter.cancel();
+      }
+      else if (jobPhase == JobPhase_Delay) {
+         // Abandon delay
+         DelayChannel::disable();
+         DelayChannel::clearInterruptFlag();
+         transmissionComplete();
+      }
    }
 
-public:
+   /**
+    * Disable CMT e.g. before entering a low-power mode.
+    * Waits until queued IR transmissions are complete.
+    * The CMT is re-configured on the next transmission.
+    *
+    * @return E_NO_ERROR on success
+    * @return E_WRONG_STATE if unable to wait for transmissions to complete (CMT not disabled)
+    */
+   static ErrorCode disable() {
+      ErrorCode rc = waitUntilComplete();
+      if (rc != E_NO_ERROR) {
+         return rc;
+      }
+      Cmt::disable();
+      configuredFrequency = 0;
+      return E_NO_ERROR;
+   }
 
-   static void waitUntilComplete() {
-      while (!complete) {
-         __asm__("nop");
+   /**
+    * Select how modulator cycles are provided to the CMT.
+    * Waits until queued IR transmissions are complete.
+    *
+    * @param mode Transmit mode
+    *
+    * @return E_NO_ERROR on success
+    * @return E_WRONG_STATE if unable to wait for transmissions to complete (mode not changed)
+    */
+   static ErrorCode setTransmitMode(IrTransmitMode mode) {
+      ErrorCode rc = waitUntilComplete();
+      if (rc != E_NO_ERROR) {
+         return rc;
       }
+      transmitMode = mode;
+      return E_NO_ERROR;
    }
 
    static void testSequence(const Control *newSequence, uint32_t data1, uint32_t data2, uint8_t repeats) {
 
+      // Wait until queued Tx completes
+      if (waitUntilComplete() != E_NO_ERROR) {
+         return;
+      }
+
       sequence        = newSequence;
       startOfSequence = sequence;
       repeatCount     = repeats;
 
       sequence++; // Discard frequency
+      sequence++; // Discard carrier profile
 
       ZeroHigh  = uint16_t(*sequence++);
       ZeroLow   = uint16_t(*sequence++);
@@ -825,60 +2804,16 @@ class IrLaserDVD : public IrRemote {
 
 private:
 
-   inline static const Control protocolSequence[] = {
-         //  IRP: {38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*
-         //
-         /*      */   // Parameters
-         /*      */   //=======================
-         /*      */   Value(38_kHz),        // Frequency (Hz) {38.0k,564}
-         /*      */
-         /*      */   Value(1*564_ticks),   // 0 High (us) <1,-1|1,-3>
-         /*      */   Value(1*564_ticks),   // 0 Low  (us)
-         /*      */   Value(1*564_ticks),   // 1 High (us)
-         /*      */   Value(3*564_ticks),   // 1 Low  (us)
-         /*      */
-         /*      */   // Start of sequence
-         /*      */   //=======================
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                | Start-bit
-         /*  1   */   c_MarkSpace,                //                |
-         /*      */   Value(16*564_ticks),  // Start bit high | (16,-8)
-         /*      */   Value(8*564_ticks),   // Start bit low  |
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                | 32-bit Data
-         /* 2-33 */   Data1(32),            //              | (D:8,S:8,F:8,~F:8)
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                 | Stop-bit
-         /* 34   */   c_MarkSpace,                 //                |
-         /*      */   Value(1*564_ticks),   // Stop bit high  + (1,^108m)
-         /*      */   Value(0),             // ---            |
-         /*      */                         //                |
-         /* 35   */   DurationHigh(108000), // ^108m          |
-         /*      */   DurationLow(108000),  //                +
-         /*      */
-         /*      */   //-----------------------------------------
-         /*      */   //                                                     | Abbreviated Repeat
-         /* 36   */   Repeat(0),               //                +
-         /*      */      c_Epoch_Start,               //                |
-         /*      */                                        //                |
-         /* 37   */      c_MarkSpace,                 //                |
-         /*      */      Value(16*564_ticks),   // 16             | (16,-4,1,^108m)R+
-         /*      */      Value(4*564_ticks),    // -4             |
-         /*      */                                        //                |
-         /* 38   */      c_MarkSpace,                 //                |
-         /*      */      Value(1*564_ticks),    // 1              |
-         /*      */      Value(0),              //                |
-         /*      */                                        //                |
-         /* 39   */      DurationHigh(108000),  // ^108m          |
-         /*      */      DurationLow(108000),   //                |
-         /*      */                                        //                |
-         /* 40   */   Label(0),                //                +
-         /*      */
-         /* 41   */   c_End,
-   };
+   /// Protocol description in IRP notation. Code provides D:8,S:8,F:8,~F:8
+   static constexpr char irp[] = "{38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*";
+
+   /// Protocol sequence compiled from IRP
+   static constexpr auto compiledSequence = compileIrp<irp>();
+
+   static constexpr const Control *protocolSequence = compiledSequence.sequence;
+
+   /// IrRegistry uses this protocol sequence for devices using the same protocol
+   friend class IrRegistry;
 
 public:
    /**
@@ -939,20 +2874,86 @@ public:
    };
 
    /**
-    * Start transmission of sequence.
+    * Queue transmission of sequence.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   static void send(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16);
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence that continues while a key is held.
+    * The protocol repeat frame is sent until release() is called.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Minimum number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    */
+   static void hold(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16, " (held)");
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::holdSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence replacing any key press still being transmitted.
+    * The earlier transmission stops at the end of its current frame.
     *
     * @param code       Command to send
     * @param delay      Delay at end of sequence 1_tick = 1us
     * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
     */
-   static void send(Code code, unsigned delay, unsigned repeat=3) {
+   static void replace(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
 
       console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
       }
-      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay);
+      IrRemote::replaceSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Transmission rendered at compile time.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    */
+   template<Code code, unsigned repeat=3>
+   static constexpr auto rendered = renderSequence<protocolSequence, code, 0, repeat>();
+
+   /**
+    * Queue transmission of sequence rendered at compile time.
+    * This avoids interpreting the protocol sequence during transmission.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    *
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   template<Code code, unsigned repeat=3>
+   static void send(unsigned delay, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16);
+
+      IrRemote::runRendered(rendered<code, repeat>, delay, callback);
    }
 
    /**
@@ -973,7 +2974,7 @@ public:
 };
 
 /**
- * Class to wrap CMT hardware for Laser-DVD protocol
+ * Class to wrap CMT hardware for Blaupunkt-DVD protocol
  *
  * Based on NEC IR protocol
  */
@@ -981,60 +2982,16 @@ class IrBlaupunktDVD : public IrRemote {
 
 private:
 
-   inline static const Control protocolSequence[] = {
-         //  IRP: {38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*
-         //
-         /*      */   // Parameters
-         /*      */   //=======================
-         /*      */   Value(38_kHz),        // Frequency (Hz) {38.0k,564}
-         /*      */
-         /*      */   Value(1*564_ticks),   // 0 High (us) <1,-1|1,-3>
-         /*      */   Value(1*564_ticks),   // 0 Low  (us)
-         /*      */   Value(1*564_ticks),   // 1 High (us)
-         /*      */   Value(3*564_ticks),   // 1 Low  (us)
-         /*      */
-         /*      */   // Start of sequence
-         /*      */   //=======================
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                 | Start-bit
-         /*  1   */   c_MarkSpace,                 //                |
-         /*      */   Value(16*564_ticks),   // Start bit high | (16,-8)
-         /*      */   Value(8*564_ticks),    // Start bit low  |
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                 | 32-bit Data
-         /* 2-33 */   Data1(32),           //                | (D:8,S:8,F:8,~F:8)
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                 | Stop-bit
-         /* 34   */   c_MarkSpace,                 //                |
-         /*      */   Value(1*564_ticks),   // Stop bit high  + (1,^108m)
-         /*      */   Value(0),             // ---            |
-         /*      */                                    //                |
-         /* 35   */   DurationHigh(108000), // ^108m          |
-         /*      */   DurationLow(108000),  //                +
-         /*      */
-         /*      */   //-----------------------------------------
-         /*      */   //                                                     | Abbreviated Repeat
-         /*      */   Repeat(0),               //                +
-         /*      */      c_Epoch_Start,               //                |
-         /*      */                                        //                |
-         /* 36   */      c_MarkSpace,                 //                |
-         /*      */      Value(16*564_ticks),   // 16             | (16,-4,1,^108m)R+
-         /*      */      Value(4*564_ticks),    // -4             |
-         /*      */                                        //                |
-         /* 37   */      c_MarkSpace,                 //                |
-         /*      */      Value(1*564_ticks),    // 1              |
-         /*      */      Value(0),              //                |
-         /*      */                                        //                |
-         /* 38   */      DurationHigh(108000),  // ^108m          |
-         /*      */      DurationLow(108000),   //                |
-         /*      */                                        //                |
-         /*      */   Label(0),                //                +
-         /*      */
-         /* 42   */   c_End,
-   };
+   /// Protocol description in IRP notation. Code provides D:8,S:8,F:8,~F:8
+   static constexpr char irp[] = "{38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*";
+
+   /// Protocol sequence compiled from IRP
+   static constexpr auto compiledSequence = compileIrp<irp>();
+
+   static constexpr const Control *protocolSequence = compiledSequence.sequence;
+
+   /// IrRegistry uses this protocol sequence for devices using the same protocol
+   friend class IrRegistry;
 
 public:
    /**
@@ -1090,20 +3047,86 @@ public:
 };
 
    /**
-    * Start transmission of sequence.
+    * Queue transmission of sequence.
     *
     * @param code       Command to send
     * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
     * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay are complete
     */
-   static void send(Code code, unsigned delay, unsigned repeat=3) {
+   static void send(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
 
-      console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16);
+      console.writeln("IrRemote: Blaupunkt-DVD: 0x", code, Radix_16);
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence that continues while a key is held.
+    * The protocol repeat frame is sent until release() is called.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Minimum number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    */
+   static void hold(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Blaupunkt-DVD: 0x", code, Radix_16, " (held)");
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::holdSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence replacing any key press still being transmitted.
+    * The earlier transmission stops at the end of its current frame.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   static void replace(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Blaupunkt-DVD: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
       }
-      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay);
+      IrRemote::replaceSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Transmission rendered at compile time.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    */
+   template<Code code, unsigned repeat=3>
+   static constexpr auto rendered = renderSequence<protocolSequence, code, 0, repeat>();
+
+   /**
+    * Queue transmission of sequence rendered at compile time.
+    * This avoids interpreting the protocol sequence during transmission.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    *
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   template<Code code, unsigned repeat=3>
+   static void send(unsigned delay, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Blaupunkt-DVD: 0x", code, Radix_16);
+
+      IrRemote::runRendered(rendered<code, repeat>, delay, callback);
    }
 
    /**
@@ -1114,7 +3137,7 @@ public:
     */
    static void test(Code code, uint8_t repeat=0) {
 
-      console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16);
+      console.writeln("IrRemote: Blaupunkt-DVD: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
@@ -1124,7 +3147,7 @@ public:
 };
 
 /**
- * Class to wrap CMT hardware for Teac-DVD protocol
+ * Class to wrap CMT hardware for Teac-PVR protocol
  *
  * Based on NEC IR protocol
  */
@@ -1135,59 +3158,13 @@ private:
    IrTeacPVR() = delete;
    IrTeacPVR(const IrTeacPVR &) = delete;
 
-   inline static const Control protocolSequence[] = {
-         //  IRP: {38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*
-         //
-         /*      */   // Parameters
-         /*      */   //=======================
-         /*      */   Value(38_kHz),        // Frequency (Hz) {38.0k,564}
-         /*      */
-         /*      */   Value(1*564_ticks),   // 0 High (us) <1,-1|1,-3>
-         /*      */   Value(1*564_ticks),   // 0 Low  (us)
-         /*      */   Value(1*564_ticks),   // 1 High (us)
-         /*      */   Value(3*564_ticks),   // 1 Low  (us)
-         /*      */
-         /*      */   // Start of sequence
-         /*      */   //=======================
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                | Start-bit
-         /*  1   */   c_MarkSpace,                //                |
-         /*      */   Value(16*564_ticks),  // Start bit high | (16,-8)
-         /*      */   Value(8*564_ticks),   // Start bit low  |
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                | 32-bit Data
-         /* 2-33 */   Data1(32),          //                | (D:8,S:8,F:8,~F:8)
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                                 | Stop-bit
-         /* 34   */   c_MarkSpace,                 //                |
-         /*      */   Value(1*564_ticks),   // Stop bit high  + (1,^108m)
-         /*      */   Value(0),             // ---            |
-         /*      */                                    //                |
-         /* 35   */   DurationHigh(108000), // ^108m          |
-         /*      */   DurationLow(108000),  //                +
-         /*      */
-         /*      */   //-----------------------------------------
-         /*      */   //                                                    | Abbreviated Repeat
-         /*      */   Repeat(0),              //                +
-         /*      */      c_Epoch_Start,              //                |
-         /*      */                                       //                |
-         /* 36   */      c_MarkSpace,                //                |
-         /*      */      Value(16*564_ticks),  // Start bit high | (16,-4,1,^108m)R+
-         /*      */      Value(4*564_ticks),   // Start bit low  |
-         /* 37   */      c_MarkSpace,                //                |
-         /*      */      Value(1*564_ticks),   // Stop bit high  |
-         /*      */      Value(0),             // ---            |
-         /*      */                                       //                |
-         /* 38   */      DurationHigh(108000), // ^108m          |
-         /*      */      DurationLow(108000),  //                |
-         /*      */                                       //                |
-         /*      */   Label(0),               //                +
-         /*      */
-         /* 42   */   c_End,
-   };
+   /// Protocol description in IRP notation. Code provides D:8,S:8,F:8,~F:8
+   static constexpr char irp[] = "{38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*";
+
+   /// Protocol sequence compiled from IRP
+   static constexpr auto compiledSequence = compileIrp<irp>();
+
+   static constexpr const Control *protocolSequence = compiledSequence.sequence;
 
 public:
    /**
@@ -1239,20 +3216,86 @@ public:
 };
 
    /**
-    * Start transmission of sequence.
+    * Queue transmission of sequence.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   static void send(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Teac-PVR: 0x", code, Radix_16);
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence that continues while a key is held.
+    * The protocol repeat frame is sent until release() is called.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Minimum number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    */
+   static void hold(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Teac-PVR: 0x", code, Radix_16, " (held)");
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::holdSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence replacing any key press still being transmitted.
+    * The earlier transmission stops at the end of its current frame.
     *
     * @param code       Command to send
     * @param delay      Delay at end of sequence 1_tick = 1us
     * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
     */
-   static void send(Code code, unsigned delay, unsigned repeat=3) {
+   static void replace(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
 
       console.writeln("IrRemote: Teac-PVR: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
       }
-      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay);
+      IrRemote::replaceSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Transmission rendered at compile time.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    */
+   template<Code code, unsigned repeat=3>
+   static constexpr auto rendered = renderSequence<protocolSequence, code, 0, repeat>();
+
+   /**
+    * Queue transmission of sequence rendered at compile time.
+    * This avoids interpreting the protocol sequence during transmission.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    *
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   template<Code code, unsigned repeat=3>
+   static void send(unsigned delay, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Teac-PVR: 0x", code, Radix_16);
+
+      IrRemote::runRendered(rendered<code, repeat>, delay, callback);
    }
 
    /**
@@ -1284,59 +3327,13 @@ private:
    IrTeacDVD() = delete;
    IrTeacDVD(const IrTeacDVD &) = delete;
 
-   inline static const Control protocolSequence[] = {
-         //           {38k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*
-         //
-         /*      */   // Parameters
-         /*      */   //=======================
-         /*      */   Value(38_kHz),        // Frequency (Hz) {38.0k,564}
-         /*      */
-         /*      */   Value(1*564_ticks),   // 0 High (us) <1,-1|1,-3>
-         /*      */   Value(1*564_ticks),   // 0 Low  (us)
-         /*      */   Value(1*564_ticks),   // 1 High (us)
-         /*      */   Value(3*564_ticks),   // 1 Low  (us)
-         /*      */
-         /*      */   // Start of sequence
-         /*      */   //=======================
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                      | Start-bit
-         /*  1   */   c_MarkSpace,          //                |
-         /*      */   Value(16*564_ticks),  // Start bit high | (16,-8)
-         /*      */   Value(8*564_ticks),   // Start bit low  |
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                      | 32-bit Data
-         /* 2-33 */   Data1(32),            //                | (D:8,S:8,F:8,~F:8)
-         /*      */
-         /*      */   //--------------------------------------
-         /*      */   //                                      | Stop-bit
-         /* 34   */   c_MarkSpace,          //                |
-         /*      */   Value(1*564_ticks),   // Stop bit high  + (1,^108m)
-         /*      */   Value(0),             // ---            |
-         /*      */                         //                |
-         /* 35   */   DurationHigh(108000), // ^108m          |
-         /*      */   DurationLow(108000),  //                +
-         /*      */
-         /*      */   //-----------------------------------------
-         /*      */   //                                         | Abbreviated Repeat
-         /*      */   Repeat(0),               //                +
-         /*      */      c_Epoch_Start,        //                |
-         /*      */                            //                |
-         /* 36   */      c_MarkSpace,          //                |
-         /*      */      Value(16*564_ticks),  // Start bit high | (16,-4,1,^108m)R+
-         /*      */      Value(4*564_ticks),   // Start bit low  |
-         /* 37   */      c_MarkSpace,          //                |
-         /*      */      Value(1*564_ticks),   // Stop bit high  |
-         /*      */      Value(0),             // ---            |
-         /*      */                            //                |
-         /* 38   */      DurationHigh(108000), // ^108m          |
-         /*      */      DurationLow(108000),  //                |
-         /*      */                            //                |
-         /*      */   Label(0),                //                +
-         /*      */
-         /* 42   */   c_End,
-   };
+   /// Protocol description in IRP notation. Code provides D:8,S:8,F:8,~F:8
+   static constexpr char irp[] = "{38.0k,564}<1,-1|1,-3>(16,-8,D:8,S:8,F:8,~F:8,1,^108m)(16,-4,1,^108m)*";
+
+   /// Protocol sequence compiled from IRP
+   static constexpr auto compiledSequence = compileIrp<irp>();
+
+   static constexpr const Control *protocolSequence = compiledSequence.sequence;
 
 public:
    /**
@@ -1397,20 +3394,86 @@ public:
    };
 
    /**
-    * Start transmission of sequence.
+    * Queue transmission of sequence.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   static void send(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Teac-DVD: 0x", code, Radix_16);
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence that continues while a key is held.
+    * The protocol repeat frame is sent until release() is called.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Minimum number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    */
+   static void hold(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Teac-DVD: 0x", code, Radix_16, " (held)");
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::holdSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence replacing any key press still being transmitted.
+    * The earlier transmission stops at the end of its current frame.
     *
     * @param code       Command to send
     * @param delay      Delay at end of sequence 1_tick = 1us
     * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
     */
-   static void send(Code code, unsigned delay, unsigned repeat=3) {
+   static void replace(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
 
       console.writeln("IrRemote: Teac-DVD: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
       }
-      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay);
+      IrRemote::replaceSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Transmission rendered at compile time.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    */
+   template<Code code, unsigned repeat=3>
+   static constexpr auto rendered = renderSequence<protocolSequence, code, 0, repeat>();
+
+   /**
+    * Queue transmission of sequence rendered at compile time.
+    * This avoids interpreting the protocol sequence during transmission.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    *
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   template<Code code, unsigned repeat=3>
+   static void send(unsigned delay, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Teac-DVD: 0x", code, Radix_16);
+
+      IrRemote::runRendered(rendered<code, repeat>, delay, callback);
    }
 
    /**
@@ -1442,56 +3505,16 @@ private:
    IrSamsungDVD() = delete;
    IrSamsungDVD(const IrSamsungDVD &) = delete;
 
-   inline static const Control protocolSequence[] = {
-         //       IRP: {38k,500u}<1,-1|1,-3>(9,-9,D:8,S:8,1,-9,E:4,F:8,~F:8,1,-118)+
-         //
-         /*      */   // Parameters
-         /*      */   //=======================
-         /*      */   Value(38_kHz),        // Frequency (Hz) {38k,500}
-         /*      */
-         /*      */   Value(1*500_ticks),   // 0 High (us) <1,-1|1,-3>
-         /*      */   Value(1*500_ticks),   // 0 Low  (us)
-         /*      */   Value(1*500_ticks),   // 1 High (us)
-         /*      */   Value(3*500_ticks),   // 1 Low  (us)
-         /*      */
-         /*      */   // Start of sequence
-         /*      */   //=======================
-         /*      */
-         /*      */   //-----------------------------------------
-         /*      */   //                                         | Full Repeat
-         /*      */   Repeat(0),               //                +
-         /*      */      c_Epoch_Start,        //                |
-         /*      */
-         /*      */      //--------------------------------------
-         /*      */      //                                      | Start-bit
-         /*  1   */      c_MarkSpace,          //                |
-         /*      */      Value(9*500_ticks),   // Start bit high | (9,-9)
-         /*      */      Value(9*500_ticks),   // Start bit low  |
-         /*      */
-         /*      */      //--------------------------------------
-         /*      */      //                                      | 16-bit Data
-         /* 2-33 */      Data1(16),            //                | (D:8,S:8)
-         /*      */
-         /*      */      //--------------------------------------
-         /*      */      //                                      | Middle-stop-bit
-         /*  1   */      c_MarkSpace,          //                |
-         /*      */      Value(1*500_ticks),   // Stop bit high  | (1,-9)
-         /*      */      Value(9*500_ticks),   // Stop bit low   |
-         /*      */
-         /*      */      //--------------------------------------
-         /*      */      //                                      | 20-bit Data
-         /* 2-33 */      Data2(20),            //                | (E:4,F:8,~F:8)
-         /*      */
-         /*      */      //--------------------------------------
-         /*      */      //                                      | Stop-bit
-         /* 34   */      c_MarkSpace,          //                |
-         /*      */      Value(1*500_ticks),   // Stop bit high  | (1,-118)
-         /*      */      Value(118*500_ticks), // Stop bit low   |
-         /*      */
-         /*      */   Label(0),                //
-         /*      */
-         /* 42   */   c_End,
-   };
+   /// Protocol description in IRP notation. Device provides D:8,S:8 and code provides E:4,F:8,~F:8
+   static constexpr char irp[] = "{38k,500u}<1,-1|1,-3>(9,-9,D:8,S:8,1,-9,E:4,F:8,~F:8,1,-118)+";
+
+   /// Protocol sequence compiled from IRP
+   static constexpr auto compiledSequence = compileIrp<irp>();
+
+   static constexpr const Control *protocolSequence = compiledSequence.sequence;
+
+   /// IrRegistry uses this protocol sequence for devices using the same protocol
+   friend class IrRegistry;
 
 public:
    enum Device : uint32_t {
@@ -1546,20 +3569,86 @@ public:
    };
 
    /**
-    * Start transmission of sequence.
+    * Queue transmission of sequence.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   static void send(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Samsung-DVD: 0x", code, Radix_16);
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runSequence(protocolSequence, DVD, code, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence that continues while a key is held.
+    * The protocol repeat frame is sent until release() is called.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Minimum number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    */
+   static void hold(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Samsung-DVD: 0x", code, Radix_16, " (held)");
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::holdSequence(protocolSequence, DVD, code, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence replacing any key press still being transmitted.
+    * The earlier transmission stops at the end of its current frame.
     *
     * @param code       Command to send
     * @param delay      Delay at end of sequence 1_tick = 1us
     * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
     */
-   static void send(Code code, unsigned delay, unsigned repeat=3) {
+   static void replace(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
 
       console.writeln("IrRemote: Samsung-DVD: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
       }
-      IrRemote::runSequence(protocolSequence, DVD, code, repeat, delay);
+      IrRemote::replaceSequence(protocolSequence, DVD, code, repeat, delay, callback);
+   }
+
+   /**
+    * Transmission rendered at compile time.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    */
+   template<Code code, unsigned repeat=3>
+   static constexpr auto rendered = renderSequence<protocolSequence, DVD, code, repeat>();
+
+   /**
+    * Queue transmission of sequence rendered at compile time.
+    * This avoids interpreting the protocol sequence during transmission.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    *
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   template<Code code, unsigned repeat=3>
+   static void send(unsigned delay, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Samsung-DVD: 0x", code, Radix_16);
+
+      IrRemote::runRendered(rendered<code, repeat>, delay, callback);
    }
 
    /**
@@ -1571,7 +3660,7 @@ public:
     */
    static void test(Code code, Device device=DVD, unsigned repeat=0) {
 
-      console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16);
+      console.writeln("IrRemote: Samsung-DVD: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
@@ -1582,9 +3671,9 @@ public:
 };
 
 /**
- * Class to wrap CMT hardware for Samsung DVD protocol
+ * Class to wrap CMT hardware for Panasonic DVD protocol
  *
- * Samsung DVD protocol
+ * Based on Kaseikyo protocol
  */
 class  IrPanasonicDVD : public IrRemote {
 
@@ -1593,58 +3682,18 @@ private:
    IrPanasonicDVD() = delete;
    IrPanasonicDVD(const IrPanasonicDVD &) = delete;
 
-   inline static const Control protocolSequence[] = {
-         // IRP notation: {37k,432}<1,-1|1,-3>(8,-4,2:8,32:8,D:8,S:8,F:8,(D^S^F):8,1,-173)+ 
-         //
-         /*       */   // Parameters
-         /*       */   //=======================
-         /*       */   Value(37_kHz),        // Frequency (Hz) {37k,432}
-         /*       */
-         /*       */   Value(1*432_ticks),   // 0 High (us) <1,-1|1,-3>
-         /*       */   Value(1*432_ticks),   // 0 Low  (us)
-         /*       */   Value(1*432_ticks),   // 1 High (us)
-         /*       */   Value(3*432_ticks),   // 1 Low  (us)
-         /*       */
-         /*       */   // Start of sequence
-         /*       */   //=======================
-         /*       */
-         /*       */   //----------------------------------------------
-         /*       */   //                                             | Full Repeat
-         /*       */   Repeat(0),               //                    +
-         /*      */      c_Epoch_Start,        //                |
-         /*       */
-         /*       */      //-------------------------------------------
-         /*       */      //                                          | Start-bit
-         /*  1    */      c_MarkSpace,          //                    |
-         /*       */      Value(8*432_ticks),   // Start bit high     | (8,-4)
-         /*       */      Value(4*432_ticks),   // Start bit low      |
-         /*       */
-         /*       */      //-------------------------------------------
-         /*       */      //                                          |
-         /* 2-11  */      DataImmediateLength(8), //                  | (2:8)
-         /*       */      DataImmediateHigh(2),   //                  |
-         /*       */      DataImmediateLow(2),    //                  |
-         /*       */      //                                          |
-         /* 12-21 */      DataImmediateLength(8), //                  | (32:8)
-         /*       */      DataImmediateHigh(32),  //                  |
-         /*       */      DataImmediateLow(32),   //                  |
-         /*       */      //                                          |
-         /* 22-55 */      Data1(32),              //                  | (D:8,S:8,F:8,(D^S^F):8)
-         /*       */
-         /*       */      //-------------------------------------------
-         /*       */      //                                          | Stop-bit
-         /* 56    */      c_MarkSpace,              //                |
-         /*       */      Value(1*432_ticks),       // Stop bit high  + (1,-173)
-         /*       */      Value(0),                 // -              |
-         /*       */                                //                |
-         /* 57    */      DelayHigh(173*432_ticks), // ^173           |
-         /*       */      DelayLow(173*432_ticks),  //                +
-         /*       */                                //
-         /* 58a   */   Label(0),                    //                +
-         /*       */
-         /* 58b   */   c_End,
-   };
+   /// Protocol description in IRP notation. Code provides D:8,S:8,F:8,(2^32^D^S^F):8
+   /// The check byte of the codes includes the fixed 2:8,32:8 bytes
+   static constexpr char irp[] = "{37k,432}<1,-1|1,-3>(8,-4,2:8,32:8,D:8,S:8,F:8,(2^32^D^S^F):8,1,-173)+";
+
+   /// Protocol sequence compiled from IRP
+   static constexpr auto compiledSequence = compileIrp<irp>();
 
+   static constexpr const Control *protocolSequence = compiledSequence.sequence;
+
+
+   /// IrRegistry uses this protocol sequence for devices using the same protocol
+   friend class IrRegistry;
 
 public:
    enum Device : uint32_t {
@@ -1701,20 +3750,86 @@ public:
    };
 
    /**
-    * Start transmission of sequence.
+    * Queue transmission of sequence.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   static void send(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Panasonic-DVD: 0x", code, Radix_16);
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence that continues while a key is held.
+    * The protocol repeat frame is sent until release() is called.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Minimum number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    */
+   static void hold(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Panasonic-DVD: 0x", code, Radix_16, " (held)");
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::holdSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence replacing any key press still being transmitted.
+    * The earlier transmission stops at the end of its current frame.
     *
     * @param code       Command to send
     * @param delay      Delay at end of sequence 1_tick = 1us
     * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
     */
-   static void send(Code code, unsigned delay, unsigned repeat=3) {
+   static void replace(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
 
       console.writeln("IrRemote: Panasonic-DVD: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
       }
-      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay);
+      IrRemote::replaceSequence(protocolSequence, code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Transmission rendered at compile time.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    */
+   template<Code code, unsigned repeat=3>
+   static constexpr auto rendered = renderSequence<protocolSequence, code, 0, repeat>();
+
+   /**
+    * Queue transmission of sequence rendered at compile time.
+    * This avoids interpreting the protocol sequence during transmission.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    *
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   template<Code code, unsigned repeat=3>
+   static void send(unsigned delay, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Panasonic-DVD: 0x", code, Radix_16);
+
+      IrRemote::runRendered(rendered<code, repeat>, delay, callback);
    }
 
    /**
@@ -1725,7 +3840,7 @@ public:
     */
    static void test(Code code, uint8_t repeat=0) {
 
-      console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16);
+      console.writeln("IrRemote: Panasonic-DVD: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
@@ -1735,6 +3850,69 @@ public:
 
 };
 
+/**
+ * Class to wrap CMT hardware for Kaseikyo (48-bit) protocol
+ *
+ * The whole 48-bit frame is provided as a payload so any manufacturer code
+ * and check byte may be sent e.g. Panasonic uses manufacturer code 0x2002.
+ */
+class  IrKaseikyo : public IrRemote {
+
+private:
+
+   IrKaseikyo() = delete;
+   IrKaseikyo(const IrKaseikyo &) = delete;
+
+   /// Protocol description in IRP notation. Payload provides M:16,D:8,S:8,F:8,X:8
+   static constexpr char irp[] = "{37k,432}<1,-1|1,-3>(8,-4,M:16,D:8,S:8,F:8,X:8,1,-173)+";
+
+   /// Protocol sequence compiled from IRP
+   static constexpr auto compiledSequence = compileIrp<irp, IrpFields_Payload>();
+
+   static constexpr const Control *protocolSequence = compiledSequence.sequence;
+
+public:
+   /**
+    * Kaseikyo frame payload
+    */
+   struct Frame {
+      uint8_t data[6];  ///< M:16 (LSB first), D:8, S:8, F:8, X:8
+   };
+
+   /**
+    * Construct frame
+    *
+    * @param manufacturer  Manufacturer code e.g. 0x2002 for Panasonic
+    * @param device        Device
+    * @param subDevice     Sub-device
+    * @param function      Function
+    * @param check         Check byte (manufacturer specific)
+    *
+    * @return Frame payload
+    */
+   static constexpr Frame makeFrame(uint16_t manufacturer, uint8_t device, uint8_t subDevice, uint8_t function, uint8_t check) {
+      return Frame{{uint8_t(manufacturer), uint8_t(manufacturer>>8), device, subDevice, function, check}};
+   }
+
+   /**
+    * Queue transmission of sequence.
+    *
+    * @param frame      Frame to send. This is not copied so must remain valid until sent e.g. static constexpr
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   static void send(const Frame &frame, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Kaseikyo: 0x", frame.data[2], Radix_16, ",0x", frame.data[3], Radix_16, ",0x", frame.data[4], Radix_16);
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runPayload(protocolSequence, frame.data, repeat, delay, callback);
+   }
+};
+
 /**
  * Class to wrap CMT hardware for Sony Bravia TV protocol
  *
@@ -1746,7 +3924,13 @@ private:
    IrSonyTV() = delete;
    IrSonyTV(const IrSonyTV &) = delete;
 
-   inline static const Control protocolSequence[] = {
+   /**
+    * Protocol sequence for each frame length
+    *
+    * @tparam length Frame length (12, 15 or 20 bits)
+    */
+   template<unsigned length>
+   static constexpr Control protocolSequenceFor[] = {
          //  Sony-12  {40k,600}<1,-1|2,-1>(4,-1,F:7,D:5,^45m)+
          //  Sony-15  {40k,600}<1,-1|2,-1>(4,-1,F:7,D:8,^45m)+
          //  Sony-20  {40k,600}<1,-1|2,-1>(4,-1,F:7,D:5,S:8,^45m)+
@@ -1754,6 +3938,7 @@ private:
          /*      */   // Parameters
          /*      */   //=======================
          /*      */   Value(40_kHz),        // Frequency (Hz) {40k,600}
+         /*      */   Carrier(50, CarrierDrive_High), // Carrier profile
          /*      */
          /*      */   Value(1*600_ticks),   // 0 High (us) <1,-1|2,-1>
          /*      */   Value(1*600_ticks),   // 0 Low  (us)
@@ -1776,7 +3961,7 @@ private:
          /*      */
          /*      */      //--------------------------------------
          /*      */      //                                      | 12-bit Data/15-bit Data/20-bit Data
-         /* 2-33 */      DataSony(),           //                | F:7,D:5    /F:7,D:8    /F:7,D:5,S:8
+         /* 2-33 */      Data1(length),        //                | F:7,D:5    /F:7,D:8    /F:7,D:5,S:8
          /*      */
          /*      */      //--------------------------------------
          /*      */      //                                      | Stop
@@ -1789,6 +3974,32 @@ private:
          /* 42   */   c_End,
    };
 
+   static_assert(checkSequence(protocolSequenceFor<12>));
+   static_assert(checkSequence(protocolSequenceFor<15>));
+   static_assert(checkSequence(protocolSequenceFor<20>));
+
+   /// Protocol sequence selected by length bits of code
+   static constexpr FrameVariant frameVariants[] = {
+         {SONY_LENGTH_12, protocolSequenceFor<12>},
+         {SONY_LENGTH_15, protocolSequenceFor<15>},
+         {SONY_LENGTH_20, protocolSequenceFor<20>},
+   };
+
+   /**
+    * Get protocol sequence for a code
+    *
+    * @param code Code to send
+    *
+    * @return Protocol sequence for the frame length of the code
+    */
+   static const Control *getProtocolSequence(uint32_t code) {
+      const Control *sequence = selectVariant(frameVariants, SONY_LENGTH_MASK, code);
+      usbdm_assert(sequence != nullptr, "Illegal length for Sony protocol");
+      return sequence;
+   }
+
+   /// IrRegistry uses these protocol sequences for devices using the same protocol
+   friend class IrRegistry;
 
 public:
    /**
@@ -1884,20 +4095,87 @@ public:
    };
 
    /**
-    * Start transmission of sequence.
+    * Queue transmission of sequence.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   static void send(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Sony-TV: 0x", code, Radix_16);
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runSequence(getProtocolSequence(code), code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence that continues while a key is held.
+    * The protocol repeat frame is sent until release() is called.
+    *
+    * @param code       Command to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Minimum number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    */
+   static void hold(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Sony-TV: 0x", code, Radix_16, " (held)");
+
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::holdSequence(getProtocolSequence(code), code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Queue transmission of sequence replacing any key press still being transmitted.
+    * The earlier transmission stops at the end of its current frame.
     *
     * @param code       Command to send
     * @param delay      Delay at end of sequence 1_tick = 1us
     * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
     */
-   static void send(Code code, unsigned delay, unsigned repeat=3) {
+   static void replace(Code code, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
 
       console.writeln("IrRemote: Sony-TV: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
       }
-      IrRemote::runSequence(protocolSequence, code, 0, repeat, delay);
+      IrRemote::replaceSequence(getProtocolSequence(code), code, 0, repeat, delay, callback);
+   }
+
+   /**
+    * Transmission rendered at compile time.
+    * The protocol sequence for the frame length is selected at compile time (invalid length => compile error).
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    */
+   template<Code code, unsigned repeat=3>
+   static constexpr auto rendered = renderSequence<requireVariant(frameVariants, SONY_LENGTH_MASK, code), code, 0, repeat>();
+
+   /**
+    * Queue transmission of sequence rendered at compile time.
+    * This avoids interpreting the protocol sequence during transmission.
+    *
+    * @tparam code      Command to send
+    * @tparam repeat    Number of times to repeat (including original)
+    *
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    */
+   template<Code code, unsigned repeat=3>
+   static void send(unsigned delay, CallbackFunction callback=nullptr) {
+
+      console.writeln("IrRemote: Sony-TV: 0x", code, Radix_16);
+
+      IrRemote::runRendered(rendered<code, repeat>, delay, callback);
    }
 
    /**
@@ -1908,12 +4186,12 @@ public:
     */
    static void test(Code code, uint8_t repeat=0) {
 
-      console.writeln("IrRemote: Laser-DVD: 0x", code, Radix_16);
+      console.writeln("IrRemote: Sony-TV: 0x", code, Radix_16);
 
       if (repeat == 0) {
          repeat = 3;
       }
-      IrRemote::testSequence(protocolSequence, code, 0, repeat);
+      IrRemote::testSequence(getProtocolSequence(code), code, 0, repeat);
    }
 
 };
@@ -29,6 +29,7 @@
 #include "../Project_Headers/pit.h"
 #include "../Project_Headers/adc.h"
 #include "../Project_Headers/spi.h"
+#include "../Project_Headers/ftm.h"
 
 
 // User includes
@@ -99,6 +100,11 @@ typedef Llwu::Pin<LlwuPin_Ptd4>                              TouchWakeup;
 
 typedef Pit::Channel<0>                                      ButtonTimerChannel;                           // PIT_CH0
 
+typedef Pit::Channel<1>                                      IrDelayChannel;                               // PIT_CH1
+
+/// IR Receiver capture
+typedef Ftm0::Channel<1>                                     IrCaptureChannel;                             // PTA4(p21)
+
 /// SPI, Serial Peripheral Interface
 typedef Spi0                                                 MySPI;                                        
 
@@ -0,0 +1,603 @@
+/**
+ * @file    ir-code-database.h
+ * @brief   IR code database
+ *
+ * Generated by IrCodeDatabase from "Data Files/Infrared Controller Codes.ods" exported as CSV
+ */
+
+/*
+ * *****************************
+ * *** DO NOT EDIT THIS FILE ***
+ * *****************************
+ *
+ * This file is generated automatically.
+ * Any manual changes will be lost.
+ */
+#pragma once
+
+#include "ir-code-format.h"
+
+namespace USBDM {
+
+/**
+ * IR code database - 7 devices, 340 keys, 120 key names
+ */
+class IrCodeDatabase : public IrCodeFormat {
+
+private:
+   IrCodeDatabase() = delete;
+   IrCodeDatabase(const IrCodeDatabase &) = delete;
+
+public:
+   /**
+    * Keys common to all devices (index of key name).
+    * A device only provides codes for some keys.
+    */
+   enum Key : uint8_t {
+      ANGLE, APPS, AUDIO, A_B, BLUE, CANCEL, CHANNEL, CHANNEL_DOWN, CHANNEL_UP, CLEAR, COPY_DELETE,
+      DIGITAL_ANALOG, DISCOVER, DISPLAY, DOWN, DVD_USB, EJECT, ENTER, EPG, EXIT, FAV, FOOTBALL,
+      FORWARD, FORWARD_SCENE, GOTO, GREEN, GUIDE, HELP, HOME, INFO, I_PLUS, LANGUAGE, LEFT, LIST,
+      L_R, MARK, MENU, MUTE, NUM0, NUM1, NUM10_PLUS, NUM2, NUM3, NUM4, NUM5, NUM6, NUM7, NUM8, NUM9,
+      NUM_10_PLUS, N_P, OFF, OK, ON, ON_OFF, OPTIONS, OSD, PAUSE, PAUSE_PLAY, PBC, PLAY, PLAY_PAUSE,
+      PROG, P_N, Q_PLAY, RANDOM, REC, RECALL, RECORD, RED, RELATED_SEARCH, REPEAT, RESET, RETURN,
+      REVERSE, REVERSE_SCENE, RIGHT, RIPPING, SCREEN, SEARCH, SETUP, SLOW, SOCIAL_VIEW, SOURCE,
+      SOURCE_1, SOURCE_2, SOURCE_3, SOURCE_4, SOURCE_5, SOURCE_6, SOURCE_HDMI_1, SOURCE_HDMI_2,
+      SOURCE_HDMI_3, SOURCE_HDMI_4, SOURCE_HDMI_5, SOURCE_RGB1, SOURCE_RGB2, SOURCE_TV, STANDBY,
+      STEP, STOP, SUBTITLE, SWAP, SYNC_MENU, TIME, TITLE, TITLE_MENU, TOOLS, TTX, TV_PAUSE,
+      TV_RADIO, UNKNOWN, UP, USB, USB_REC, VIDEO, VOLUME_DOWN, VOLUME_UP, YELLOW, ZOOM,
+   };
+
+protected:
+   /// Number of keys
+   static constexpr unsigned KEY_COUNT = 120;
+
+   /// Key names indexed by Key
+   static constexpr const char *keyNames[KEY_COUNT] = {
+      "ANGLE", "APPS", "AUDIO", "A_B", "BLUE", "CANCEL", "CHANNEL", "CHANNEL_DOWN", "CHANNEL_UP",
+      "CLEAR", "COPY_DELETE", "DIGITAL_ANALOG", "DISCOVER", "DISPLAY", "DOWN", "DVD_USB", "EJECT",
+      "ENTER", "EPG", "EXIT", "FAV", "FOOTBALL", "FORWARD", "FORWARD_SCENE", "GOTO", "GREEN",
+      "GUIDE", "HELP", "HOME", "INFO", "I_PLUS", "LANGUAGE", "LEFT", "LIST", "L_R", "MARK", "MENU",
+      "MUTE", "NUM0", "NUM1", "NUM10_PLUS", "NUM2", "NUM3", "NUM4", "NUM5", "NUM6", "NUM7", "NUM8",
+      "NUM9", "NUM_10_PLUS", "N_P", "OFF", "OK", "ON", "ON_OFF", "OPTIONS", "OSD", "PAUSE",
+      "PAUSE_PLAY", "PBC", "PLAY", "PLAY_PAUSE", "PROG", "P_N", "Q_PLAY", "RANDOM", "REC", "RECALL",
+      "RECORD", "RED", "RELATED_SEARCH", "REPEAT", "RESET", "RETURN", "REVERSE", "REVERSE_SCENE",
+      "RIGHT", "RIPPING", "SCREEN", "SEARCH", "SETUP", "SLOW", "SOCIAL_VIEW", "SOURCE", "SOURCE_1",
+      "SOURCE_2", "SOURCE_3", "SOURCE_4", "SOURCE_5", "SOURCE_6", "SOURCE_HDMI_1", "SOURCE_HDMI_2",
+      "SOURCE_HDMI_3", "SOURCE_HDMI_4", "SOURCE_HDMI_5", "SOURCE_RGB1", "SOURCE_RGB2", "SOURCE_TV",
+      "STANDBY", "STEP", "STOP", "SUBTITLE", "SWAP", "SYNC_MENU", "TIME", "TITLE", "TITLE_MENU",
+      "TOOLS", "TTX", "TV_PAUSE", "TV_RADIO", "UNKNOWN", "UP", "USB", "USB_REC", "VIDEO",
+      "VOLUME_DOWN", "VOLUME_UP", "YELLOW", "ZOOM",
+   };
+
+   /// Hash of key names (see hashName()) in increasing order
+   static constexpr uint32_t keyHashes[KEY_COUNT] = {
+      0x01FA7D29, 0x02F71A84, 0x0355D696, 0x038251EE, 0x043AB896, 0x06B44BC2, 0x08A55FE5, 0x09936B2B,
+      0x0A4EBBC1, 0x0C8A6CBB, 0x0D076A45, 0x0D76D520, 0x0DB6E68C, 0x103C2070, 0x10B8C84E, 0x13A4183D,
+      0x159A1BE9, 0x1B97D785, 0x1BCFD544, 0x1C5BD790, 0x1CEB8EB2, 0x2071F560, 0x2171F6F3, 0x222641E9,
+      0x2271F886, 0x22BEFB24, 0x2371FA19, 0x2471FBAC, 0x2571FD3F, 0x2671FED2, 0x26D5FB55, 0x27720065,
+      0x28AF377F, 0x2A72051E, 0x2B442933, 0x2B7206B1, 0x2CB7370D, 0x2E1505EA, 0x31542CC5, 0x3169E102,
+      0x320362E4, 0x33558C7E, 0x3367DA97, 0x3662D7FA, 0x36D11E29, 0x392519F1, 0x3D8A4CB9, 0x3FCEADFA,
+      0x43A01E7A, 0x43D29C1A, 0x4762B66D, 0x4AFFA6B9, 0x4E8E56AA, 0x4F77C23C, 0x52942765, 0x52FABBDB,
+      0x59E8D31D, 0x6030E7DB, 0x603D5B62, 0x62F38BA0, 0x6588C8EA, 0x67C6CD2E, 0x69B80B99, 0x6E81D071,
+      0x724B85CC, 0x77B49978, 0x78833D50, 0x78835328, 0x79833EE3, 0x79836105, 0x7B608A9E, 0x7B834209,
+      0x7C83439C, 0x7E8346C2, 0x7F834855, 0x80E4B050, 0x823AB694, 0x82CE9669, 0x83CE97FC, 0x85E4B82F,
+      0x92F2CAFC, 0x955428CA, 0x983EAFAF, 0x988FCA0D, 0x996BDA81, 0x9D8FCEB1, 0xA2DF200E, 0xA513AE72,
+      0xAB62935C, 0xAB854878, 0xAC85EB63, 0xAEC81E96, 0xAF0E77CE, 0xB0ABCF49, 0xB30FFCE0, 0xB3B19E25,
+      0xB57994AD, 0xB9790298, 0xBDADCF8F, 0xBFA715A3, 0xC0A71736, 0xC1A718C9, 0xC2A71A5C, 0xC3A71BEF,
+      0xC4977D4F, 0xCBAD58B8, 0xD0412E62, 0xD27DFCC4, 0xD3FFAEB8, 0xD9F8492D, 0xEA253E17, 0xEB253FAA,
+      0xF09C2391, 0xF1095F1C, 0xF2F4E026, 0xF4101F9A, 0xF6DBC48C, 0xF84F1635, 0xF8CAFA30, 0xFE488B95,
+   };
+
+   /// Key for each entry in keyHashes[]
+   static constexpr Key hashKeys[KEY_COUNT] = {
+      OSD,
+      CHANNEL,
+      SETUP,
+      REVERSE_SCENE,
+      COPY_DELETE,
+      CLEAR,
+      STOP,
+      GUIDE,
+      LIST,
+      LANGUAGE,
+      INFO,
+      RESET,
+      USB_REC,
+      LEFT,
+      HOME,
+      VOLUME_UP,
+      RELATED_SEARCH,
+      RIGHT,
+      RIPPING,
+      SYNC_MENU,
+      SOCIAL_VIEW,
+      NUM3,
+      NUM2,
+      TITLE,
+      NUM1,
+      TIME,
+      NUM0,
+      NUM7,
+      NUM6,
+      NUM5,
+      DOWN,
+      NUM4,
+      RETURN,
+      NUM9,
+      TV_RADIO,
+      NUM8,
+      BLUE,
+      OFF,
+      OPTIONS,
+      ON_OFF,
+      DIGITAL_ANALOG,
+      STANDBY,
+      TTX,
+      HELP,
+      SEARCH,
+      I_PLUS,
+      SUBTITLE,
+      FORWARD,
+      MENU,
+      FAV,
+      PAUSE,
+      AUDIO,
+      NUM_10_PLUS,
+      VOLUME_DOWN,
+      TITLE_MENU,
+      CANCEL,
+      FORWARD_SCENE,
+      NUM10_PLUS,
+      RANDOM,
+      UP,
+      REPEAT,
+      N_P,
+      UNKNOWN,
+      CHANNEL_DOWN,
+      VIDEO,
+      ANGLE,
+      SOURCE_5,
+      PAUSE_PLAY,
+      SOURCE_4,
+      EXIT,
+      PLAY_PAUSE,
+      SOURCE_6,
+      SOURCE_1,
+      SOURCE_3,
+      SOURCE_2,
+      ON,
+      MUTE,
+      REC,
+      RED,
+      OK,
+      TOOLS,
+      L_R,
+      Q_PLAY,
+      APPS,
+      USB,
+      A_B,
+      SWAP,
+      ZOOM,
+      GREEN,
+      SLOW,
+      PLAY,
+      EJECT,
+      DISCOVER,
+      YELLOW,
+      MARK,
+      REVERSE,
+      ENTER,
+      SOURCE,
+      SOURCE_TV,
+      SOURCE_HDMI_1,
+      SOURCE_HDMI_2,
+      SOURCE_HDMI_3,
+      SOURCE_HDMI_4,
+      SOURCE_HDMI_5,
+      STEP,
+      DVD_USB,
+      TV_PAUSE,
+      CHANNEL_UP,
+      FOOTBALL,
+      PROG,
+      SOURCE_RGB1,
+      SOURCE_RGB2,
+      SCREEN,
+      PBC,
+      GOTO,
+      P_N,
+      RECORD,
+      DISPLAY,
+      RECALL,
+      EPG,
+   };
+
+   /// Laser DVD key codes in key order
+   static constexpr KeyCode laserDvdKeys[] = {
+      //  Key                  F               
+      {   ANGLE,                      0x0F,    0x00 },
+      {   AUDIO,                      0x43,    0x00 },
+      {   A_B,                        0x55,    0x00 },
+      {   CHANNEL,                    0x18,    0x00 },
+      {   CLEAR,                      0x54,    0x00 },
+      {   COPY_DELETE,                0x15,    0x00 },
+      {   DOWN,                       0x48,    0x00 },
+      {   DVD_USB,                    0x07,    0x00 },
+      {   EJECT,                      0x00,    0x00 },
+      {   FORWARD,                    0x10,    0x00 },
+      {   FORWARD_SCENE,              0x1C,    0x00 },
+      {   LEFT,                       0x4C,    0x00 },
+      {   MARK,                       0x13,    0x00 },
+      {   MENU,                       0x0B,    0x00 },
+      {   MUTE,                       0x5C,    0x00 },
+      {   NUM0,                       0x4D,    0x00 },
+      {   NUM1,                       0x0D,    0x00 },
+      {   NUM2,                       0x09,    0x00 },
+      {   NUM3,                       0x05,    0x00 },
+      {   NUM4,                       0x4F,    0x00 },
+      {   NUM5,                       0x4B,    0x00 },
+      {   NUM6,                       0x47,    0x00 },
+      {   NUM7,                       0x4E,    0x00 },
+      {   NUM8,                       0x4A,    0x00 },
+      {   NUM9,                       0x46,    0x00 },
+      {   OK,                         0x06,    0x00 },
+      {   ON_OFF,                     0x0C,    0x00 },
+      {   OSD,                        0x5D,    0x00 },
+      {   PAUSE,                      0x14,    0x00 },
+      {   PAUSE_PLAY,                 0x17,    0x00 },
+      {   PBC,                        0x19,    0x00 },
+      {   PLAY,                       0x5F,    0x00 },
+      {   PROG,                       0x42,    0x00 },
+      {   Q_PLAY,                     0x16,    0x00 },
+      {   REPEAT,                     0x51,    0x00 },
+      {   RETURN,                     0x11,    0x00 },
+      {   REVERSE,                    0x57,    0x00 },
+      {   REVERSE_SCENE,              0x5B,    0x00 },
+      {   RIGHT,                      0x40,    0x00 },
+      {   SEARCH,                     0x45,    0x00 },
+      {   SETUP,                      0x03,    0x00 },
+      {   SLOW,                       0x58,    0x00 },
+      {   STEP,                       0x12,    0x00 },
+      {   STOP,                       0x0A,    0x00 },
+      {   SUBTITLE,                   0x01,    0x00 },
+      {   TITLE,                      0x50,    0x00 },
+      {   UP,                         0x44,    0x00 },
+      {   VIDEO,                      0x59,    0x00 },
+      {   VOLUME_DOWN,                0x08,    0x00 },
+      {   VOLUME_UP,                  0x04,    0x00 },
+      {   ZOOM,                       0x41,    0x00 },
+   };
+
+   /// Blaupunkt DVD key codes in key order
+   static constexpr KeyCode blaupunktDvdKeys[] = {
+      //  Key                  F               
+      {   ANGLE,                      0x0F,    0x00 },
+      {   AUDIO,                      0x42,    0x00 },
+      {   A_B,                        0x46,    0x00 },
+      {   DOWN,                       0x01,    0x00 },
+      {   EJECT,                      0x4B,    0x00 },
+      {   FORWARD,                    0x4C,    0x00 },
+      {   FORWARD_SCENE,              0x40,    0x00 },
+      {   GOTO,                       0x5D,    0x00 },
+      {   LEFT,                       0x0C,    0x00 },
+      {   L_R,                        0x16,    0x00 },
+      {   MENU,                       0x1B,    0x00 },
+      {   MUTE,                       0x1D,    0x00 },
+      {   NUM0,                       0x55,    0x00 },
+      {   NUM1,                       0x13,    0x00 },
+      {   NUM10_PLUS,                 0x11,    0x00 },
+      {   NUM2,                       0x48,    0x00 },
+      {   NUM3,                       0x5E,    0x00 },
+      {   NUM4,                       0x5F,    0x00 },
+      {   NUM5,                       0x49,    0x00 },
+      {   NUM6,                       0x53,    0x00 },
+      {   NUM7,                       0x4F,    0x00 },
+      {   NUM8,                       0x50,    0x00 },
+      {   NUM9,                       0x44,    0x00 },
+      {   OK,                         0x0D,    0x00 },
+      {   ON_OFF,                     0x00,    0x00 },
+      {   OSD,                        0x1E,    0x00 },
+      {   PLAY_PAUSE,                 0x06,    0x00 },
+      {   PROG,                       0x1F,    0x00 },
+      {   P_N,                        0x14,    0x00 },
+      {   REPEAT,                     0x07,    0x00 },
+      {   RESET,                      0x54,    0x00 },
+      {   RETURN,                     0x4E,    0x00 },
+      {   REVERSE,                    0x56,    0x00 },
+      {   REVERSE_SCENE,              0x1A,    0x00 },
+      {   RIGHT,                      0x05,    0x00 },
+      {   SETUP,                      0x0E,    0x00 },
+      {   SLOW,                       0x12,    0x00 },
+      {   STEP,                       0x04,    0x00 },
+      {   STOP,                       0x57,    0x00 },
+      {   SUBTITLE,                   0x43,    0x00 },
+      {   TITLE,                      0x09,    0x00 },
+      {   UP,                         0x02,    0x00 },
+      {   USB,                        0x15,    0x00 },
+      {   VOLUME_DOWN,                0x0B,    0x00 },
+      {   VOLUME_UP,                  0x0A,    0x00 },
+      {   ZOOM,                       0x18,    0x00 },
+   };
+
+   /// Teac PVR key codes in key order
+   static constexpr KeyCode teacPvrKeys[] = {
+      //  Key                  F               
+      {   AUDIO,                      0x51,    0x00 },
+      {   BLUE,                       0x03,    0x00 },
+      {   DOWN,                       0x16,    0x00 },
+      {   EPG,                        0x4D,    0x00 },
+      {   EXIT,                       0x05,    0x00 },
+      {   FAV,                        0x55,    0x00 },
+      {   FORWARD,                    0x48,    0x00 },
+      {   FORWARD_SCENE,              0x0B,    0x00 },
+      {   GOTO,                       0x17,    0x00 },
+      {   GREEN,                      0x40,    0x00 },
+      {   INFO,                       0x0E,    0x00 },
+      {   LEFT,                       0x5A,    0x00 },
+      {   LIST,                       0x18,    0x00 },
+      {   MENU,                       0x45,    0x00 },
+      {   MUTE,                       0x19,    0x00 },
+      {   NUM0,                       0x0F,    0x00 },
+      {   NUM1,                       0x52,    0x00 },
+      {   NUM2,                       0x50,    0x00 },
+      {   NUM3,                       0x10,    0x00 },
+      {   NUM4,                       0x56,    0x00 },
+      {   NUM5,                       0x54,    0x00 },
+      {   NUM6,                       0x14,    0x00 },
+      {   NUM7,                       0x4E,    0x00 },
+      {   NUM8,                       0x4C,    0x00 },
+      {   NUM9,                       0x0C,    0x00 },
+      {   OK,                         0x1A,    0x00 },
+      {   ON_OFF,                     0x59,    0x00 },
+      {   PAUSE,                      0x44,    0x00 },
+      {   PLAY,                       0x46,    0x00 },
+      {   REC,                        0x58,    0x00 },
+      {   RECALL,                     0x13,    0x00 },
+      {   RED,                        0x42,    0x00 },
+      {   REPEAT,                     0x07,    0x00 },
+      {   REVERSE,                    0x4A,    0x00 },
+      {   REVERSE_SCENE,              0x08,    0x00 },
+      {   RIGHT,                      0x1B,    0x00 },
+      {   STOP,                       0x04,    0x00 },
+      {   SUBTITLE,                   0x11,    0x00 },
+      {   TTX,                        0x0D,    0x00 },
+      {   TV_RADIO,                   0x15,    0x00 },
+      {   UP,                         0x06,    0x00 },
+      {   YELLOW,                     0x00,    0x00 },
+   };
+
+   /// Teac DVD key codes in key order
+   static constexpr KeyCode teacDvdKeys[] = {
+      //  Key                  F               
+      {   ANGLE,                      0x58,    0x00 },
+      {   A_B,                        0x5E,    0x00 },
+      {   CLEAR,                      0x5C,    0x00 },
+      {   DOWN,                       0x55,    0x00 },
+      {   DVD_USB,                    0x5B,    0x00 },
+      {   EJECT,                      0x08,    0x00 },
+      {   ENTER,                      0x52,    0x00 },
+      {   FORWARD,                    0x48,    0x00 },
+      {   FORWARD_SCENE,              0x4A,    0x00 },
+      {   LANGUAGE,                   0x59,    0x00 },
+      {   LEFT,                       0x51,    0x00 },
+      {   L_R,                        0x5D,    0x00 },
+      {   MENU,                       0x54,    0x00 },
+      {   MUTE,                       0x05,    0x00 },
+      {   NUM0,                       0x46,    0x00 },
+      {   NUM1,                       0x06,    0x00 },
+      {   NUM2,                       0x07,    0x00 },
+      {   NUM3,                       0x09,    0x00 },
+      {   NUM4,                       0x0A,    0x00 },
+      {   NUM5,                       0x0B,    0x00 },
+      {   NUM6,                       0x40,    0x00 },
+      {   NUM7,                       0x41,    0x00 },
+      {   NUM8,                       0x42,    0x00 },
+      {   NUM9,                       0x43,    0x00 },
+      {   NUM_10_PLUS,                0x44,    0x00 },
+      {   N_P,                        0x5D,    0x00 },
+      {   ON_OFF,                     0x04,    0x00 },
+      {   OSD,                        0x01,    0x00 },
+      {   PAUSE,                      0x4C,    0x00 },
+      {   PBC,                        0x56,    0x00 },
+      {   PLAY,                       0x4B,    0x00 },
+      {   PROG,                       0x5B,    0x00 },
+      {   RANDOM,                     0x13,    0x00 },
+      {   REPEAT,                     0x5E,    0x00 },
+      {   RESET,                      0x11,    0x00 },
+      {   RETURN,                     0x5A,    0x00 },
+      {   REVERSE,                    0x47,    0x00 },
+      {   REVERSE_SCENE,              0x49,    0x00 },
+      {   RIGHT,                      0x53,    0x00 },
+      {   RIPPING,                    0x10,    0x00 },
+      {   SETUP,                      0x4E,    0x00 },
+      {   SLOW,                       0x5C,    0x00 },
+      {   STOP,                       0x4D,    0x00 },
+      {   SUBTITLE,                   0x57,    0x00 },
+      {   TIME,                       0x00,    0x00 },
+      {   TITLE,                      0x50,    0x00 },
+      {   UP,                         0x4F,    0x00 },
+      {   VIDEO,                      0x45,    0x00 },
+      {   VOLUME_DOWN,                0x03,    0x00 },
+      {   VOLUME_UP,                  0x02,    0x00 },
+      {   ZOOM,                       0x12,    0x00 },
+   };
+
+   /// Samsung DVD key codes in key order
+   static constexpr KeyCode samsungDvdKeys[] = {
+      //  Key                  F               
+      {   ANGLE,                      0x33,    0x00 },
+      {   AUDIO,                      0x25,    0x00 },
+      {   A_B,                        0x28,    0x00 },
+      {   BLUE,                       0x24,    0x00 },
+      {   DOWN,                       0x19,    0x00 },
+      {   EJECT,                      0x01,    0x00 },
+      {   EXIT,                       0x2B,    0x00 },
+      {   FORWARD,                    0x15,    0x00 },
+      {   FORWARD_SCENE,              0x11,    0x00 },
+      {   GREEN,                      0x22,    0x00 },
+      {   HOME,                       0x16,    0x00 },
+      {   INFO,                       0x1E,    0x00 },
+      {   LEFT,                       0x1B,    0x00 },
+      {   MENU,                       0x1D,    0x00 },
+      {   NUM0,                       0x0B,    0x00 },
+      {   NUM1,                       0x02,    0x00 },
+      {   NUM2,                       0x03,    0x00 },
+      {   NUM3,                       0x04,    0x00 },
+      {   NUM4,                       0x05,    0x00 },
+      {   NUM5,                       0x06,    0x00 },
+      {   NUM6,                       0x07,    0x00 },
+      {   NUM7,                       0x08,    0x00 },
+      {   NUM8,                       0x09,    0x00 },
+      {   NUM9,                       0x0A,    0x00 },
+      {   OK,                         0x1C,    0x00 },
+      {   ON_OFF,                     0x00,    0x00 },
+      {   PAUSE,                      0x32,    0x00 },
+      {   PLAY,                       0x14,    0x00 },
+      {   RED,                        0x21,    0x00 },
+      {   REPEAT,                     0x27,    0x00 },
+      {   RETURN,                     0x17,    0x00 },
+      {   REVERSE,                    0x12,    0x00 },
+      {   REVERSE_SCENE,              0x0D,    0x00 },
+      {   RIGHT,                      0x1A,    0x00 },
+      {   SCREEN,                     0x39,    0x00 },
+      {   STOP,                       0x13,    0x00 },
+      {   SUBTITLE,                   0x26,    0x00 },
+      {   TITLE_MENU,                 0x20,    0x00 },
+      {   TOOLS,                      0x3A,    0x00 },
+      {   UP,                         0x18,    0x00 },
+      {   YELLOW,                     0x23,    0x00 },
+   };
+
+   /// Panasonic DVD key codes in key order
+   static constexpr KeyCode panasonicDvdKeys[] = {
+      //  Key                  F               X
+      {   AUDIO,                      0x33,    0x83 },
+      {   A_B,                        0x48,    0xF8 },
+      {   CANCEL,                     0x83,    0x33 },
+      {   DISPLAY,                    0x92,    0x22 },
+      {   DOWN,                       0x86,    0x36 },
+      {   EJECT,                      0x01,    0xB1 },
+      {   FORWARD,                    0x05,    0xB5 },
+      {   FORWARD_SCENE,              0x4A,    0xFA },
+      {   LEFT,                       0x87,    0x37 },
+      {   MENU,                       0x80,    0x30 },
+      {   NUM0,                       0x19,    0xA9 },
+      {   NUM1,                       0x10,    0xA0 },
+      {   NUM10_PLUS,                 0x89,    0x39 },
+      {   NUM2,                       0x11,    0xA1 },
+      {   NUM3,                       0x12,    0xA2 },
+      {   NUM4,                       0x13,    0xA3 },
+      {   NUM5,                       0x14,    0xA4 },
+      {   NUM6,                       0x15,    0xA5 },
+      {   NUM7,                       0x16,    0xA6 },
+      {   NUM8,                       0x17,    0xA7 },
+      {   NUM9,                       0x18,    0xA8 },
+      {   OK,                         0x82,    0x32 },
+      {   ON_OFF,                     0x3D,    0x8D },
+      {   PAUSE_PLAY,                 0x0A,    0xBA },
+      {   PROG,                       0x4D,    0xFD },
+      {   RANDOM,                     0x90,    0x20 },
+      {   REPEAT,                     0x8C,    0x3C },
+      {   RETURN,                     0x81,    0x31 },
+      {   REVERSE,                    0x04,    0xB4 },
+      {   REVERSE_SCENE,              0x49,    0xF9 },
+      {   RIGHT,                      0x88,    0x38 },
+      {   SEARCH,                     0xE6,    0x56 },
+      {   SETUP,                      0x94,    0x24 },
+      {   SLOW,                       0x0F,    0xBF },
+      {   STEP,                       0x0C,    0xBC },
+      {   STOP,                       0x00,    0xB0 },
+      {   SUBTITLE,                   0x91,    0x21 },
+      {   TITLE,                      0x9B,    0x2B },
+      {   UP,                         0x85,    0x35 },
+      {   USB,                        0x02,    0xB2 },
+      {   USB_REC,                    0x8A,    0x3A },
+      {   ZOOM,                       0xC1,    0x71 },
+   };
+
+   /// Sony TV key codes in key order
+   static constexpr KeyCode sonyTvKeys[] = {
+      //  Key                  F               D
+      {   APPS,                SONY15|0x7D,    0x1A },
+      {   AUDIO,                      0x17,    0x01 },
+      {   BLUE,                SONY15|0x24,    0x97 },
+      {   CHANNEL_DOWN,               0x11,    0x01 },
+      {   CHANNEL_UP,                 0x10,    0x01 },
+      {   DIGITAL_ANALOG,      SONY15|0x0D,    0x77 },
+      {   DISCOVER,            SONY15|0x73,    0x1A },
+      {   DOWN,                       0x75,    0x01 },
+      {   FOOTBALL,            SONY15|0x76,    0x1A },
+      {   FORWARD,             SONY15|0x1C,    0x97 },
+      {   GREEN,               SONY15|0x26,    0x97 },
+      {   GUIDE,               SONY15|0x5B,    0xA4 },
+      {   HELP,                SONY15|0x7B,    0x1A },
+      {   HOME,                       0x60,    0x01 },
+      {   I_PLUS,                     0x3A,    0x01 },
+      {   LEFT,                       0x34,    0x01 },
+      {   MUTE,                       0x14,    0x01 },
+      {   NUM0,                       0x09,    0x01 },
+      {   NUM1,                       0x00,    0x01 },
+      {   NUM2,                       0x01,    0x01 },
+      {   NUM3,                       0x02,    0x01 },
+      {   NUM4,                       0x03,    0x01 },
+      {   NUM5,                       0x04,    0x01 },
+      {   NUM6,                       0x05,    0x01 },
+      {   NUM7,                       0x06,    0x01 },
+      {   NUM8,                       0x07,    0x01 },
+      {   NUM9,                       0x08,    0x01 },
+      {   OFF,                        0x2F,    0x01 },
+      {   OK,                         0x65,    0x01 },
+      {   ON,                         0x2E,    0x01 },
+      {   ON_OFF,                     0x15,    0x01 },
+      {   OPTIONS,             SONY15|0x36,    0x97 },
+      {   PAUSE,               SONY15|0x19,    0x97 },
+      {   PLAY,                SONY15|0x1A,    0x97 },
+      {   RECORD,              SONY15|0x20,    0x97 },
+      {   RED,                 SONY15|0x25,    0x97 },
+      {   RELATED_SEARCH,      SONY15|0x7E,    0x1A },
+      {   RETURN,              SONY15|0x23,    0x97 },
+      {   REVERSE,             SONY15|0x1B,    0x97 },
+      {   RIGHT,                      0x33,    0x01 },
+      {   SOCIAL_VIEW,         SONY15|0x74,    0x1A },
+      {   SOURCE,                     0x25,    0x01 },
+      {   SOURCE_1,                   0x40,    0x01 },
+      {   SOURCE_2,                   0x41,    0x01 },
+      {   SOURCE_3,                   0x42,    0x01 },
+      {   SOURCE_4,                   0x47,    0x01 },
+      {   SOURCE_5,                   0x48,    0x01 },
+      {   SOURCE_6,                   0x49,    0x01 },
+      {   SOURCE_HDMI_1,       SONY15|0x5A,    0x1A },
+      {   SOURCE_HDMI_2,       SONY15|0x5B,    0x1A },
+      {   SOURCE_HDMI_3,       SONY15|0x5C,    0x1A },
+      {   SOURCE_HDMI_4,       SONY15|0x5D,    0x1A },
+      {   SOURCE_HDMI_5,       SONY15|0x5E,    0x1A },
+      {   SOURCE_RGB1,                0x43,    0x01 },
+      {   SOURCE_RGB2,                0x44,    0x01 },
+      {   SOURCE_TV,                  0x24,    0x01 },
+      {   STANDBY,             SONY15|0x2F,    0x01 },
+      {   STOP,                SONY15|0x18,    0x97 },
+      {   SWAP,                       0x3B,    0x01 },
+      {   SYNC_MENU,           SONY15|0x58,    0x1A },
+      {   TITLE,               SONY15|0x65,    0x1A },
+      {   TV_PAUSE,            SONY15|0x67,    0x1A },
+      {   UNKNOWN,             SONY15|0x28,    0x97 },
+      {   UP,                         0x74,    0x01 },
+      {   VOLUME_DOWN,                0x13,    0x01 },
+      {   VOLUME_UP,                  0x12,    0x01 },
+      {   YELLOW,              SONY15|0x27,    0x97 },
+   };
+
+   /// Devices
+   static constexpr Device devices[] = {
+      //  Name              Protocol            D     S     E     Keys
+      {   "Laser DVD",       Protocol_Nec,       0x00, 0xFF, 0x0,  sizeof(laserDvdKeys)/sizeof(laserDvdKeys[0]), laserDvdKeys },
+      {   "Blaupunkt DVD",   Protocol_Nec,       0x00, 0xFF, 0x0,  sizeof(blaupunktDvdKeys)/sizeof(blaupunktDvdKeys[0]), blaupunktDvdKeys },
+      {   "Teac PVR",        Protocol_Nec,       0x00, 0xBF, 0x0,  sizeof(teacPvrKeys)/sizeof(teacPvrKeys[0]), teacPvrKeys },
+      {   "Teac DVD",        Protocol_Nec,       0x00, 0xFF, 0x0,  sizeof(teacDvdKeys)/sizeof(teacDvdKeys[0]), teacDvdKeys },
+      {   "Samsung DVD",     Protocol_Samsung,   0x20, 0x00, 0x7,  sizeof(samsungDvdKeys)/sizeof(samsungDvdKeys[0]), samsungDvdKeys },
+      {   "Panasonic DVD",   Protocol_Panasonic, 0xB2, 0x20, 0x0,  sizeof(panasonicDvdKeys)/sizeof(panasonicDvdKeys[0]), panasonicDvdKeys },
+      {   "Sony TV",         Protocol_Sony,      0x00, 0x00, 0x0,  sizeof(sonyTvKeys)/sizeof(sonyTvKeys[0]), sonyTvKeys },
+   };
+};
+
+} // End namespace USBDM
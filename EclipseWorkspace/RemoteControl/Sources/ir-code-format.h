@@ -0,0 +1,86 @@
+/**
+ * @file    ir-code-format.h
+ * @brief   Format of the IR code database (ir-code-database.h)
+ *
+ * This is shared with the host tool (IrCodeDatabase) that generates the database.
+ */
+#pragma once
+
+#include <stdint.h>
+
+namespace USBDM {
+
+/**
+ * Records used in the IR code database.
+ *
+ * Each device record holds the protocol and the fixed address fields of the device once.
+ * Each key then needs only the function field and a key (name index).
+ * Key codes are sorted by key and key names have a hash index sorted by hash
+ * so both can be found by binary search.
+ */
+class IrCodeFormat {
+
+private:
+   IrCodeFormat() = delete;
+   IrCodeFormat(const IrCodeFormat &) = delete;
+
+public:
+   /**
+    * Protocols available for devices
+    */
+   enum Protocol : uint8_t {
+      Protocol_Nec,        ///< NEC       D:8,S:8,F:8,~F:8         e.g. IrLaserDVD
+      Protocol_Samsung,    ///< Samsung   D:8,S:8,E:4,F:8,~F:8     e.g. IrSamsungDVD
+      Protocol_Panasonic,  ///< Panasonic 2:8,32:8,D:8,S:8,F:8,X:8 e.g. IrPanasonicDVD
+      Protocol_Sony,       ///< Sony      F:7,D:5 or F:7,D:8       e.g. IrSonyTV
+      Protocol_Sony20,     ///< Sony      F:7,D:5,S:8
+   };
+
+   /// Sony function field flag for a 15-bit frame (F:7,D:8)
+   static constexpr uint8_t SONY15 = 0x80;
+
+   /**
+    * Code for a key
+    *
+    * Use of fields depends on the protocol:
+    *  - NEC, Samsung       function = F
+    *  - Panasonic          function = F, data = X
+    *  - Sony               function = F (SONY15 => 15-bit frame), data = D
+    *  - Sony20             function = F, data = D
+    */
+   struct KeyCode {
+      uint8_t  key;        ///< Key i.e. index of key name
+      uint8_t  function;   ///< Function field
+      uint8_t  data;       ///< Additional field
+   };
+
+   /**
+    * Device record
+    */
+   struct Device {
+      const char     *name;        ///< Name of device
+      Protocol        protocol;    ///< Protocol used by device
+      uint8_t         device;      ///< Device field (D) - NEC, Samsung, Panasonic
+      uint8_t         subDevice;   ///< Sub-device field (S) - NEC, Samsung, Panasonic, Sony20
+      uint8_t         extension;   ///< Extension field (E) - Samsung
+      uint8_t         keyCount;    ///< Number of entries in keys[]
+      const KeyCode  *keys;        ///< Codes for keys sorted by key
+   };
+
+   /**
+    * Hash of a key name (32-bit FNV-1a)
+    *
+    * @param name Key name e.g. "ON_OFF"
+    *
+    * @return Hash value
+    */
+   static constexpr uint32_t hashName(const char *name) {
+      uint32_t hash = 2166136261U;
+      while (*name != '\0') {
+         hash = (hash^uint8_t(*name++))*16777619U;
+      }
+      return hash;
+   }
+};
+
+} // End namespace USBDM
@@ -0,0 +1,344 @@
+/**
+ * @file    ir-decoder.h
+ * @brief   Decoding of captured IR timings into the protocols supported by cmt-remote.h
+ */
+#pragma once
+
+#include "cmt-remote.h"
+
+namespace USBDM {
+
+/**
+ * Class to decode captured IR timings e.g. from IrLearner
+ *
+ * Each protocol is matched by a tolerance based state machine described by a timing table.
+ * All the state machines are run together in a single pass over the timings so decoding
+ * is fast enough to run between frames.
+ *
+ * The decoded code has the same value as the Code of the corresponding protocol class
+ * e.g. IrLaserDVD::Code for an NEC frame or IrSonyTV::Code for a Sony frame.
+ * NEC frames are shared by IrLaserDVD, IrBlaupunktDVD, IrTeacPVR and IrTeacDVD.
+ *
+ * Example
+ * @code
+ *    IrDecoder::Result result;
+ *    if (IrDecoder::decode(timings, count, result)) {
+ *       if (result.protocol == IrDecoder::IrProtocol_Nec) {
+ *          IrLaserDVD::send(IrLaserDVD::Code(result.code), 100'000);
+ *       }
+ *    }
+ * @endcode
+ */
+class IrDecoder : public IrRemote {
+
+private:
+   IrDecoder() = delete;
+   IrDecoder(const IrDecoder &) = delete;
+
+public:
+   /**
+    * Protocols recognised
+    */
+   enum IrProtocol : uint8_t {
+      IrProtocol_None,       ///< No frame recognised
+      IrProtocol_Nec,        ///< NEC e.g. IrLaserDVD, IrBlaupunktDVD, IrTeacPVR, IrTeacDVD
+      IrProtocol_Samsung,    ///< Samsung e.g. IrSamsungDVD
+      IrProtocol_Panasonic,  ///< Panasonic e.g. IrPanasonicDVD
+      IrProtocol_Sony12,     ///< Sony 12-bit e.g. IrSonyTV
+      IrProtocol_Sony15,     ///< Sony 15-bit e.g. IrSonyTV
+      IrProtocol_Sony20,     ///< Sony 20-bit e.g. IrSonyTV
+   };
+
+   /**
+    * Decoded transmission
+    */
+   struct Result {
+      IrProtocol protocol;   ///< Protocol of first frame
+      uint8_t    device;     ///< Device field (D)
+      uint8_t    subDevice;  ///< Sub-device field (S) if present
+      uint8_t    function;   ///< Function field (F)
+      uint32_t   code;       ///< Code value used by the protocol class
+      unsigned   frames;     ///< Number of frames including repeat frames
+   };
+
+   /// Space taken to end a frame (us). Timings end with a mark which is treated as followed by a gap.
+   static constexpr unsigned MINIMUM_GAP = 5000;
+
+private:
+   /**
+    * Tolerance window for a duration.
+    * The window is 25% + 60 us either side to allow for receiver distortion.
+    * A zero duration is used for unused windows.
+    */
+   struct Window {
+      uint16_t min;     ///< Minimum duration (us)
+      uint16_t range;   ///< Width of window (us)
+
+      constexpr Window(unsigned time) :
+         min((time==0)?0:time-(time/4+60)), range((time==0)?0:2*(time/4+60)) {
+      }
+
+      /**
+       * Check if duration is within window
+       *
+       * @param time Duration to check (us)
+       *
+       * @return true => matches
+       */
+      bool matches(unsigned time) const {
+         // Single comparison as values below min wrap around
+         return unsigned(time-min) <= range;
+      }
+   };
+
+   /**
+    * Timing description of a protocol
+    */
+   struct ProtocolTiming {
+      IrProtocol protocol;        ///< Protocol (Sony12 => Sony of any length)
+      bool       markCoded;       ///< Bit value is in mark duration (Sony) rather than space duration
+      uint8_t    bits;            ///< Number of data bits (maximum for Sony)
+      uint8_t    separatorBit;    ///< Data bit preceded by separator (0 => none)
+      Window     headerMark;      ///< Leader mark
+      Window     headerSpace;     ///< Leader space
+      Window     zero;            ///< Varying duration of a 0 bit (space, or mark if markCoded)
+      Window     one;             ///< Varying duration of a 1 bit (space, or mark if markCoded)
+      Window     fixed;           ///< Fixed duration of every bit (mark, or space if markCoded) and stop mark
+      Window     separatorSpace;  ///< Space after separator mark
+      Window     repeatSpace;     ///< Leader space of repeat frame (NEC)
+   };
+
+   /**
+    * State machine phases
+    */
+   enum Phase : uint8_t {
+      Phase_Idle,         ///< Waiting for leader
+      Phase_Bits,         ///< Receiving data bits
+      Phase_Separator,    ///< Waiting for separator within data bits (Samsung)
+      Phase_Stop,         ///< Waiting for stop mark and gap
+      Phase_RepeatStop,   ///< Waiting for stop mark and gap of repeat frame
+   };
+
+   /**
+    * State of a protocol state machine
+    */
+   struct Machine {
+      Phase    phase;     ///< Current phase
+      uint8_t  bitCount;  ///< Number of data bits received
+      uint64_t data;      ///< Data bits received (LSB first)
+   };
+
+   /**
+    * Complete a frame by checking the data and converting it to a code
+    *
+    * @param timing     Protocol timing
+    * @param machine    State machine holding frame data
+    * @param result     Decoded frame
+    *
+    * @return true  => Frame is valid
+    */
+   static bool completeFrame(const ProtocolTiming &timing, const Machine &machine, Result &result) {
+
+      const uint64_t data = machine.data;
+
+      switch(timing.protocol) {
+         case IrProtocol_Nec: {
+            // D:8,S:8,F:8,~F:8
+            uint8_t function = data>>16;
+            if (uint8_t(data>>24) != uint8_t(~function)) {
+               return false;
+            }
+            result = {IrProtocol_Nec, uint8_t(data), uint8_t(data>>8), function, uint32_t(data), 1};
+            return true;
+         }
+         case IrProtocol_Samsung: {
+            // D:8,S:8,E:4,F:8,~F:8
+            uint8_t function = data>>20;
+            if (uint8_t(data>>28) != uint8_t(~function)) {
+               return false;
+            }
+            result = {IrProtocol_Samsung, uint8_t(data), uint8_t(data>>8), function, uint32_t(data>>16), 1};
+            return true;
+         }
+         case IrProtocol_Panasonic: {
+            // 2:8,32:8,D:8,S:8,F:8,X:8
+            if (uint16_t(data) != 0x2002) {
+               return false;
+            }
+            result = {IrProtocol_Panasonic, uint8_t(data>>16), uint8_t(data>>24), uint8_t(data>>32), uint32_t(data>>16), 1};
+            return true;
+         }
+         default: {
+            // Sony F:7,D:5 | F:7,D:8 | F:7,D:5,S:8
+            uint8_t function = data&0b111'1111;
+            switch(machine.bitCount) {
+               case 12:
+                  result = {IrProtocol_Sony12, uint8_t((data>>7)&0b1'1111), 0, function, 0, 1};
+                  break;
+               case 15:
+                  result = {IrProtocol_Sony15, uint8_t(data>>7), 0, function, 0, 1};
+                  break;
+               case 20:
+                  result = {IrProtocol_Sony20, uint8_t((data>>7)&0b1'1111), uint8_t(data>>12), function, 0, 1};
+                  break;
+               default:
+                  return false;
+            }
+            result.code = makeSonyCode(machine.bitCount, result.device, result.function, result.subDevice);
+            return true;
+         }
+      }
+   }
+
+   /**
+    * Advance a protocol state machine by one mark and the following space
+    *
+    * @param timing     Protocol timing
+    * @param machine    State machine
+    * @param mark       Mark duration (us)
+    * @param space      Space duration (us)
+    * @param result     Decoded frame
+    *
+    * @return 0 => No frame complete
+    * @return 1 => Data frame complete and decoded in result
+    * @return 2 => Repeat frame complete
+    */
+   static unsigned step(const ProtocolTiming &timing, Machine &machine, unsigned mark, unsigned space, Result &result) {
+
+      switch(machine.phase) {
+         case Phase_Bits: {
+            unsigned varying = timing.markCoded?mark:space;
+            unsigned fixed   = timing.markCoded?space:mark;
+            uint64_t bit;
+            if (timing.zero.matches(varying)) {
+               bit = 0;
+            }
+            else if (timing.one.matches(varying)) {
+               bit = 1;
+            }
+            else {
+               break;
+            }
+            machine.data |= bit<<machine.bitCount;
+            machine.bitCount++;
+            if (timing.markCoded) {
+               // Sony - Frame ends with gap after last bit
+               if (timing.fixed.matches(fixed) && (machine.bitCount < timing.bits)) {
+                  return 0;
+               }
+               machine.phase = Phase_Idle;
+               if (fixed >= MINIMUM_GAP) {
+                  return completeFrame(timing, machine, result)?1:0;
+               }
+               return 0;
+            }
+            if (!timing.fixed.matches(fixed)) {
+               break;
+            }
+            if (machine.bitCount == timing.bits) {
+               machine.phase = Phase_Stop;
+            }
+            else if (machine.bitCount == timing.separatorBit) {
+               machine.phase = Phase_Separator;
+            }
+            return 0;
+         }
+         case Phase_Separator:
+            if (timing.fixed.matches(mark) && timing.separatorSpace.matches(space)) {
+               machine.phase = Phase_Bits;
+               return 0;
+            }
+            break;
+         case Phase_Stop:
+            machine.phase = Phase_Idle;
+            if (timing.fixed.matches(mark) && (space >= MINIMUM_GAP)) {
+               return completeFrame(timing, machine, result)?1:0;
+            }
+            break;
+         case Phase_RepeatStop:
+            machine.phase = Phase_Idle;
+            if (timing.fixed.matches(mark) && (space >= MINIMUM_GAP)) {
+               return 2;
+            }
+            break;
+         case Phase_Idle:
+            break;
+      }
+
+      // Check for start of new frame
+      machine.phase = Phase_Idle;
+      if (timing.headerMark.matches(mark)) {
+         if (timing.headerSpace.matches(space)) {
+            machine.phase    = Phase_Bits;
+            machine.bitCount = 0;
+            machine.data     = 0;
+         }
+         else if (timing.repeatSpace.matches(space)) {
+            machine.phase    = Phase_RepeatStop;
+         }
+      }
+      return 0;
+   }
+
+public:
+   /**
+    * Decode captured timings.
+    *
+    * The protocol and code are taken from the first valid frame.
+    * Following frames with the same code, and NEC repeat frames, are counted in Result::frames.
+    *
+    * @param timings  Alternating mark and space durations in microseconds, starting with a mark
+    * @param count    Number of entries in timings
+    * @param result   Decoded transmission
+    *
+    * @return true  => A frame was decoded
+    * @return false => No frame recognised (result.protocol = IrProtocol_None)
+    */
+   static bool decode(const uint16_t timings[], unsigned count, Result &result) {
+
+      // Protocol timings in microseconds
+      static constexpr ProtocolTiming protocols[] = {
+         //  Protocol              Mark   Bits Sep  Header mark  Header space  Zero      One       Fixed     Separator  Repeat
+         {   IrProtocol_Nec,       false, 32,  0,   16*564,      8*564,        1*564,    3*564,    1*564,    0,         4*564,   },
+         {   IrProtocol_Samsung,   false, 36,  16,  9*500,       9*500,        1*500,    3*500,    1*500,    9*500,     0,       },
+         {   IrProtocol_Panasonic, false, 48,  0,   8*432,       4*432,        1*432,    3*432,    1*432,    0,         0,       },
+         {   IrProtocol_Sony12,    true,  20,  0,   4*600,       1*600,        1*600,    2*600,    1*600,    0,         0,       },
+      };
+
+      // Number of protocol state machines
+      static constexpr unsigned NUM_PROTOCOLS = sizeof(protocols)/sizeof(protocols[0]);
+
+      Machine machines[NUM_PROTOCOLS] = {};
+
+      result = {IrProtocol_None, 0, 0, 0, 0, 0};
+
+      for (unsigned index=0; index<count; index+=2) {
+         unsigned mark  = timings[index];
+         unsigned space = (index+1<count)?timings[index+1]:0xFFFF;
+
+         for (unsigned protocol=0; protocol<NUM_PROTOCOLS; protocol++) {
+            Result   frame;
+            unsigned rc = step(protocols[protocol], machines[protocol], mark, space, frame);
+            if (rc == 0) {
+               continue;
+            }
+            if (rc == 2) {
+               // Repeat frame of an earlier frame
+               if (result.protocol == protocols[protocol].protocol) {
+                  result.frames++;
+               }
+               continue;
+            }
+            if (result.protocol == IrProtocol_None) {
+               result = frame;
+            }
+            else if ((result.protocol == frame.protocol) && (result.code == frame.code)) {
+               result.frames++;
+            }
+         }
+      }
+      return result.protocol != IrProtocol_None;
+   }
+};
+
+} // End namespace USBDM
@@ -0,0 +1,171 @@
+/**
+ * @file    ir-device.h
+ * @brief   Readiness timeline of devices controlled by IR
+ */
+#pragma once
+
+#include "hardware.h"
+
+namespace USBDM {
+
+/**
+ * Time since start-up in microseconds.
+ *
+ * The button polling timer (ButtonTimerChannel) advances the time by its period on each interrupt
+ * (see tick()) and the part of the current period that has elapsed is read from the timer counter.
+ * The time does not advance while the timer interrupt is disabled e.g. while the controller sleeps.
+ */
+class IrClock {
+
+private:
+
+   /// Time at the start of the current timer period (us)
+   static inline volatile uint64_t periodStart = 0;
+
+   /// Period of the timer (us)
+   static inline volatile unsigned period = 0;
+
+   /// Last time returned
+   static inline uint64_t lastTime = 0;
+
+public:
+
+   /**
+    * Advance the time by a period of the timer.
+    * To be called from the timer interrupt.
+    *
+    * @param timerPeriod Period of the timer (us)
+    */
+   static void tick(unsigned timerPeriod) {
+      periodStart = periodStart + timerPeriod;
+      period      = timerPeriod;
+   }
+
+   /**
+    * Get time since start-up.
+    *
+    * If the timer has expired and tick() has not yet run e.g. when called from a higher priority
+    * interrupt, the counter has restarted before the period was added.
+    * The previous time is returned in this case so the time never goes backwards.
+    *
+    * @return Time (us)
+    */
+   static uint64_t now() {
+
+      CriticalSection cs;
+
+      uint32_t ticksPerMicrosecond = ButtonTimerChannel::Owner::getClockFrequency()/1000000;
+      uint32_t remaining = (ButtonTimerChannel::readCounter()+1)/ticksPerMicrosecond;
+      uint64_t time      = periodStart;
+      if (remaining < period) {
+         time += period - remaining;
+      }
+      if (time > lastTime) {
+         lastTime = time;
+      }
+      return lastTime;
+   }
+};
+
+/**
+ * Readiness timeline of a device controlled by IR.
+ *
+ * A device may ignore commands for a while after a command is received e.g. while a TV starts up.
+ * The settling time is tracked for each device rather than as a delay in the shared IR queue
+ * so commands to other devices can be sent in the meantime (see isRunnable()).
+ */
+class IrDevice {
+
+private:
+
+   /// Number of transmissions queued and not yet complete
+   volatile unsigned pending = 0;
+
+   /// Time the device is ready for the next command (us)
+   uint64_t readyAt = 0;
+
+   /// Settling time after the last transmission queued (us)
+   unsigned settleTime = 0;
+
+public:
+
+   /**
+    * Indicates if the device is ready to accept a command
+    *
+    * @return true => Ready
+    */
+   bool isReady() const {
+      return (pending == 0) && isSettled();
+   }
+
+   /**
+    * Indicates if the settling time after the last completed transmission has expired.
+    * This ignores transmissions still queued e.g. a key press that may be replaced.
+    *
+    * @return true => Settled
+    */
+   bool isSettled() const {
+      CriticalSection cs;
+      return IrClock::now() >= readyAt;
+   }
+
+   /**
+    * Record that a transmission to the device is being queued.
+    * transmitted() must be called when the transmission is complete or discarded.
+    * The transmission should be queued without a delay as the settling time is tracked here.
+    *
+    * @param delay Settling time after transmission. 1_tick = 1us
+    */
+   void transmit(unsigned delay) {
+      CriticalSection cs;
+      pending    = pending + 1;
+      settleTime = delay;
+   }
+
+   /**
+    * Record that a transmission to the device is complete.
+    * The settling time starts now.
+    */
+   void transmitted() {
+      CriticalSection cs;
+      readyAt = IrClock::now() + settleTime;
+      pending = pending - 1;
+   }
+
+   /**
+    * Check if a step of a sequence may be executed.
+    *
+    * Steps are not strictly executed in order:
+    *  - A step sending to a device waits until the device is ready and all earlier steps using the
+    *    same device have been executed. It may pass steps for other devices e.g. a DVD may be
+    *    turned on while the TV is still starting up.
+    *  - Other steps e.g. page changes wait until all earlier steps have been executed.
+    *
+    * @tparam Step      Type of step providing getDevice() and usesDevice()
+    *
+    * @param steps      Steps of sequence in order
+    * @param executed   Record of executed steps (bit mask)
+    * @param index      Index of step to check
+    *
+    * @return true => Step may be executed now
+    */
+   template<typename Step>
+   static bool isRunnable(const Step *const steps[], unsigned executed, unsigned index) {
+
+      IrDevice *device = steps[index]->getDevice();
+      if ((device != nullptr) && !device->isReady()) {
+         return false;
+      }
+      for (unsigned earlier=0; earlier<index; earlier++) {
+         if (executed & (1U<<earlier)) {
+            continue;
+         }
+         if ((device == nullptr) || steps[earlier]->usesDevice(device)) {
+            return false;
+         }
+      }
+      return true;
+   }
+};
+
+} // End namespace USBDM
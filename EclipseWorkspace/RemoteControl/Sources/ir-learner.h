@@ -0,0 +1,347 @@
+/**
+ * @file    ir-learner.h
+ * @brief   Capture of IR remote transmissions using FTM input capture and DMA
+ */
+#pragma once
+
+#include "hardware.h"
+#include "../Project_Headers/ftm.h"
+#include "../Project_Headers/dma.h"
+
+namespace USBDM {
+
+/**
+ * Class to capture raw timings from an IR remote using the IR receiver
+ *
+ * The demodulated receiver output (IrReceiver, PTA4) is connected to IrCaptureChannel (FTM0.CH1)
+ * while learning. Every edge is time-stamped by input capture and the capture value is transferred
+ * by DMA into a ring buffer so there is no interrupt per edge.
+ *
+ * The ring buffer is drained by the timer overflow interrupt i.e. once every 65536 timer ticks (~44 ms).
+ * This converts the time-stamps to mark and space durations and detects the end of the transmission.
+ * Capture ends on the first interval longer than the silence gap. The timings are then passed to the
+ * call-back.
+ *
+ * Example
+ * @code
+ *    static void learnt(const uint16_t timings[], unsigned count) {
+ *       // timings[] = mark, space, mark ... mark (us)
+ *    }
+ *
+ *    IrLearner::start(learnt, 20'000_ticks);
+ * @endcode
+ */
+class IrLearner {
+
+private:
+   IrLearner() = delete;
+   IrLearner(const IrLearner &) = delete;
+
+public:
+   /**
+    * Call-back on completion of capture.
+    * This is executed in interrupt context.
+    *
+    * @param timings  Alternating mark and space durations in microseconds, starting and ending with a mark
+    * @param count    Number of entries in timings
+    */
+   typedef void (*LearnCallback)(const uint16_t timings[], unsigned count);
+
+   /// Maximum number of timings captured (capture ends when full)
+   static constexpr unsigned MAX_TIMINGS = 512;
+
+   /// Number of time-stamps in DMA ring buffer. This must hold all edges within one timer period.
+   static constexpr unsigned RING_SIZE = 256;
+
+   /// Default silence gap ending capture
+   static constexpr Ticks DEFAULT_SILENCE = 20'000_ticks;
+
+private:
+   /// Timer used to time-stamp edges
+   using Timer = IrCaptureChannel::OwningFtm;
+
+   /// Timer ticks in one timer period (free-running 16-bit counter)
+   static constexpr uint32_t TIMER_PERIOD = 0x10000;
+
+   /// Time-stamps written by DMA. Aligned for ring buffer wrap.
+   inline static uint16_t ring[RING_SIZE] __attribute__((aligned(sizeof(uint16_t)*RING_SIZE)));
+
+   /// Index of next time-stamp to process in ring buffer
+   inline static unsigned ringIndex;
+
+   /// Mark and space durations (us)
+   inline static uint16_t timings[MAX_TIMINGS];
+
+   /// Number of entries in timings[]
+   inline static unsigned timingCount;
+
+   /// Time of start of current timer period (timer ticks)
+   inline static uint32_t periodStart;
+
+   /// Time of last edge (timer ticks)
+   inline static uint32_t lastEdge;
+
+   /// At least one edge has been captured
+   inline static bool started;
+
+   /// Silence gap ending capture (timer ticks)
+   inline static uint32_t silenceInTimerTicks;
+
+   /// Capture is in progress
+   inline static volatile bool busy = false;
+
+   /// Call-back on completion
+   inline static LearnCallback learnCallback = nullptr;
+
+   /// DMA channel used for capture
+   inline static DmaChannelNum dmaChannel = DmaChannelNum_None;
+
+   /**
+    * Allocate and configure DMA channel for capture.
+    * The channel is retained for re-use.
+    *
+    * @return E_NO_ERROR on success
+    * @return E_NO_RESOURCE if failed to allocate DMA channel
+    */
+   static ErrorCode initialiseDma() {
+
+      if (dmaChannel != DmaChannelNum_None) {
+         return E_NO_ERROR;
+      }
+
+      // Allocate DMA channel to use for capture
+      dmaChannel = Dma0::allocateChannel();
+      if (dmaChannel == DmaChannelNum_None) {
+         return setErrorCode(E_NO_RESOURCE);
+      }
+      Dma0::enableClock();
+
+      // Connect DMA channel to timer channel
+      Dmamux0::configure(dmaChannel, Dma0Slot_FTM0_Ch1, DmamuxMode_Continuous);
+
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Start DMA transfer of captured time-stamps to the ring buffer.
+    * The transfer wraps around the ring buffer indefinitely.
+    */
+   static void startDma() {
+
+      /**
+       * Structure to define the DMA transfer
+       *
+       * Each request copies one time-stamp from FTM.CnV
+       */
+      DmaTcd tcd = DmaTcd (
+         {  /* Source */
+            /* Address                  */ IrCaptureChannel::ftmCnV(),  // Source is FTM.CnV
+            /* Offset                   */ 0,                           // Source address doesn't change
+            /* Size                     */ DmaSize_16bit,               // 16-bit read from source address
+         },
+         {  /* Destination */
+            /* Address                  */ (uint32_t)(uintptr_t)ring,   // Destination is ring buffer
+            /* Offset                   */ sizeof(ring[0]),             // Destination address advances 2 bytes per write
+            /* Size                     */ DmaSize_16bit,               // 16-bit write to destination address
+            /* Last adjustment          */ -int32_t(sizeof(ring)),      // Return to start of ring buffer
+         },
+         /* Minor loop byte count       */ sizeof(ring[0]),             // One time-stamp per request
+         /* Minor loop offset select    */ DmaMinorLoopOffsetSelect_None,
+         /* Minor loop offset           */ 0,
+         /* Major loop count            */ dmaCiter(RING_SIZE),         // Once around ring buffer
+
+         {  // CSR
+           /* Stop on complete          */ DmaStopOnComplete_Disabled,  // Continue around ring buffer
+           /* Interrupt on complete     */ DmaIntMajor_Disabled,        // No interrupts
+         }
+      );
+
+      Dma0::configureTransfer(dmaChannel, tcd);
+      Dma0::enableRequest(dmaChannel);
+   }
+
+   /**
+    * Get index in ring buffer of next time-stamp to be written by DMA
+    *
+    * @return Index in ring
+    */
+   static unsigned getRingWriteIndex() {
+      uint32_t destination = Dma0Info::dma->TCD[dmaChannel].DADDR;
+      return ((destination-(uint32_t)(uintptr_t)ring)/sizeof(ring[0]))%RING_SIZE;
+   }
+
+   /**
+    * Stop capture hardware and return pin to GPIO
+    */
+   static void stopHardware() {
+      Timer::disableTimerOverflowInterrupts();
+      IrCaptureChannel::disable();
+      Timer::stopCounter();
+      if (dmaChannel != DmaChannelNum_None) {
+         Dma0::disableRequest(dmaChannel);
+      }
+      IrReceiver::setInput();
+   }
+
+   /**
+    * Complete capture and pass timings to application
+    */
+   static void captureComplete() {
+      stopHardware();
+      busy = false;
+      if (learnCallback != nullptr) {
+         learnCallback(timings, timingCount);
+      }
+   }
+
+   /**
+    * Record an edge
+    *
+    * @param time Time of edge (timer ticks)
+    *
+    * @return true  => Capture is complete
+    */
+   static bool addEdge(uint32_t time) {
+
+      if (!started) {
+         // First edge starts mark
+         started  = true;
+         lastEdge = time;
+         return false;
+      }
+      uint32_t interval = time-lastEdge;
+      if (interval >= silenceInTimerTicks) {
+         // Silence before this edge ends the transmission
+         return true;
+      }
+      lastEdge = time;
+      timings[timingCount++] = Timer::convertTicksToMicroseconds(Ticks(interval));
+      return timingCount >= MAX_TIMINGS;
+   }
+
+   /**
+    * Call-back from timer overflow.
+    *
+    * Converts time-stamps in the ring buffer to durations and checks for the silence gap.
+    * Edges captured after the overflow (while this handler is pending) have a time-stamp no
+    * greater than the current count. Interrupt latency is assumed to be much less than the timer period.
+    */
+   static void timerOverflowCallback() {
+
+      Timer::clearOverflowFlag();
+
+      // Ring index must be obtained before the current time
+      unsigned writeIndex = getRingWriteIndex();
+      uint16_t now        = Timer::getTime();
+
+      bool wrapped = false;
+      while (ringIndex != writeIndex) {
+         uint16_t timeStamp = ring[ringIndex];
+         ringIndex = (ringIndex+1)%RING_SIZE;
+         if (!wrapped && (timeStamp <= now)) {
+            // First edge after overflow
+            periodStart += TIMER_PERIOD;
+            wrapped      = true;
+         }
+         if (addEdge(periodStart+timeStamp)) {
+            captureComplete();
+            return;
+         }
+      }
+      if (!wrapped) {
+         periodStart += TIMER_PERIOD;
+      }
+      if (started && ((periodStart+now-lastEdge) >= silenceInTimerTicks)) {
+         captureComplete();
+      }
+   }
+
+public:
+   /**
+    * Start capture of an IR transmission.
+    * Capture begins on the first edge and ends when no edges are seen for the silence gap,
+    * when MAX_TIMINGS have been captured or when stop() is called.
+    *
+    * @param callback   Call-back executed with the captured timings
+    * @param silence    Silence gap ending the capture 1_tick = 1us (<= 65535 so every timing fits in 16 bits)
+    *
+    * @return E_NO_ERROR on success
+    * @return E_NO_RESOURCE if failed to allocate DMA channel
+    */
+   static ErrorCode start(LearnCallback callback, Ticks silence = DEFAULT_SILENCE) {
+
+      usbdm_assert(unsigned(silence) <= 0xFFFF, "Silence gap too long");
+
+      if (busy) {
+         stopHardware();
+      }
+
+      ErrorCode rc = initialiseDma();
+      if (rc != E_NO_ERROR) {
+         return rc;
+      }
+
+      learnCallback = callback;
+      timingCount   = 0;
+      ringIndex     = 0;
+      periodStart   = 0;
+      started       = false;
+      busy          = true;
+
+      // Free-running timer at 1.5 MHz (48 MHz bus clock / 32)
+      Timer::configure(FtmCountMode_LeftAligned, FtmClockSource_SystemClock, FtmPrescale_DivBy32);
+      Timer::setCounterMaximumValue(Ticks(TIMER_PERIOD-1));
+      Timer::resetTime();
+      silenceInTimerTicks = (uint64_t(unsigned(silence))*Timer::getTickFrequencyAsInt())/1'000'000;
+
+      startDma();
+
+      // Capture either edge and request DMA transfer of time-stamp
+      IrCaptureChannel::configure(FtmChannelMode_InputCaptureEitherEdge, FtmChannelAction_Dma);
+      IrCaptureChannel::Pcr::setPCR();
+
+      Timer::setTimerOverflowCallback(timerOverflowCallback);
+      Timer::clearOverflowFlag();
+      Timer::enableTimerOverflowInterrupts();
+      Timer::enableNvicInterrupts(NvicPriority_Low);
+
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Abandon capture in progress.
+    * The call-back is not executed.
+    */
+   static void stop() {
+      CriticalSection cs;
+
+      if (busy) {
+         stopHardware();
+         busy = false;
+      }
+   }
+
+   /**
+    * Check if capture is in progress
+    *
+    * @return true  => Capture in progress
+    * @return false => Idle
+    */
+   static bool isBusy() {
+      return busy;
+   }
+
+   /**
+    * Get timings from last completed capture
+    *
+    * @param count   Number of entries in timings
+    *
+    * @return Alternating mark and space durations in microseconds, starting with a mark
+    */
+   static const uint16_t *getTimings(unsigned &count) {
+      count = timingCount;
+      return timings;
+   }
+};
+
+} // End namespace USBDM
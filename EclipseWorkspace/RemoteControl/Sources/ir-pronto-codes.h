@@ -0,0 +1,180 @@
+/**
+ * @file    ir-pronto-codes.h
+ * @brief   IR codes converted from Pronto hex
+ *
+ * Generated by ProntoConverter from "Data Files/Pronto Codes.txt"
+ */
+
+/*
+ * *****************************
+ * *** DO NOT EDIT THIS FILE ***
+ * *****************************
+ *
+ * This file is generated automatically.
+ * Any manual changes will be lost.
+ */
+#pragma once
+
+#include "ir-pronto.h"
+
+namespace USBDM {
+
+/**
+ * IR codes converted from Pronto hex - 6 codes, 130 cycles
+ */
+class IrProntoCodes : public IrPronto {
+
+private:
+   IrProntoCodes() = delete;
+   IrProntoCodes(const IrProntoCodes &) = delete;
+
+   /// Modulator cycles of all sequences 1_tick = 1us
+   static constexpr CmtCycle cycles[] = {
+      //  Mark   Space  Extended
+      {{  8993,  4497, false }},  // 0
+      {{   552,   552, false }},  // 1
+      {{   552,   552, false }},  // 2
+      {{   552,   552, false }},  // 3
+      {{   552,   552, false }},  // 4
+      {{   552,   552, false }},  // 5
+      {{   552,   552, false }},  // 6
+      {{   552,   552, false }},  // 7
+      {{   552,   552, false }},  // 8
+      {{   552,  1683, false }},  // 9
+      {{   552,  1683, false }},  // 10
+      {{   552,  1683, false }},  // 11
+      {{   552,  1683, false }},  // 12
+      {{   552,  1683, false }},  // 13
+      {{   552,  1683, false }},  // 14
+      {{   552,  1683, false }},  // 15
+      {{   552,  1683, false }},  // 16
+      {{   552,   552, false }},  // 17
+      {{   552,   552, false }},  // 18
+      {{   552,  1683, false }},  // 19
+      {{   552,  1683, false }},  // 20
+      {{   552,   552, false }},  // 21
+      {{   552,   552, false }},  // 22
+      {{   552,   552, false }},  // 23
+      {{   552,   552, false }},  // 24
+      {{   552,  1683, false }},  // 25
+      {{   552,  1683, false }},  // 26
+      {{   552,   552, false }},  // 27
+      {{   552,   552, false }},  // 28
+      {{   552,  1683, false }},  // 29
+      {{   552,  1683, false }},  // 30
+      {{   552,  1683, false }},  // 31
+      {{   552,  1683, false }},  // 32
+      {{   552, 40022, false }},  // 33
+      {{     1,     0, true  }},  // 34
+      {{  8993,  4497, false }},  // 35
+      {{   552,   552, false }},  // 36
+      {{   552,   552, false }},  // 37
+      {{   552,   552, false }},  // 38
+      {{   552,   552, false }},  // 39
+      {{   552,   552, false }},  // 40
+      {{   552,   552, false }},  // 41
+      {{   552,   552, false }},  // 42
+      {{   552,   552, false }},  // 43
+      {{   552,  1683, false }},  // 44
+      {{   552,  1683, false }},  // 45
+      {{   552,  1683, false }},  // 46
+      {{   552,  1683, false }},  // 47
+      {{   552,  1683, false }},  // 48
+      {{   552,  1683, false }},  // 49
+      {{   552,  1683, false }},  // 50
+      {{   552,  1683, false }},  // 51
+      {{   552,   552, false }},  // 52
+      {{   552,   552, false }},  // 53
+      {{   552,  1683, false }},  // 54
+      {{   552,   552, false }},  // 55
+      {{   552,   552, false }},  // 56
+      {{   552,   552, false }},  // 57
+      {{   552,   552, false }},  // 58
+      {{   552,   552, false }},  // 59
+      {{   552,  1683, false }},  // 60
+      {{   552,  1683, false }},  // 61
+      {{   552,   552, false }},  // 62
+      {{   552,  1683, false }},  // 63
+      {{   552,  1683, false }},  // 64
+      {{   552,  1683, false }},  // 65
+      {{   552,  1683, false }},  // 66
+      {{   552,  1683, false }},  // 67
+      {{   552, 40022, false }},  // 68
+      {{     1,     0, true  }},  // 69
+      {{  2410,   596, false }},  // 70
+      {{  1193,   596, false }},  // 71
+      {{   596,   596, false }},  // 72
+      {{  1193,   596, false }},  // 73
+      {{   596,   596, false }},  // 74
+      {{  1193,   596, false }},  // 75
+      {{   596,   596, false }},  // 76
+      {{   596,   596, false }},  // 77
+      {{  1193,   596, false }},  // 78
+      {{   596,   596, false }},  // 79
+      {{   596,   596, false }},  // 80
+      {{   596,   596, false }},  // 81
+      {{   596, 25793, false }},  // 82
+      {{     1,     0, true  }},  // 83
+      {{  2410,   596, false }},  // 84
+      {{   596,   596, false }},  // 85
+      {{  1193,   596, false }},  // 86
+      {{  1193,   596, false }},  // 87
+      {{  1193,   596, false }},  // 88
+      {{   596,   596, false }},  // 89
+      {{  1193,   596, false }},  // 90
+      {{   596,   596, false }},  // 91
+      {{  1193,   596, false }},  // 92
+      {{   596,   596, false }},  // 93
+      {{   596,   596, false }},  // 94
+      {{   596,   596, false }},  // 95
+      {{   596, 25196, false }},  // 96
+      {{     1,     0, true  }},  // 97
+      {{   888,   888, false }},  // 98
+      {{  1776,   888, false }},  // 99
+      {{   888,   888, false }},  // 100
+      {{   888,   888, false }},  // 101
+      {{   888,   888, false }},  // 102
+      {{   888,   888, false }},  // 103
+      {{   888,   888, false }},  // 104
+      {{   888,   888, false }},  // 105
+      {{   888,  1776, false }},  // 106
+      {{   888,   888, false }},  // 107
+      {{  1776,   888, false }},  // 108
+      {{   888, 65535, false }},  // 109
+      {{ 12565, 12565, true  }},  // 110
+      {{     1,     0, true  }},  // 111
+      {{   888,   888, false }},  // 112
+      {{  1776,   888, false }},  // 113
+      {{   888,   888, false }},  // 114
+      {{   888,   888, false }},  // 115
+      {{   888,   888, false }},  // 116
+      {{   888,   888, false }},  // 117
+      {{   888,   888, false }},  // 118
+      {{   888,   888, false }},  // 119
+      {{   888,  1776, false }},  // 120
+      {{   888,   888, false }},  // 121
+      {{  1776,  1776, false }},  // 122
+      {{   888, 65535, false }},  // 123
+      {{ 12121, 12121, true  }},  // 124
+      {{     1,     0, true  }},  // 125
+      {{  8993,  2261, false }},  // 126
+      {{   552, 65535, false }},  // 127
+      {{ 15328, 15327, true  }},  // 128
+      {{     1,     0, true  }},  // 129
+   };
+
+public:
+   // Laser DVD
+   static constexpr ProntoCode LaserDvd_ON_OFF          = { 38029,  35,   4, cycles+0   , cycles+126  };
+   static constexpr ProntoCode LaserDvd_VOLUME_UP       = { 38029,  35,   4, cycles+35  , cycles+126  };
+
+   // Sony TV
+   static constexpr ProntoCode SonyTv_ON_OFF            = { 40244,   0,  14, nullptr    , cycles+70   };
+   static constexpr ProntoCode SonyTv_ON                = { 40244,   0,  14, nullptr    , cycles+84   };
+
+   // Philips TV
+   static constexpr ProntoCode PhilipsTv_STANDBY        = { 36045,   0,  14, nullptr    , cycles+98   };
+   static constexpr ProntoCode PhilipsTv_MUTE           = { 36045,   0,  14, nullptr    , cycles+112  };
+};
+
+} // End namespace USBDM
@@ -0,0 +1,78 @@
+/**
+ * @file    ir-pronto.h
+ * @brief   Transmission of codes converted from Pronto hex
+ */
+#pragma once
+
+#include "cmt-remote.h"
+
+namespace USBDM {
+
+/**
+ * Class to transmit codes converted from Pronto hex by the ProntoConverter host tool.
+ *
+ * This allows devices using an unsupported protocol to be added without writing a protocol sequence.
+ * The once and repeat sequences of each code are converted to modulator cycles at build time
+ * (see ir-pronto-codes.h) so they are transmitted directly (DMA or interrupt) without interpretation.
+ * Sequences are shared between codes where the timings are the same.
+ *
+ * @note The remote controller does not send any Pronto codes yet. The codes in ir-pronto-codes.h
+ *       are samples checked by the IR simulator. They will be used when a device without a protocol
+ *       class is added to the pages.
+ *
+ * Example
+ * @code
+ *    // Once sequence followed by 2 repeat sequences
+ *    IrPronto::send(IrProntoCodes::PhilipsTv_STANDBY, 2, 100'000);
+ * @endcode
+ */
+class IrPronto : public IrRemote {
+
+private:
+   IrPronto() = delete;
+   IrPronto(const IrPronto &) = delete;
+
+public:
+   /**
+    * Code converted from Pronto hex.
+    * Each sequence ends with the dummy cycle used to complete a transmission.
+    */
+   struct ProntoCode {
+      uint16_t        frequency;     ///< Carrier frequency (Hz)
+      uint16_t        onceCount;     ///< Number of cycles in once sequence (0 => none)
+      uint16_t        repeatCount;   ///< Number of cycles in repeat sequence (0 => none)
+      const CmtCycle *once;          ///< Once sequence i.e. sent at start of transmission
+      const CmtCycle *repeat;        ///< Repeat sequence i.e. sent while key is held
+   };
+
+   /**
+    * Queue transmission of a code converted from Pronto hex.
+    * This returns immediately unless the queue is full.
+    *
+    * The once sequence is sent followed by the repeat sequence the given number of times.
+    * At least one sequence is sent.
+    *
+    * @param code       Code to send
+    * @param repeat     Number of times to send repeat sequence
+    * @param delay      Delay at end of transmission 1_tick = 1us
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    */
+   static void send(const ProntoCode &code, unsigned repeat, unsigned delay, CallbackFunction callback=nullptr) {
+
+      if (code.repeatCount == 0) {
+         repeat = 0;
+      }
+      else if ((code.onceCount == 0) && (repeat == 0)) {
+         repeat = 1;
+      }
+      if (code.onceCount > 0) {
+         // Delay and call-back are on the last sequence only
+         runCycles(code.frequency, code.once, code.onceCount, (repeat==0)?delay:0, (repeat==0)?callback:nullptr);
+      }
+      while (repeat-- > 0) {
+         runCycles(code.frequency, code.repeat, code.repeatCount, (repeat==0)?delay:0, (repeat==0)?callback:nullptr);
+      }
+   }
+};
+
+} // End namespace USBDM
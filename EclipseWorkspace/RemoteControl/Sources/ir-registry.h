@@ -0,0 +1,738 @@
+/**
+ * @file    ir-registry.h
+ * @brief   Table driven registry of IR devices
+ */
+#pragma once
+
+#include <string.h>
+#include <initializer_list>
+#include "cmt-remote.h"
+#include "ir-code-database.h"
+
+namespace USBDM {
+
+/**
+ * Class to send IR commands to devices described by a table.
+ *
+ * Each device is a record holding a protocol, the fixed address fields for the device
+ * and a compact table of key codes. All records are constant so they are located in flash.
+ * A device costs about 16 bytes plus 3 bytes per key rather than a class per device.
+ * The records are generated from the code spreadsheet (see ir-code-database.h).
+ * Key codes and key names are found by binary search.
+ *
+ * A single transmit path builds the code from the record and uses the protocol sequence
+ * of the class implementing that protocol.
+ * The codes are the same as those of the per-device classes e.g.
+ * IrRegistry::getCode(device, IrRegistry::ON_OFF) == IrTeacPVR::ON_OFF for the Teac PVR record.
+ * This is checked at compile time for every code of each class (see checkCodes()).
+ *
+ * Example
+ * @code
+ *    const IrRegistry::Device *device = IrRegistry::findDevice("Teac PVR");
+ *    if (device != nullptr) {
+ *       IrRegistry::send(*device, IrRegistry::ON_OFF, 100_ticks);
+ *    }
+ * @endcode
+ */
+class IrRegistry : public IrRemote, public IrCodeDatabase {
+
+private:
+   IrRegistry() = delete;
+   IrRegistry(const IrRegistry &) = delete;
+
+public:
+   /// Value returned by getCode() for a key not provided by the device
+   static constexpr uint32_t NO_CODE = -1U;
+
+private:
+   /// Protocol sequence for each protocol. These are shared with the per-device classes.
+   static constexpr const Control *protocolSequences[] = {
+         IrLaserDVD::protocolSequence,      // Protocol_Nec
+         IrSamsungDVD::protocolSequence,    // Protocol_Samsung
+         IrPanasonicDVD::protocolSequence,  // Protocol_Panasonic
+         nullptr,                           // Protocol_Sony   - selected by frame length
+         nullptr,                           // Protocol_Sony20 - selected by frame length
+   };
+
+   /**
+    * Find code for a key and obtain the protocol sequence and data items
+    *
+    * @param device     Device to send to
+    * @param key        Key to send
+    * @param sequence   Protocol sequence
+    * @param data1      First data item
+    * @param data2      Second data item
+    *
+    * @return E_NO_ERROR on success
+    * @return E_ILLEGAL_PARAM if the device does not provide the key
+    */
+   static ErrorCode getDataItems(const Device &device, Key key, const Control *&sequence, uint32_t &data1, uint32_t &data2) {
+
+      uint32_t code = getCode(device, key);
+      if (code == NO_CODE) {
+         return setErrorCode(E_ILLEGAL_PARAM);
+      }
+      sequence = protocolSequences[device.protocol];
+      if (sequence == nullptr) {
+         // Sony frame length is given by the code
+         sequence = IrSonyTV::getProtocolSequence(code);
+      }
+      if (device.protocol == Protocol_Samsung) {
+         // Device provides D:8,S:8 and code provides E:4,F:8,~F:8
+         data1 = device.device|(device.subDevice<<8);
+         data2 = code;
+      }
+      else {
+         data1 = code;
+         data2 = 0;
+      }
+      console.writeln("IrRemote: ", device.name, ": 0x", code, Radix_16);
+      return E_NO_ERROR;
+   }
+
+public:
+   /**
+    * Get number of devices in registry
+    *
+    * @return Number of devices
+    */
+   static constexpr unsigned getDeviceCount() {
+      return sizeof(devices)/sizeof(devices[0]);
+   }
+
+   /**
+    * Get device record
+    *
+    * @param index Index of device [0..getDeviceCount()-1]
+    *
+    * @return Device record
+    */
+   static constexpr const Device &getDevice(unsigned index) {
+      return devices[index];
+   }
+
+   /**
+    * Find device by name.
+    * This may be used at compile time e.g. to bind an action to a device record.
+    *
+    * @param name Name of device e.g. "Teac PVR"
+    *
+    * @return Device record or nullptr if not found
+    */
+   static constexpr const Device *findDevice(const char *name) {
+      for (const Device &device : devices) {
+         const char *deviceName = device.name;
+         const char *searchName = name;
+         while ((*deviceName != '\0') && (*deviceName == *searchName)) {
+            deviceName++;
+            searchName++;
+         }
+         if (*deviceName == *searchName) {
+            return &device;
+         }
+      }
+      return nullptr;
+   }
+
+   /**
+    * Construct code in the format used by the protocol class for the device
+    *
+    * @param device   Device record
+    * @param keyCode  Key code from device record
+    *
+    * @return Code as used by the per-device class
+    */
+   static constexpr uint32_t makeCode(const Device &device, const KeyCode &keyCode) {
+
+      const uint8_t function = keyCode.function;
+
+      switch(device.protocol) {
+         case Protocol_Nec:
+            return device.device|(device.subDevice<<8)|(function<<16)|(uint8_t(~function)<<24);
+         case Protocol_Samsung:
+            return device.extension|(function<<4)|(uint8_t(~function)<<12);
+         case Protocol_Panasonic:
+            return device.device|(device.subDevice<<8)|(function<<16)|(keyCode.data<<24);
+         case Protocol_Sony:
+            return makeSonyCode((function&SONY15)?15:12, keyCode.data, function&~SONY15, 0);
+         case Protocol_Sony20:
+            return makeSonyCode(20, keyCode.data, function, device.subDevice);
+      }
+      return NO_CODE;
+   }
+
+   /**
+    * Get code for a key
+    *
+    * @param device  Device record
+    * @param key     Key
+    *
+    * @return Code as used by the per-device class or NO_CODE if the device does not provide the key
+    */
+   static constexpr uint32_t getCode(const Device &device, Key key) {
+      // Binary search of key codes (sorted by key)
+      unsigned low  = 0;
+      unsigned high = device.keyCount;
+      while (low < high) {
+         unsigned mid = (low+high)/2;
+         if (device.keys[mid].key < key) {
+            low = mid+1;
+         }
+         else {
+            high = mid;
+         }
+      }
+      if ((low < device.keyCount) && (device.keys[low].key == key)) {
+         return makeCode(device, device.keys[low]);
+      }
+      return NO_CODE;
+   }
+
+   /**
+    * Key and the code used by a per-device class for the key (see checkCodes())
+    *
+    * @tparam IrClass  Per-device class
+    */
+   template<typename IrClass>
+   struct CodeCheck {
+      Key                     key;    ///< Key in registry
+      typename IrClass::Code  code;   ///< Code used by class
+   };
+
+   /**
+    * Check that the codes of a per-device class are the same as those of the registry record.
+    * This is intended for use in static_assert().
+    *
+    * @tparam IrClass  Per-device class
+    *
+    * @param name    Name of device record e.g. "Teac PVR"
+    * @param checks  Key and class code for each code of the class
+    *
+    * @return true  => All codes are the same
+    * @return false => Device not found or a code differs
+    */
+   template<typename IrClass>
+   static constexpr bool checkCodes(const char *name, std::initializer_list<CodeCheck<IrClass>> checks) {
+      const Device *device = findDevice(name);
+      if (device == nullptr) {
+         return false;
+      }
+      for (const CodeCheck<IrClass> &check : checks) {
+         if (getCode(*device, check.key) != check.code) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /**
+    * Get name of key
+    *
+    * @param key Key
+    *
+    * @return Name e.g. "ON_OFF"
+    */
+   static constexpr const char *getKeyName(Key key) {
+      return keyNames[key];
+   }
+
+   /**
+    * Find key by name
+    *
+    * @param name Name of key e.g. "ON_OFF"
+    * @param key  Key found
+    *
+    * @return true  => Key found
+    * @return false => No key has this name
+    */
+   static bool findKey(const char *name, Key &key) {
+      // Binary search of name hashes
+      uint32_t hash = hashName(name);
+      unsigned low  = 0;
+      unsigned high = KEY_COUNT;
+      while (low < high) {
+         unsigned mid = (low+high)/2;
+         if (keyHashes[mid] < hash) {
+            low = mid+1;
+         }
+         else {
+            high = mid;
+         }
+      }
+      // Hash values are unique so only a single name needs to be checked
+      if ((low < KEY_COUNT) && (keyHashes[low] == hash) && (strcmp(keyNames[hashKeys[low]], name) == 0)) {
+         key = hashKeys[low];
+         return true;
+      }
+      return false;
+   }
+
+   /**
+    * Estimate the time the IR LED is driven when sending a key.
+    * The carrier profile of the protocol is used.
+    *
+    * @param device     Device to send to
+    * @param key        Key to send
+    * @param repeat     Number of times to repeat (including original)
+    *
+    * @return LED on-time (us) or 0 if the device does not provide the key
+    */
+   static uint32_t estimateLedOnTime(const Device &device, Key key, unsigned repeat=1) {
+
+      const Control *sequence;
+      uint32_t data1, data2;
+      if (getDataItems(device, key, sequence, data1, data2) != E_NO_ERROR) {
+         return 0;
+      }
+      return IrRemote::estimateLedOnTime(sequence, data1, data2, repeat);
+   }
+
+   /**
+    * Queue transmission of key.
+    *
+    * @param device     Device to send to
+    * @param key        Key to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    *
+    * @return E_NO_ERROR on success
+    * @return E_ILLEGAL_PARAM if the device does not provide the key
+    */
+   static ErrorCode send(const Device &device, Key key, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      const Control *sequence;
+      uint32_t data1, data2;
+      ErrorCode rc = getDataItems(device, key, sequence, data1, data2);
+      if (rc != E_NO_ERROR) {
+         return rc;
+      }
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::runSequence(sequence, data1, data2, repeat, delay, callback);
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Queue transmission of key that continues while the key is held.
+    * The protocol repeat frame is sent until release() is called.
+    *
+    * @param device     Device to send to
+    * @param key        Key to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Minimum number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay complete
+    *
+    * @return E_NO_ERROR on success
+    * @return E_ILLEGAL_PARAM if the device does not provide the key
+    */
+   static ErrorCode hold(const Device &device, Key key, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      const Control *sequence;
+      uint32_t data1, data2;
+      ErrorCode rc = getDataItems(device, key, sequence, data1, data2);
+      if (rc != E_NO_ERROR) {
+         return rc;
+      }
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::holdSequence(sequence, data1, data2, repeat, delay, callback);
+      return E_NO_ERROR;
+   }
+
+   /**
+    * Queue transmission of key replacing any key press still being transmitted.
+    * The earlier transmission stops at the end of its current frame.
+    *
+    * @param device     Device to send to
+    * @param key        Key to send
+    * @param delay      Delay at end of sequence 1_tick = 1us
+    * @param repeat     Number of times to repeat (including original). 0 => use default for protocol
+    * @param callback   Called (from interrupt) when transmission and delay are complete
+    *
+    * @return E_NO_ERROR on success
+    * @return E_ILLEGAL_PARAM if the device does not provide the key
+    */
+   static ErrorCode replace(const Device &device, Key key, unsigned delay, unsigned repeat=3, CallbackFunction callback=nullptr) {
+
+      const Control *sequence;
+      uint32_t data1, data2;
+      ErrorCode rc = getDataItems(device, key, sequence, data1, data2);
+      if (rc != E_NO_ERROR) {
+         return rc;
+      }
+      if (repeat == 0) {
+         repeat = 3;
+      }
+      IrRemote::replaceSequence(sequence, data1, data2, repeat, delay, callback);
+      return E_NO_ERROR;
+   }
+};
+
+/*
+ * Check the registry records against the per-device classes
+ */
+static_assert(IrRegistry::checkCodes<IrLaserDVD>("Laser DVD", {
+      { IrRegistry::A_B,           IrLaserDVD::A_B           },
+      { IrRegistry::ANGLE,         IrLaserDVD::ANGLE         },
+      { IrRegistry::AUDIO,         IrLaserDVD::AUDIO         },
+      { IrRegistry::CHANNEL,       IrLaserDVD::CHANNEL       },
+      { IrRegistry::CLEAR,         IrLaserDVD::CLEAR         },
+      { IrRegistry::COPY_DELETE,   IrLaserDVD::COPY_DELETE   },
+      { IrRegistry::DOWN,          IrLaserDVD::DOWN          },
+      { IrRegistry::DVD_USB,       IrLaserDVD::DVD_USB       },
+      { IrRegistry::EJECT,         IrLaserDVD::EJECT         },
+      { IrRegistry::FORWARD,       IrLaserDVD::FORWARD       },
+      { IrRegistry::FORWARD_SCENE, IrLaserDVD::FORWARD_SCENE },
+      { IrRegistry::LEFT,          IrLaserDVD::LEFT          },
+      { IrRegistry::MARK,          IrLaserDVD::MARK          },
+      { IrRegistry::MENU,          IrLaserDVD::MENU          },
+      { IrRegistry::MUTE,          IrLaserDVD::MUTE          },
+      { IrRegistry::NUM0,          IrLaserDVD::NUM0          },
+      { IrRegistry::NUM1,          IrLaserDVD::NUM1          },
+      { IrRegistry::NUM2,          IrLaserDVD::NUM2          },
+      { IrRegistry::NUM3,          IrLaserDVD::NUM3          },
+      { IrRegistry::NUM4,          IrLaserDVD::NUM4          },
+      { IrRegistry::NUM5,          IrLaserDVD::NUM5          },
+      { IrRegistry::NUM6,          IrLaserDVD::NUM6          },
+      { IrRegistry::NUM7,          IrLaserDVD::NUM7          },
+      { IrRegistry::NUM8,          IrLaserDVD::NUM8          },
+      { IrRegistry::NUM9,          IrLaserDVD::NUM9          },
+      { IrRegistry::OK,            IrLaserDVD::OK            },
+      { IrRegistry::ON_OFF,        IrLaserDVD::ON_OFF        },
+      { IrRegistry::OSD,           IrLaserDVD::OSD           },
+      { IrRegistry::PAUSE,         IrLaserDVD::PAUSE         },
+      { IrRegistry::PAUSE_PLAY,    IrLaserDVD::PAUSE_PLAY    },
+      { IrRegistry::PBC,           IrLaserDVD::PBC           },
+      { IrRegistry::PLAY,          IrLaserDVD::PLAY          },
+      { IrRegistry::PROG,          IrLaserDVD::PROG          },
+      { IrRegistry::Q_PLAY,        IrLaserDVD::Q_PLAY        },
+      { IrRegistry::REPEAT,        IrLaserDVD::REPEAT        },
+      { IrRegistry::RETURN,        IrLaserDVD::RETURN        },
+      { IrRegistry::REVERSE,       IrLaserDVD::REVERSE       },
+      { IrRegistry::REVERSE_SCENE, IrLaserDVD::REVERSE_SCENE },
+      { IrRegistry::RIGHT,         IrLaserDVD::RIGHT         },
+      { IrRegistry::SEARCH,        IrLaserDVD::SEARCH        },
+      { IrRegistry::SETUP,         IrLaserDVD::SETUP         },
+      { IrRegistry::SLOW,          IrLaserDVD::SLOW          },
+      { IrRegistry::STEP,          IrLaserDVD::STEP          },
+      { IrRegistry::STOP,          IrLaserDVD::STOP          },
+      { IrRegistry::SUBTITLE,      IrLaserDVD::SUBTITLE      },
+      { IrRegistry::TITLE,         IrLaserDVD::TITLE         },
+      { IrRegistry::UP,            IrLaserDVD::UP            },
+      { IrRegistry::VIDEO,         IrLaserDVD::VIDEO         },
+      { IrRegistry::VOLUME_DOWN,   IrLaserDVD::VOLUME_DOWN   },
+      { IrRegistry::VOLUME_UP,     IrLaserDVD::VOLUME_UP     },
+      { IrRegistry::ZOOM,          IrLaserDVD::ZOOM          },
+}), "IR registry codes differ from IrLaserDVD");
+
+static_assert(IrRegistry::checkCodes<IrBlaupunktDVD>("Blaupunkt DVD", {
+      { IrRegistry::A_B,           IrBlaupunktDVD::A_B           },
+      { IrRegistry::ANGLE,         IrBlaupunktDVD::ANGLE         },
+      { IrRegistry::AUDIO,         IrBlaupunktDVD::AUDIO         },
+      { IrRegistry::DOWN,          IrBlaupunktDVD::DOWN          },
+      { IrRegistry::EJECT,         IrBlaupunktDVD::EJECT         },
+      { IrRegistry::FORWARD,       IrBlaupunktDVD::FORWARD       },
+      { IrRegistry::FORWARD_SCENE, IrBlaupunktDVD::FORWARD_SCENE },
+      { IrRegistry::GOTO,          IrBlaupunktDVD::GOTO          },
+      { IrRegistry::L_R,           IrBlaupunktDVD::L_R           },
+      { IrRegistry::LEFT,          IrBlaupunktDVD::LEFT          },
+      { IrRegistry::MENU,          IrBlaupunktDVD::MENU          },
+      { IrRegistry::MUTE,          IrBlaupunktDVD::MUTE          },
+      { IrRegistry::NUM0,          IrBlaupunktDVD::NUM0          },
+      { IrRegistry::NUM1,          IrBlaupunktDVD::NUM1          },
+      { IrRegistry::NUM10_PLUS,    IrBlaupunktDVD::NUM10_PLUS    },
+      { IrRegistry::NUM2,          IrBlaupunktDVD::NUM2          },
+      { IrRegistry::NUM3,          IrBlaupunktDVD::NUM3          },
+      { IrRegistry::NUM4,          IrBlaupunktDVD::NUM4          },
+      { IrRegistry::NUM5,          IrBlaupunktDVD::NUM5          },
+      { IrRegistry::NUM6,          IrBlaupunktDVD::NUM6          },
+      { IrRegistry::NUM7,          IrBlaupunktDVD::NUM7          },
+      { IrRegistry::NUM8,          IrBlaupunktDVD::NUM8          },
+      { IrRegistry::NUM9,          IrBlaupunktDVD::NUM9          },
+      { IrRegistry::OK,            IrBlaupunktDVD::OK            },
+      { IrRegistry::ON_OFF,        IrBlaupunktDVD::ON_OFF        },
+      { IrRegistry::OSD,           IrBlaupunktDVD::OSD           },
+      { IrRegistry::P_N,           IrBlaupunktDVD::P_N           },
+      { IrRegistry::PLAY_PAUSE,    IrBlaupunktDVD::PLAY_PAUSE    },
+      { IrRegistry::PROG,          IrBlaupunktDVD::PROG          },
+      { IrRegistry::REPEAT,        IrBlaupunktDVD::REPEAT        },
+      { IrRegistry::RESET,         IrBlaupunktDVD::RESET         },
+      { IrRegistry::RETURN,        IrBlaupunktDVD::RETURN        },
+      { IrRegistry::REVERSE,       IrBlaupunktDVD::REVERSE       },
+      { IrRegistry::REVERSE_SCENE, IrBlaupunktDVD::REVERSE_SCENE },
+      { IrRegistry::RIGHT,         IrBlaupunktDVD::RIGHT         },
+      { IrRegistry::SETUP,         IrBlaupunktDVD::SETUP         },
+      { IrRegistry::SLOW,          IrBlaupunktDVD::SLOW          },
+      { IrRegistry::STEP,          IrBlaupunktDVD::STEP          },
+      { IrRegistry::STOP,          IrBlaupunktDVD::STOP          },
+      { IrRegistry::SUBTITLE,      IrBlaupunktDVD::SUBTITLE      },
+      { IrRegistry::TITLE,         IrBlaupunktDVD::TITLE         },
+      { IrRegistry::UP,            IrBlaupunktDVD::UP            },
+      { IrRegistry::USB,           IrBlaupunktDVD::USB           },
+      { IrRegistry::VOLUME_DOWN,   IrBlaupunktDVD::VOLUME_DOWN   },
+      { IrRegistry::VOLUME_UP,     IrBlaupunktDVD::VOLUME_UP     },
+      { IrRegistry::ZOOM,          IrBlaupunktDVD::ZOOM          },
+}), "IR registry codes differ from IrBlaupunktDVD");
+
+static_assert(IrRegistry::checkCodes<IrTeacPVR>("Teac PVR", {
+      { IrRegistry::AUDIO,         IrTeacPVR::AUDIO         },
+      { IrRegistry::BLUE,          IrTeacPVR::BLUE          },
+      { IrRegistry::DOWN,          IrTeacPVR::DOWN          },
+      { IrRegistry::EPG,           IrTeacPVR::EPG           },
+      { IrRegistry::EXIT,          IrTeacPVR::EXIT          },
+      { IrRegistry::FAV,           IrTeacPVR::FAV           },
+      { IrRegistry::FORWARD,       IrTeacPVR::FORWARD       },
+      { IrRegistry::FORWARD_SCENE, IrTeacPVR::FORWARD_SCENE },
+      { IrRegistry::GOTO,          IrTeacPVR::GOTO          },
+      { IrRegistry::GREEN,         IrTeacPVR::GREEN         },
+      { IrRegistry::INFO,          IrTeacPVR::INFO          },
+      { IrRegistry::LEFT,          IrTeacPVR::LEFT          },
+      { IrRegistry::LIST,          IrTeacPVR::LIST          },
+      { IrRegistry::MENU,          IrTeacPVR::MENU          },
+      { IrRegistry::MUTE,          IrTeacPVR::MUTE          },
+      { IrRegistry::NUM0,          IrTeacPVR::NUM0          },
+      { IrRegistry::NUM1,          IrTeacPVR::NUM1          },
+      { IrRegistry::NUM2,          IrTeacPVR::NUM2          },
+      { IrRegistry::NUM3,          IrTeacPVR::NUM3          },
+      { IrRegistry::NUM4,          IrTeacPVR::NUM4          },
+      { IrRegistry::NUM5,          IrTeacPVR::NUM5          },
+      { IrRegistry::NUM6,          IrTeacPVR::NUM6          },
+      { IrRegistry::NUM7,          IrTeacPVR::NUM7          },
+      { IrRegistry::NUM8,          IrTeacPVR::NUM8          },
+      { IrRegistry::NUM9,          IrTeacPVR::NUM9          },
+      { IrRegistry::OK,            IrTeacPVR::OK            },
+      { IrRegistry::ON_OFF,        IrTeacPVR::ON_OFF        },
+      { IrRegistry::PAUSE,         IrTeacPVR::PAUSE         },
+      { IrRegistry::PLAY,          IrTeacPVR::PLAY          },
+      { IrRegistry::REC,           IrTeacPVR::REC           },
+      { IrRegistry::RECALL,        IrTeacPVR::RECALL        },
+      { IrRegistry::RED,           IrTeacPVR::RED           },
+      { IrRegistry::REPEAT,        IrTeacPVR::REPEAT        },
+      { IrRegistry::REVERSE,       IrTeacPVR::REVERSE       },
+      { IrRegistry::REVERSE_SCENE, IrTeacPVR::REVERSE_SCENE },
+      { IrRegistry::RIGHT,         IrTeacPVR::RIGHT         },
+      { IrRegistry::STOP,          IrTeacPVR::STOP          },
+      { IrRegistry::SUBTITLE,      IrTeacPVR::SUBTITLE      },
+      { IrRegistry::TTX,           IrTeacPVR::TTX           },
+      { IrRegistry::TV_RADIO,      IrTeacPVR::TV_RADIO      },
+      { IrRegistry::UP,            IrTeacPVR::UP            },
+      { IrRegistry::YELLOW,        IrTeacPVR::YELLOW        },
+}), "IR registry codes differ from IrTeacPVR");
+
+static_assert(IrRegistry::checkCodes<IrTeacDVD>("Teac DVD", {
+      { IrRegistry::A_B,           IrTeacDVD::A_B           },
+      { IrRegistry::ANGLE,         IrTeacDVD::ANGLE         },
+      { IrRegistry::CLEAR,         IrTeacDVD::CLEAR         },
+      { IrRegistry::DOWN,          IrTeacDVD::DOWN          },
+      { IrRegistry::DVD_USB,       IrTeacDVD::DVD_USB       },
+      { IrRegistry::EJECT,         IrTeacDVD::EJECT         },
+      { IrRegistry::ENTER,         IrTeacDVD::ENTER         },
+      { IrRegistry::FORWARD,       IrTeacDVD::FORWARD       },
+      { IrRegistry::FORWARD_SCENE, IrTeacDVD::FORWARD_SCENE },
+      { IrRegistry::L_R,           IrTeacDVD::L_R           },
+      { IrRegistry::LANGUAGE,      IrTeacDVD::LANGUAGE      },
+      { IrRegistry::LEFT,          IrTeacDVD::LEFT          },
+      { IrRegistry::MENU,          IrTeacDVD::MENU          },
+      { IrRegistry::MUTE,          IrTeacDVD::MUTE          },
+      { IrRegistry::N_P,           IrTeacDVD::N_P           },
+      { IrRegistry::NUM_10_PLUS,   IrTeacDVD::NUM_10_PLUS   },
+      { IrRegistry::NUM0,          IrTeacDVD::NUM0          },
+      { IrRegistry::NUM1,          IrTeacDVD::NUM1          },
+      { IrRegistry::NUM2,          IrTeacDVD::NUM2          },
+      { IrRegistry::NUM3,          IrTeacDVD::NUM3          },
+      { IrRegistry::NUM4,          IrTeacDVD::NUM4          },
+      { IrRegistry::NUM5,          IrTeacDVD::NUM5          },
+      { IrRegistry::NUM6,          IrTeacDVD::NUM6          },
+      { IrRegistry::NUM7,          IrTeacDVD::NUM7          },
+      { IrRegistry::NUM8,          IrTeacDVD::NUM8          },
+      { IrRegistry::NUM9,          IrTeacDVD::NUM9          },
+      { IrRegistry::ON_OFF,        IrTeacDVD::ON_OFF        },
+      { IrRegistry::OSD,           IrTeacDVD::OSD           },
+      { IrRegistry::PAUSE,         IrTeacDVD::PAUSE         },
+      { IrRegistry::PBC,           IrTeacDVD::PBC           },
+      { IrRegistry::PLAY,          IrTeacDVD::PLAY          },
+      { IrRegistry::PROG,          IrTeacDVD::PROG          },
+      { IrRegistry::RANDOM,        IrTeacDVD::RANDOM        },
+      { IrRegistry::REPEAT,        IrTeacDVD::REPEAT        },
+      { IrRegistry::RESET,         IrTeacDVD::RESET         },
+      { IrRegistry::RETURN,        IrTeacDVD::RETURN        },
+      { IrRegistry::REVERSE,       IrTeacDVD::REVERSE       },
+      { IrRegistry::REVERSE_SCENE, IrTeacDVD::REVERSE_SCENE },
+      { IrRegistry::RIGHT,         IrTeacDVD::RIGHT         },
+      { IrRegistry::RIPPING,       IrTeacDVD::RIPPING       },
+      { IrRegistry::SETUP,         IrTeacDVD::SETUP         },
+      { IrRegistry::SLOW,          IrTeacDVD::SLOW          },
+      { IrRegistry::STOP,          IrTeacDVD::STOP          },
+      { IrRegistry::SUBTITLE,      IrTeacDVD::SUBTITLE      },
+      { IrRegistry::TIME,          IrTeacDVD::TIME          },
+      { IrRegistry::TITLE,         IrTeacDVD::TITLE         },
+      { IrRegistry::UP,            IrTeacDVD::UP            },
+      { IrRegistry::VIDEO,         IrTeacDVD::VIDEO         },
+      { IrRegistry::VOLUME_DOWN,   IrTeacDVD::VOLUME_DOWN   },
+      { IrRegistry::VOLUME_UP,     IrTeacDVD::VOLUME_UP     },
+      { IrRegistry::ZOOM,          IrTeacDVD::ZOOM          },
+}), "IR registry codes differ from IrTeacDVD");
+
+static_assert(IrRegistry::checkCodes<IrSamsungDVD>("Samsung DVD", {
+      { IrRegistry::A_B,           IrSamsungDVD::A_B           },
+      { IrRegistry::ANGLE,         IrSamsungDVD::ANGLE         },
+      { IrRegistry::AUDIO,         IrSamsungDVD::AUDIO         },
+      { IrRegistry::BLUE,          IrSamsungDVD::BLUE          },
+      { IrRegistry::DOWN,          IrSamsungDVD::DOWN          },
+      { IrRegistry::EJECT,         IrSamsungDVD::EJECT         },
+      { IrRegistry::EXIT,          IrSamsungDVD::EXIT          },
+      { IrRegistry::FORWARD,       IrSamsungDVD::FORWARD       },
+      { IrRegistry::FORWARD_SCENE, IrSamsungDVD::FORWARD_SCENE },
+      { IrRegistry::GREEN,         IrSamsungDVD::GREEN         },
+      { IrRegistry::HOME,          IrSamsungDVD::HOME          },
+      { IrRegistry::INFO,          IrSamsungDVD::INFO          },
+      { IrRegistry::LEFT,          IrSamsungDVD::LEFT          },
+      { IrRegistry::MENU,          IrSamsungDVD::MENU          },
+      { IrRegistry::NUM0,          IrSamsungDVD::NUM0          },
+      { IrRegistry::NUM1,          IrSamsungDVD::NUM1          },
+      { IrRegistry::NUM2,          IrSamsungDVD::NUM2          },
+      { IrRegistry::NUM3,          IrSamsungDVD::NUM3          },
+      { IrRegistry::NUM4,          IrSamsungDVD::NUM4          },
+      { IrRegistry::NUM5,          IrSamsungDVD::NUM5          },
+      { IrRegistry::NUM6,          IrSamsungDVD::NUM6          },
+      { IrRegistry::NUM7,          IrSamsungDVD::NUM7          },
+      { IrRegistry::NUM8,          IrSamsungDVD::NUM8          },
+      { IrRegistry::NUM9,          IrSamsungDVD::NUM9          },
+      { IrRegistry::OK,            IrSamsungDVD::OK            },
+      { IrRegistry::ON_OFF,        IrSamsungDVD::ON_OFF        },
+      { IrRegistry::PAUSE,         IrSamsungDVD::PAUSE         },
+      { IrRegistry::PLAY,          IrSamsungDVD::PLAY          },
+      { IrRegistry::RED,           IrSamsungDVD::RED           },
+      { IrRegistry::REPEAT,        IrSamsungDVD::REPEAT        },
+      { IrRegistry::RETURN,        IrSamsungDVD::RETURN        },
+      { IrRegistry::REVERSE,       IrSamsungDVD::REVERSE       },
+      { IrRegistry::REVERSE_SCENE, IrSamsungDVD::REVERSE_SCENE },
+      { IrRegistry::RIGHT,         IrSamsungDVD::RIGHT         },
+      { IrRegistry::SCREEN,        IrSamsungDVD::SCREEN        },
+      { IrRegistry::STOP,          IrSamsungDVD::STOP          },
+      { IrRegistry::SUBTITLE,      IrSamsungDVD::SUBTITLE      },
+      { IrRegistry::TITLE_MENU,    IrSamsungDVD::TITLE_MENU    },
+      { IrRegistry::TOOLS,         IrSamsungDVD::TOOLS         },
+      { IrRegistry::UP,            IrSamsungDVD::UP            },
+      { IrRegistry::YELLOW,        IrSamsungDVD::YELLOW        },
+}), "IR registry codes differ from IrSamsungDVD");
+
+static_assert(IrRegistry::checkCodes<IrPanasonicDVD>("Panasonic DVD", {
+      { IrRegistry::A_B,           IrPanasonicDVD::A_B           },
+      { IrRegistry::AUDIO,         IrPanasonicDVD::AUDIO         },
+      { IrRegistry::CANCEL,        IrPanasonicDVD::CANCEL        },
+      { IrRegistry::DISPLAY,       IrPanasonicDVD::DISPLAY       },
+      { IrRegistry::DOWN,          IrPanasonicDVD::DOWN          },
+      { IrRegistry::EJECT,         IrPanasonicDVD::EJECT         },
+      { IrRegistry::FORWARD,       IrPanasonicDVD::FORWARD       },
+      { IrRegistry::FORWARD_SCENE, IrPanasonicDVD::FORWARD_SCENE },
+      { IrRegistry::LEFT,          IrPanasonicDVD::LEFT          },
+      { IrRegistry::MENU,          IrPanasonicDVD::MENU          },
+      { IrRegistry::NUM0,          IrPanasonicDVD::NUM0          },
+      { IrRegistry::NUM1,          IrPanasonicDVD::NUM1          },
+      { IrRegistry::NUM10_PLUS,    IrPanasonicDVD::NUM10_PLUS    },
+      { IrRegistry::NUM2,          IrPanasonicDVD::NUM2          },
+      { IrRegistry::NUM3,          IrPanasonicDVD::NUM3          },
+      { IrRegistry::NUM4,          IrPanasonicDVD::NUM4          },
+      { IrRegistry::NUM5,          IrPanasonicDVD::NUM5          },
+      { IrRegistry::NUM6,          IrPanasonicDVD::NUM6          },
+      { IrRegistry::NUM7,          IrPanasonicDVD::NUM7          },
+      { IrRegistry::NUM8,          IrPanasonicDVD::NUM8          },
+      { IrRegistry::NUM9,          IrPanasonicDVD::NUM9          },
+      { IrRegistry::OK,            IrPanasonicDVD::OK            },
+      { IrRegistry::ON_OFF,        IrPanasonicDVD::ON_OFF        },
+      { IrRegistry::PAUSE_PLAY,    IrPanasonicDVD::PAUSE_PLAY    },
+      { IrRegistry::PROG,          IrPanasonicDVD::PROG          },
+      { IrRegistry::RANDOM,        IrPanasonicDVD::RANDOM        },
+      { IrRegistry::REPEAT,        IrPanasonicDVD::REPEAT        },
+      { IrRegistry::RETURN,        IrPanasonicDVD::RETURN        },
+      { IrRegistry::REVERSE,       IrPanasonicDVD::REVERSE       },
+      { IrRegistry::REVERSE_SCENE, IrPanasonicDVD::REVERSE_SCENE },
+      { IrRegistry::RIGHT,         IrPanasonicDVD::RIGHT         },
+      { IrRegistry::SEARCH,        IrPanasonicDVD::SEARCH        },
+      { IrRegistry::SETUP,         IrPanasonicDVD::SETUP         },
+      { IrRegistry::SLOW,          IrPanasonicDVD::SLOW          },
+      { IrRegistry::STEP,          IrPanasonicDVD::STEP          },
+      { IrRegistry::STOP,          IrPanasonicDVD::STOP          },
+      { IrRegistry::SUBTITLE,      IrPanasonicDVD::SUBTITLE      },
+      { IrRegistry::TITLE,         IrPanasonicDVD::TITLE         },
+      { IrRegistry::UP,            IrPanasonicDVD::UP            },
+      { IrRegistry::USB,           IrPanasonicDVD::USB           },
+      { IrRegistry::USB_REC,       IrPanasonicDVD::USB_REC       },
+      { IrRegistry::ZOOM,          IrPanasonicDVD::ZOOM          },
+}), "IR registry codes differ from IrPanasonicDVD");
+
+static_assert(IrRegistry::checkCodes<IrSonyTV>("Sony TV", {
+      { IrRegistry::APPS,           IrSonyTV::APPS           },
+      { IrRegistry::AUDIO,          IrSonyTV::AUDIO          },
+      { IrRegistry::BLUE,           IrSonyTV::BLUE           },
+      { IrRegistry::CHANNEL_DOWN,   IrSonyTV::CHANNEL_DOWN   },
+      { IrRegistry::CHANNEL_UP,     IrSonyTV::CHANNEL_UP     },
+      { IrRegistry::DIGITAL_ANALOG, IrSonyTV::DIGITAL_ANALOG },
+      { IrRegistry::DISCOVER,       IrSonyTV::DISCOVER       },
+      { IrRegistry::DOWN,           IrSonyTV::DOWN           },
+      { IrRegistry::FOOTBALL,       IrSonyTV::FOOTBALL       },
+      { IrRegistry::FORWARD,        IrSonyTV::FORWARD        },
+      { IrRegistry::GREEN,          IrSonyTV::GREEN          },
+      { IrRegistry::GUIDE,          IrSonyTV::GUIDE          },
+      { IrRegistry::HELP,           IrSonyTV::HELP           },
+      { IrRegistry::HOME,           IrSonyTV::HOME           },
+      { IrRegistry::I_PLUS,         IrSonyTV::I_PLUS         },
+      { IrRegistry::LEFT,           IrSonyTV::LEFT           },
+      { IrRegistry::MUTE,           IrSonyTV::MUTE           },
+      { IrRegistry::NUM0,           IrSonyTV::NUM0           },
+      { IrRegistry::NUM1,           IrSonyTV::NUM1           },
+      { IrRegistry::NUM2,           IrSonyTV::NUM2           },
+      { IrRegistry::NUM3,           IrSonyTV::NUM3           },
+      { IrRegistry::NUM4,           IrSonyTV::NUM4           },
+      { IrRegistry::NUM5,           IrSonyTV::NUM5           },
+      { IrRegistry::NUM6,           IrSonyTV::NUM6           },
+      { IrRegistry::NUM7,           IrSonyTV::NUM7           },
+      { IrRegistry::NUM8,           IrSonyTV::NUM8           },
+      { IrRegistry::NUM9,           IrSonyTV::NUM9           },
+      { IrRegistry::OK,             IrSonyTV::OK             },
+      { IrRegistry::ON_OFF,         IrSonyTV::ON_OFF         },
+      { IrRegistry::ON,             IrSonyTV::ON             },
+      { IrRegistry::OFF,            IrSonyTV::OFF            },
+      { IrRegistry::OPTIONS,        IrSonyTV::OPTIONS        },
+      { IrRegistry::PAUSE,          IrSonyTV::PAUSE          },
+      { IrRegistry::PLAY,           IrSonyTV::PLAY           },
+      { IrRegistry::RECORD,         IrSonyTV::RECORD         },
+      { IrRegistry::RED,            IrSonyTV::RED            },
+      { IrRegistry::RELATED_SEARCH, IrSonyTV::RELATED_SEARCH },
+      { IrRegistry::RETURN,         IrSonyTV::RETURN         },
+      { IrRegistry::REVERSE,        IrSonyTV::REVERSE        },
+      { IrRegistry::RIGHT,          IrSonyTV::RIGHT          },
+      { IrRegistry::SOCIAL_VIEW,    IrSonyTV::SOCIAL_VIEW    },
+      { IrRegistry::SOURCE,         IrSonyTV::SOURCE         },
+      { IrRegistry::SOURCE_TV,      IrSonyTV::SOURCE_TV      },
+      { IrRegistry::SOURCE_HDMI_1,  IrSonyTV::SOURCE_HDMI_1  },
+      { IrRegistry::SOURCE_HDMI_2,  IrSonyTV::SOURCE_HDMI_2  },
+      { IrRegistry::SOURCE_HDMI_3,  IrSonyTV::SOURCE_HDMI_3  },
+      { IrRegistry::SOURCE_HDMI_4,  IrSonyTV::SOURCE_HDMI_4  },
+      { IrRegistry::SOURCE_HDMI_5,  IrSonyTV::SOURCE_HDMI_5  },
+      { IrRegistry::SOURCE_1,       IrSonyTV::SOURCE_1       },
+      { IrRegistry::SOURCE_2,       IrSonyTV::SOURCE_2       },
+      { IrRegistry::SOURCE_3,       IrSonyTV::SOURCE_3       },
+      { IrRegistry::SOURCE_4,       IrSonyTV::SOURCE_4       },
+      { IrRegistry::SOURCE_5,       IrSonyTV::SOURCE_5       },
+      { IrRegistry::SOURCE_6,       IrSonyTV::SOURCE_6       },
+      { IrRegistry::SOURCE_RGB1,    IrSonyTV::SOURCE_RGB1    },
+      { IrRegistry::SOURCE_RGB2,    IrSonyTV::SOURCE_RGB2    },
+      { IrRegistry::STANDBY,        IrSonyTV::STANDBY        },
+      { IrRegistry::STOP,           IrSonyTV::STOP           },
+      { IrRegistry::SWAP,           IrSonyTV::SWAP           },
+      { IrRegistry::SYNC_MENU,      IrSonyTV::SYNC_MENU      },
+      { IrRegistry::TITLE,          IrSonyTV::TITLE          },
+      { IrRegistry::TV_PAUSE,       IrSonyTV::TV_PAUSE       },
+      { IrRegistry::UNKNOWN,        IrSonyTV::UNKNOWN        },
+      { IrRegistry::UP,             IrSonyTV::UP             },
+      { IrRegistry::VOLUME_DOWN,    IrSonyTV::VOLUME_DOWN    },
+      { IrRegistry::VOLUME_UP,      IrSonyTV::VOLUME_UP      },
+      { IrRegistry::YELLOW,         IrSonyTV::YELLOW         },
+}), "IR registry codes differ from IrSonyTV");
+
+} // End namespace USBDM
@@ -0,0 +1,298 @@
+/**
+ * @file    ir-timing.h
+ * @brief   Timing instrumentation for the CMT interrupt handler
+ */
+#pragma once
+
+#include "hardware.h"
+
+#ifndef USE_IR_TIMING
+/// Enables timing of the CMT interrupt handler (see IrTiming)
+#define USE_IR_TIMING 0
+#endif
+
+namespace USBDM {
+
+/**
+ * Class to measure the timing of the CMT interrupt handler using the DWT cycle counter.
+ *
+ * Enabled by defining USE_IR_TIMING=1 in the build settings.
+ * When disabled all methods are empty and are removed by the compiler.
+ *
+ * The following are measured in CPU cycles:
+ *  - Predicted latency - From the predicted start of a modulator cycle (end-of-cycle flag set) to entry of the handler
+ *  - Duration          - From entry to exit of the handler
+ *  - Slack             - From the modulator registers being written to the end of the cycle
+ *                        in which they were written i.e. how early the next period was programmed.
+ *                        Writes after the end of the cycle are counted as late (the period is lost).
+ *
+ * The start of each modulator cycle is predicted from the start of transmission and the periods programmed.
+ * The end-of-cycle event itself is not time-stamped by the hardware so the latency is a prediction and
+ * should not be read as a measured interrupt latency.
+ * DMA transmissions only measure the duration of the handler as the cycles are not seen by the handler.
+ *
+ * Example
+ * @code
+ *    IrTiming::initialise();
+ *    ...
+ *    IrTiming::report();
+ * @endcode
+ */
+class IrTiming {
+
+private:
+   IrTiming() = delete;
+   IrTiming(const IrTiming &) = delete;
+
+public:
+   /// Indicates if instrumentation is included in the build
+   static constexpr bool enabled = USE_IR_TIMING;
+
+   /**
+    * Histogram of times in CPU cycles.
+    * Bin 0 counts times of 0 and bin n counts times in [2^(n-1), 2^n).
+    * The last bin also counts all larger times.
+    */
+   struct Histogram {
+      static constexpr unsigned NUM_BINS = 24;
+
+      uint32_t bins[NUM_BINS];   ///< Count of times in each bin
+      uint32_t count;            ///< Number of times recorded
+      uint32_t minimum;          ///< Smallest time recorded
+      uint32_t maximum;          ///< Largest time recorded
+      uint64_t total;            ///< Sum of times recorded
+
+      /**
+       * Clear histogram
+       */
+      void clear() {
+         for (uint32_t &bin : bins) {
+            bin = 0;
+         }
+         count   = 0;
+         minimum = -1U;
+         maximum = 0;
+         total   = 0;
+      }
+
+      /**
+       * Add time to histogram
+       *
+       * @param time Time in CPU cycles
+       */
+      void add(uint32_t time) {
+         unsigned bin = (time == 0)?0:(32-__builtin_clz(time));
+         if (bin >= NUM_BINS) {
+            bin = NUM_BINS-1;
+         }
+         bins[bin]++;
+         count++;
+         total += time;
+         if (time < minimum) {
+            minimum = time;
+         }
+         if (time > maximum) {
+            maximum = time;
+         }
+      }
+
+      /**
+       * Report histogram on console
+       *
+       * @param title Title for report
+       */
+      void report(const char *title) const {
+         console.write(title, ": n=", count);
+         if (count == 0) {
+            console.writeln();
+            return;
+         }
+         console.writeln(", min=", minimum, ", max=", maximum, ", mean=", unsigned(total/count), " cycles");
+         for (unsigned bin=0; bin<NUM_BINS; bin++) {
+            if (bins[bin] != 0) {
+               console.writeln("   < ", 1U<<bin, " : ", bins[bin]);
+            }
+         }
+      }
+   };
+
+private:
+   /// Histograms
+   inline static Histogram predictedLatency, duration, slack;
+
+   /// Number of modulator periods programmed after the end of the cycle
+   inline static unsigned lateCount;
+
+   /// CPU cycles per microsecond (modulator tick)
+   inline static uint32_t cyclesPerTick;
+
+   /// Predicted time of start of current modulator cycle (CPU cycles)
+   inline static uint32_t eventTime;
+
+   /// Period of current modulator cycle (ticks)
+   inline static uint32_t currentPeriod;
+
+   /// Indicates eventTime is being tracked i.e. interrupt fed transmission is underway
+   inline static bool tracking;
+
+public:
+   /**
+    * Guard used to time the CMT interrupt handler.
+    * This is declared at the start of the handler.
+    */
+   class IsrTimer {
+
+   private:
+      uint32_t entryTime;
+
+   public:
+      IsrTimer() {
+         if constexpr (enabled) {
+            entryTime = DWT->CYCCNT;
+            if (tracking) {
+               predictedLatency.add(entryTime-eventTime);
+            }
+         }
+      }
+
+      ~IsrTimer() {
+         if constexpr (enabled) {
+            duration.add(DWT->CYCCNT-entryTime);
+         }
+      }
+   };
+
+   /**
+    * Enable the DWT cycle counter and clear measurements
+    */
+   static void initialise() {
+      if constexpr (enabled) {
+         CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+         DWT->CTRL        = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+         cyclesPerTick = SystemCoreClock/1000000;
+         clear();
+      }
+   }
+
+   /**
+    * Clear measurements
+    */
+   static void clear() {
+      if constexpr (enabled) {
+         CriticalSection cs;
+         predictedLatency.clear();
+         duration.clear();
+         slack.clear();
+         lateCount = 0;
+      }
+   }
+
+   /**
+    * Record modulator registers being written for the next cycle
+    *
+    * @param mark    Mark period in ticks
+    * @param space   Space period in ticks
+    */
+   static void programmed(Ticks mark, Ticks space) {
+      if constexpr (enabled) {
+         if (tracking) {
+            uint32_t elapsed = DWT->CYCCNT-eventTime;
+            uint32_t period  = currentPeriod*cyclesPerTick;
+            if (elapsed < period) {
+               slack.add(period-elapsed);
+            }
+            else {
+               lateCount++;
+            }
+            // Registers are used from the end of the current cycle
+            eventTime += period;
+         }
+         currentPeriod = mark+space;
+      }
+   }
+
+   /**
+    * Record start of transmission i.e. CMT has just been enabled with the registers last programmed
+    * The end-of-cycle flag is set immediately so the handler programs the following cycle
+    *
+    * @param interruptFed  Subsequent cycles are programmed by the interrupt handler (not DMA)
+    */
+   static void transmissionStarted(bool interruptFed) {
+      if constexpr (enabled) {
+         eventTime = DWT->CYCCNT;
+         tracking  = interruptFed;
+      }
+   }
+
+   /**
+    * Record end of transmission i.e. CMT has been disabled
+    */
+   static void transmissionStopped() {
+      if constexpr (enabled) {
+         tracking = false;
+      }
+   }
+
+   /**
+    * Get histogram of latency from predicted start of modulator cycle to entry of interrupt handler
+    *
+    * @return Histogram in CPU cycles
+    */
+   static const Histogram &getPredictedLatency() {
+      return predictedLatency;
+   }
+
+   /**
+    * Get histogram of duration of interrupt handler
+    *
+    * @return Histogram in CPU cycles
+    */
+   static const Histogram &getDuration() {
+      return duration;
+   }
+
+   /**
+    * Get histogram of time from writing modulator registers to end of current cycle
+    *
+    * @return Histogram in CPU cycles
+    */
+   static const Histogram &getSlack() {
+      return slack;
+   }
+
+   /**
+    * Get number of modulator periods programmed after the end of the cycle
+    *
+    * @return Number of late periods
+    */
+   static unsigned getLateCount() {
+      return lateCount;
+   }
+
+   /**
+    * Report measurements on console
+    */
+   static void report() {
+      if constexpr (enabled) {
+         Histogram latencyCopy, durationCopy, slackCopy;
+         unsigned  lateCopy;
+         {
+            CriticalSection cs;
+            latencyCopy  = predictedLatency;
+            durationCopy = duration;
+            slackCopy    = slack;
+            lateCopy     = lateCount;
+         }
+         console.writeln("CMT interrupt timing @", cyclesPerTick, " cycles/us");
+         latencyCopy.report("Predicted latency");
+         durationCopy.report("Duration         ");
+         slackCopy.report("Slack            ");
+         console.writeln("Late              : n=", lateCopy);
+      }
+      else {
+         console.writeln("CMT interrupt timing not enabled (USE_IR_TIMING)");
+      }
+   }
+};
+
+} // End namespace USBDM
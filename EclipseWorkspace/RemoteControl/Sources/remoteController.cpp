@@ -51,7 +51,12 @@
 #include "touch_XPT2046.h"
 #include "specialFonts.h"
 #include "cmt-remote.h"
+#include "ir-learner.h"
+#include "ir-decoder.h"
+#include "ir-registry.h"
+#include "ir-device.h"
 #include "../Project_Headers/pit.h"
+#include "../Project_Headers/flash.h"
 #include "BootInformation.h"
 
 // Allow access to USBDM methods without USBDM:: prefix
@@ -278,6 +283,27 @@ public:
 
 };
 
+/*
+ * ============================  Devices  ============================
+ */
+
+/// Period of button polling timer (ms)
+static constexpr unsigned BUTTON_TIMER_PERIOD_MS = 10;
+
+/// Readiness timeline for each IR interface
+template<typename IrClass>
+inline IrDevice irDevice;
+
+/**
+ * Call-back for completion of a transmission to a device
+ *
+ * @tparam IrClass  Class for IR interface
+ */
+template<typename IrClass>
+void irDeviceTransmitted() {
+   irDevice<IrClass>.transmitted();
+}
+
 /*
  * ============================  Actions  ============================
  */
@@ -292,7 +318,21 @@ protected:
    static constexpr inline const char *noTitle = "No Title";
 
    ~Action() = default;
- 
+
+   /**
+    * Execute action() as a single step once an IR transmission can be queued without waiting
+    *
+    * @return true  => Action complete
+    * @return false => IR queue is full - action to be resumed later
+    */
+   bool actionWhenQueueFree() const {
+      if (IrRemote::isQueueFull()) {
+         return false;
+      }
+      action();
+      return true;
+   }
+
 public:
 
    /**
@@ -307,6 +347,53 @@ public:
       console.writeln("Action: ", title);
    }
 
+   /**
+    * Execute the next step of the action (see ActionScheduler).
+    * An action that would have to wait returns false and is resumed on a later poll of the scheduler.
+    * The default executes action() as a single step.
+    *
+    * @param step    Progress through action. This is 0 on the first call and is retained between calls
+    * @param child   Set to an action to run to completion before this action is resumed
+    *
+    * @return true  => Action complete
+    * @return false => Action to be resumed later
+    */
+   virtual bool resume(unsigned &step, const Action *&child) const {
+      (void)step;
+      (void)child;
+      action();
+      return true;
+   }
+
+   /**
+    * Called when the action is cancelled part-way through
+    *
+    * @param step  Progress through action as set by resume()
+    */
+   virtual void abandon(unsigned step) const {
+      (void)step;
+   }
+
+   /**
+    * Get device the action sends commands to
+    *
+    * @return Device or nullptr if not associated with a device
+    */
+   virtual IrDevice *getDevice() const {
+      return nullptr;
+   }
+
+   /**
+    * Check if the action sends commands to a device
+    *
+    * @param device Device to check
+    *
+    * @return true => Action sends commands to the device
+    */
+   virtual bool usesDevice(const IrDevice *device) const {
+      return getDevice() == device;
+   }
+
    static const Action nullAction;
 };
 
@@ -359,57 +446,266 @@ public:
    constexpr MessageAction(const char *message) : Action(message) {
    }
 
-   virtual ~MessageAction() = default;
-
    void action() const override {
       console.writeln(title);
    }
 };
 
+/**
+ * Learn a code from another remote.
+ * The transmission is captured from the IR receiver (see IrLearner) and the decoded frame is reported on the console.
+ * The scheduler is not blocked while waiting for the transmission. Cancelling the action abandons the capture.
+ */
+class LearnAction : public Action {
+
+public:
+   /**
+    *  Create action
+    *
+    * @param title         Title for logging
+    */
+   constexpr LearnAction(const char *title) : Action(title) {
+   }
+
+   virtual bool resume(unsigned &step, const Action *&child) const override {
+      (void)child;
+
+      if (step == 0) {
+         // Start capture
+         ErrorCode rc = IrLearner::start(nullptr);
+         if (rc != E_NO_ERROR) {
+            console.writeln("LearnAction: ", title, " - ", getErrorMessage(rc));
+            return true;
+         }
+         console.writeln("LearnAction: ", title, " - waiting for transmission");
+         step = 1;
+         return false;
+      }
+      if (IrLearner::isBusy()) {
+         return false;
+      }
+      unsigned count;
+      const uint16_t *timings = IrLearner::getTimings(count);
+      IrDecoder::Result result;
+      if (IrDecoder::decode(timings, count, result)) {
+         console.write("LearnAction: protocol=", unsigned(result.protocol), ", frames=", result.frames);
+         console.writeln(", code=0x", result.code, Radix_16);
+      }
+      else {
+         console.writeln("LearnAction: ", count, " timings not recognised");
+      }
+      return true;
+   }
+
+   virtual void abandon(unsigned step) const override {
+      if (step != 0) {
+         IrLearner::stop();
+      }
+   }
+};
+
+/**
+ * Sequence of actions.
+ * Sequences are constant so the list of actions is located in flash and no construction is needed at start-up.
+ *
+ * Example
+ * @code
+ *    constexpr SequenceAction watch{"Seq: Watch", sonyTvWatchTv, sonyTvPage, completeMessage};
+ * @endcode
+ *
+ * @tparam capacity Number of actions in sequence
+ */
 template<size_t capacity>
 class SequenceAction : public Action {
 
-   MyVector<Action const *, capacity> actions;
-
-   static const inline char *noTitle = "Sequence...";
+   Action const * const actions[capacity];
 
 public:
 
    /**
+    * Create sequence
     *
-    * @param title  Title identifying action sequence
+    * @param title   Title identifying action sequence
+    * @param actions Actions in order
     */
-   SequenceAction(const char *title=noTitle) : Action(title) {
+   template<typename... Actions>
+   constexpr SequenceAction(const char *title, const Actions &...actions) : Action(title), actions{&actions...} {
+      static_assert(sizeof...(actions) == capacity, "Number of actions doesn't match sequence size");
    }
 
    virtual ~SequenceAction() = default;
 
-   void add(const Action *action) {
-      actions.push_back(action);
+   /**
+    * Execute the next step of the sequence.
+    *
+    * Steps are not strictly executed in order. The first step that may be executed is chosen:
+    *  - A step sending to a device waits until the device is ready and all earlier steps using the
+    *    same device have been executed. It may pass steps for other devices e.g. a DVD may be
+    *    turned on while the TV is still settling.
+    *  - Other steps e.g. page changes wait until all earlier steps have been executed.
+    *
+    * @param step    Record of executed steps (bit mask)
+    * @param child   Set to the step to be run by the scheduler
+    *
+    * @return true  => Sequence complete
+    * @return false => Sequence to be resumed later
+    */
+   bool resume(unsigned &step, const Action *&child) const override {
+
+      static_assert(capacity < 32, "Sequence too long to plan");
+
+      // Indicates the sequence has started
+      static constexpr unsigned STARTED = 1U<<31;
+
+      if (step == 0) {
+         Action::action();
+         step = STARTED;
+      }
+      for (unsigned index=0; index<capacity; index++) {
+         if (step & (1U<<index)) {
+            continue;
+         }
+         if (isRunnable(step, index)) {
+            step  |= (1U<<index);
+            child  = actions[index];
+            return false;
+         }
+      }
+      // Complete when all steps have been executed
+      return step == (STARTED|((1U<<capacity)-1));
+   }
+
+   bool usesDevice(const IrDevice *device) const override {
+      for (const Action *action : actions) {
+         if (action->usesDevice(device)) {
+            return true;
+         }
+      }
+      return false;
+   }
+
+private:
+
+   /**
+    * Check if a step of the sequence may be executed
+    *
+    * @param executed   Record of executed steps (bit mask)
+    * @param index      Index of step to check
+    *
+    * @return true => Step may be executed now
+    */
+   bool isRunnable(unsigned executed, unsigned index) const {
+      return IrDevice::isRunnable(actions, executed, index);
+   }
+};
+
+/// Deduce size of SequenceAction from the number of actions
+template<typename... Actions>
+SequenceAction(const char *, const Actions &...) -> SequenceAction<sizeof...(Actions)>;
+
+/// Record in the IR registry for each IR interface
+template<typename IrClass>
+constexpr const IrRegistry::Device *registryDevice = nullptr;
+
+template<> constexpr const IrRegistry::Device *registryDevice<IrSonyTV>       = IrRegistry::findDevice("Sony TV");
+template<> constexpr const IrRegistry::Device *registryDevice<IrLaserDVD>     = IrRegistry::findDevice("Laser DVD");
+template<> constexpr const IrRegistry::Device *registryDevice<IrSamsungDVD>   = IrRegistry::findDevice("Samsung DVD");
+template<> constexpr const IrRegistry::Device *registryDevice<IrTeacPVR>      = IrRegistry::findDevice("Teac PVR");
+template<> constexpr const IrRegistry::Device *registryDevice<IrBlaupunktDVD> = IrRegistry::findDevice("Blaupunkt DVD");
+template<> constexpr const IrRegistry::Device *registryDevice<IrPanasonicDVD> = IrRegistry::findDevice("Panasonic DVD");
+
+/**
+ * Code for a key obtained from the IR registry at compile time.
+ * This is used where the transmission is rendered at compile time by the IR interface.
+ *
+ * @tparam IrClass  Class for IR interface
+ * @tparam key      Key to send
+ */
+template<typename IrClass, IrRegistry::Key key>
+constexpr typename IrClass::Code registryCode = []() {
+   static_assert(registryDevice<IrClass> != nullptr, "IR interface has no record in the IR registry");
+   constexpr uint32_t code = IrRegistry::getCode(*registryDevice<IrClass>, key);
+   static_assert(code != IrRegistry::NO_CODE, "Device does not provide key");
+   return typename IrClass::Code(code);
+}();
+
+/**
+ * IR action sending a key to a device using the code database (see IrRegistry).
+ *
+ * @tparam IrClass  Class for IR interface. This selects the registry record and readiness timeline of the device
+ */
+template<typename IrClass>
+class IrAction : public Action {
+
+   static_assert(registryDevice<IrClass> != nullptr, "IR interface has no record in the IR registry");
+
+protected:
+   const IrRegistry::Key key;
+   const unsigned        delayTime;
+   static const inline char *noTitle = "IR action";
+
+   /**
+    * Check result of queuing a transmission.
+    * If nothing was queued the transmission is recorded as complete.
+    *
+    * @param rc Result from IrRegistry
+    */
+   void checkQueued(ErrorCode rc) const {
+      if (rc != E_NO_ERROR) {
+         console.writeln("IrAction: ", title, " - key not provided by device");
+         irDevice<IrClass>.transmitted();
+      }
    }
 
-   void add(const Action &action) {
-      actions.push_back(&action);
+public:
+
+   /**
+    * Create IR action
+    *
+    * @param key           Key to send
+    * @param title         Title for logging
+    * @param delay         Delay after transmission. 1_tick = 1us
+    */
+   constexpr IrAction(
+         IrRegistry::Key  key,
+         const char      *title=noTitle,
+         Ticks            delay=100_ticks) :
+         Action(title),
+         key(key), delayTime(delay) {
    }
 
+   virtual ~IrAction() = default;
+
    void action() const override {
 
       Action::action();
-      for (const Action *action : actions) {
-         action->action();
+      irDevice<IrClass>.transmit(delayTime);
+      checkQueued(IrRegistry::send(*registryDevice<IrClass>, key, 0, 3, irDeviceTransmitted<IrClass>));
+   }
+
+   bool resume(unsigned &, const Action *&) const override {
+      if (!irDevice<IrClass>.isReady()) {
+         return false;
       }
+      return actionWhenQueueFree();
+   }
+
+   IrDevice *getDevice() const override {
+      return &irDevice<IrClass>;
    }
 };
 
 /**
+ * IR action using a transmission rendered at compile time.
+ * The code is obtained from the IR registry.
  *
  * @tparam IrClass  Class for IR interface
+ * @tparam key      Key to send
  */
-template<typename IrClass>
-class IrAction : public Action {
+template<typename IrClass, IrRegistry::Key key>
+class RenderedIrAction : public Action {
 
 protected:
-   typename IrClass::Code code;
    const unsigned delayTime;
    static const inline char *noTitle = "IR action";
 
@@ -418,27 +714,258 @@ public:
    /**
     * Create IR action
     *
-    * @param code          Code to send
     * @param title         Title for logging
     * @param delay         Delay after transmission. 1_tick = 1us
     */
-   constexpr IrAction(
-         const typename IrClass::Code  code,
+   constexpr RenderedIrAction(
          const char                   *title=noTitle,
          Ticks                         delay=100_ticks) :
          Action(title),
-         code(code), delayTime(delay) {
+         delayTime(delay) {
    }
 
-   virtual ~IrAction() = default;
+   virtual ~RenderedIrAction() = default;
 
    void action() const override {
 
       Action::action();
-      IrClass::send(code, delayTime);
+      irDevice<IrClass>.transmit(delayTime);
+      IrClass::template send<registryCode<IrClass, key>>(0, irDeviceTransmitted<IrClass>);
+   }
+
+   bool resume(unsigned &, const Action *&) const override {
+      if (!irDevice<IrClass>.isReady()) {
+         return false;
+      }
+      return actionWhenQueueFree();
+   }
+
+   IrDevice *getDevice() const override {
+      return &irDevice<IrClass>;
+   }
+};
+
+/**
+ * IR action sending a burst of transmissions rendered at compile time (see IrRemote::renderBurst()).
+ * The burst is sent as a single transmission with the gaps between transmissions included.
+ *
+ * @tparam IrClass  Class for IR interface
+ * @tparam burst    Burst to send
+ */
+template<typename IrClass, const auto &burst>
+class BurstIrAction : public Action {
+
+protected:
+   static const inline char *noTitle = "IR burst";
+
+public:
+
+   /**
+    * Create IR action
+    *
+    * @param title         Title for logging
+    */
+   constexpr BurstIrAction(const char *title=noTitle) : Action(title) {
+   }
+
+   virtual ~BurstIrAction() = default;
+
+   void action() const override {
+
+      Action::action();
+      // The final delay is part of the burst
+      irDevice<IrClass>.transmit(0);
+      IrRemote::sendBurst(burst, irDeviceTransmitted<IrClass>);
+   }
+
+   bool resume(unsigned &, const Action *&) const override {
+      if (!irDevice<IrClass>.isReady()) {
+         return false;
+      }
+      return actionWhenQueueFree();
+   }
+
+   IrDevice *getDevice() const override {
+      return &irDevice<IrClass>;
+   }
+};
+
+/**
+ * Check if the touch screen or a button is still pressed
+ *
+ * @return true => Key held
+ */
+bool isKeyHeld();
+
+/**
+ * IR action that keeps repeating while the key is held e.g. volume.
+ * The protocol repeat frame is sent until the key is released.
+ *
+ * @tparam IrClass  Class for IR interface
+ */
+template<typename IrClass>
+class HoldIrAction : public IrAction<IrClass> {
+
+   using IrAction<IrClass>::key;
+   using IrAction<IrClass>::delayTime;
+   using IrAction<IrClass>::checkQueued;
+
+public:
+
+   /**
+    * Create IR action
+    *
+    * @param key           Key to send
+    * @param title         Title for logging
+    * @param delay         Delay after transmission. 1_tick = 1us
+    */
+   constexpr HoldIrAction(
+         IrRegistry::Key  key,
+         const char      *title=IrAction<IrClass>::noTitle,
+         Ticks            delay=100_ticks) :
+         IrAction<IrClass>(key, title, delay) {
+   }
+
+   virtual ~HoldIrAction() = default;
+
+   bool resume(unsigned &step, const Action *&) const override {
+
+      if (step == 0) {
+         if (!irDevice<IrClass>.isReady() || IrRemote::isQueueFull()) {
+            return false;
+         }
+         Action::action();
+         irDevice<IrClass>.transmit(delayTime);
+         checkQueued(IrRegistry::hold(*registryDevice<IrClass>, key, 0, 3, irDeviceTransmitted<IrClass>));
+         step = 1;
+      }
+      if (isKeyHeld()) {
+         // Keep repeating until released
+         return false;
+      }
+      IrRemote::release();
+      return true;
+   }
+
+   void abandon(unsigned step) const override {
+      if (step != 0) {
+         IrRemote::release();
+      }
+   }
+};
+
+/**
+ * IR action for keypad keys e.g. navigation.
+ * A new key press replaces any earlier key press still being transmitted
+ * so rapid key presses are not delayed by the repeats of earlier presses.
+ *
+ * @tparam IrClass  Class for IR interface
+ */
+template<typename IrClass>
+class KeypadIrAction : public IrAction<IrClass> {
+
+   using IrAction<IrClass>::key;
+   using IrAction<IrClass>::delayTime;
+   using IrAction<IrClass>::checkQueued;
+
+public:
+
+   /**
+    * Create IR action
+    *
+    * @param key           Key to send
+    * @param title         Title for logging
+    * @param delay         Delay after transmission. 1_tick = 1us
+    */
+   constexpr KeypadIrAction(
+         IrRegistry::Key  key,
+         const char      *title=IrAction<IrClass>::noTitle,
+         Ticks            delay=100_ticks) :
+         IrAction<IrClass>(key, title, delay) {
+   }
+
+   virtual ~KeypadIrAction() = default;
+
+   void action() const override {
+
+      Action::action();
+      irDevice<IrClass>.transmit(delayTime);
+      checkQueued(IrRegistry::replace(*registryDevice<IrClass>, key, 0, 3, irDeviceTransmitted<IrClass>));
+   }
+
+   bool resume(unsigned &, const Action *&) const override {
+      // Don't wait for an earlier key press as it is replaced
+      if (!irDevice<IrClass>.isSettled()) {
+         return false;
+      }
+      return Action::actionWhenQueueFree();
+   }
+};
+
+/**
+ * Modelled state of the Sony TV.
+ * This is updated as commands are sent so only the commands needed to reach a target state are sent
+ * (see SonyTvSelectAction).
+ * Only power and input source are modelled. The page last shown by the TV and the state of the PVR are not.
+ */
+struct SonyTvState {
+   bool            power;    ///< TV is on
+   IrRegistry::Key source;   ///< Input source selected
+   bool            starting; ///< TV has been turned on and no source selected since
+
+   /**
+    * Update model for a key sent to the TV
+    *
+    * @param key Key sent
+    */
+   void update(IrRegistry::Key key) {
+      switch(key) {
+         case IrRegistry::ON:      starting = !power; power = true;   break;
+         case IrRegistry::OFF:     starting = false;  power = false;  break;
+         case IrRegistry::ON_OFF:  starting = !power; power = !power; break;
+         case IrRegistry::SOURCE_TV:
+         case IrRegistry::SOURCE_HDMI_1:
+         case IrRegistry::SOURCE_HDMI_2:
+         case IrRegistry::SOURCE_HDMI_3:
+         case IrRegistry::SOURCE_HDMI_4:
+         case IrRegistry::SOURCE_HDMI_5:
+         case IrRegistry::SOURCE_RGB1:
+         case IrRegistry::SOURCE_RGB2:
+            source   = key;
+            starting = false;
+            break;
+         default:
+            break;
+      }
+   }
+};
+
+SonyTvState sonyTvState{false, IrRegistry::SOURCE_TV, false};
+
+/**
+ * Sony TV action using a transmission rendered at compile time.
+ * The modelled state of the TV is updated.
+ *
+ * @tparam key      Key to send
+ */
+template<IrRegistry::Key key>
+class SonyTvRenderedAction : public RenderedIrAction<IrSonyTV, key> {
+
+public:
+
+   using RenderedIrAction<IrSonyTV, key>::RenderedIrAction;
+
+   virtual ~SonyTvRenderedAction() = default;
+
+   void action() const override {
+
+      RenderedIrAction<IrSonyTV, key>::action();
+      sonyTvState.update(key);
    }
 };
 
+using SonyTvHoldAction   = HoldIrAction<IrSonyTV>;
+
 using SonyTvAction       = IrAction<IrSonyTV>;
 using LaserDvdAction     = IrAction<IrLaserDVD>;
 using SamsungDvdAction   = IrAction<IrSamsungDVD>;
@@ -446,7 +973,15 @@ using TeacPvrAction      = IrAction<IrTeacPVR>;
 using BlaupunktDvdAction = IrAction<IrBlaupunktDVD>;
 using PanasonicDvdAction = IrAction<IrPanasonicDVD>;
 
+using SonyTvKeyAction       = KeypadIrAction<IrSonyTV>;
+using LaserDvdKeyAction     = KeypadIrAction<IrLaserDVD>;
+using SamsungDvdKeyAction   = KeypadIrAction<IrSamsungDVD>;
+using TeacPvrKeyAction      = KeypadIrAction<IrTeacPVR>;
+using BlaupunktDvdKeyAction = KeypadIrAction<IrBlaupunktDVD>;
+using PanasonicDvdKeyAction = KeypadIrAction<IrPanasonicDVD>;
+
 /**
+ * IR action that is only sent when it changes the modelled status of the device e.g. power On.
  *
  * @tparam IrClass  Class for IR interface
  */
@@ -464,19 +999,19 @@ public:
 
    /**
     *
-    * @param code          Code to send
+    * @param key           Key to send
     * @param title         Title for logging
     * @param delay         Delay after transmission
     * @param status        Variable to update with status
     * @param actionValue   Status update value to use
     */
    constexpr IrStatusAction(
-         const typename IrClass::Code  code,
-         const char                   *title,
-         Ticks                         delay,
-         bool                         &status,
-         bool                          actionValue) :
-   IrAction<IrClass>(code, title, delay), status(status), actionValue(actionValue) {
+         IrRegistry::Key  key,
+         const char      *title,
+         Ticks            delay,
+         bool            &status,
+         bool             actionValue) :
+   IrAction<IrClass>(key, title, delay), status(status), actionValue(actionValue) {
    }
 
    virtual ~IrStatusAction() = default;
@@ -501,6 +1036,124 @@ using TeacPvrStatusAction      = IrStatusAction<IrTeacPVR>;
 using BlaupunktDVDStatusAction = IrStatusAction<IrBlaupunktDVD>;
 using PanasonicDVDStatusAction = IrStatusAction<IrPanasonicDVD>;
 
+/**
+ * IR action for a toggle e.g. power On/Off.
+ * The shared status used by IrStatusAction is toggled so it follows the device.
+ *
+ * @tparam IrClass  Class for IR interface
+ */
+template<typename IrClass>
+class IrToggleAction : public IrAction<IrClass> {
+
+protected:
+
+   bool &status;
+
+public:
+
+   /**
+    *
+    * @param key           Key to send
+    * @param title         Title for logging
+    * @param delay         Delay after transmission
+    * @param status        Variable to toggle
+    */
+   constexpr IrToggleAction(
+         IrRegistry::Key  key,
+         const char      *title,
+         Ticks            delay,
+         bool            &status) :
+   IrAction<IrClass>(key, title, delay), status(status) {
+   }
+
+   virtual ~IrToggleAction() = default;
+
+   void action() const override {
+
+      IrAction<IrClass>::action();
+      status = !status;
+   }
+};
+
+using LaserDvdToggleAction     = IrToggleAction<IrLaserDVD>;
+using SamsungDvdToggleAction   = IrToggleAction<IrSamsungDVD>;
+using TeacPvrToggleAction      = IrToggleAction<IrTeacPVR>;
+using BlaupunktDvdToggleAction = IrToggleAction<IrBlaupunktDVD>;
+using PanasonicDvdToggleAction = IrToggleAction<IrPanasonicDVD>;
+
+/**
+ * Cooperative scheduler for actions.
+ *
+ * Actions are executed a step at a time (see Action::resume()) from the main loop
+ * so touch, buttons and battery monitoring continue while a sequence is in progress.
+ * Steps that would have to wait e.g. for space in the IR queue or for a key to be released
+ * are resumed on a later poll.
+ * Sequences are run as a stack of actions rather than by nested calls.
+ *
+ * Starting an action cancels any action in progress. Transmissions already queued are completed.
+ */
+class ActionScheduler {
+
+private:
+
+   /// Maximum depth of nested sequences
+   static constexpr unsigned MAX_DEPTH = 4;
+
+   /// Action in progress and the step it has reached
+   struct Frame {
+      const Action *action;
+      unsigned      step;
+   };
+
+   Frame    frames[MAX_DEPTH];
+   unsigned depth = 0;
+
+   /// Last action started ran to completion
+   bool     complete = true;
+
+public:
+
+   /**
+    * Indicates if an action is in progress
+    *
+    * @return true => Action in progress
+    */
+   bool isRunning() const {
+      return depth > 0;
+   }
+
+   /**
+    * Indicates if the last action started has run to completion.
+    * This is false while the action is in progress and after it has been cancelled.
+    *
+    * @return true => Action complete
+    */
+   bool isComplete() const {
+      return complete;
+   }
+
+   /**
+    * Start action. The action is executed by subsequent calls to poll().
+    * Any action in progress is cancelled.
+    *
+    * @param action Action to start
+    */
+   void start(const Action &action);
+
+   /**
+    * Cancel the action in progress (if any).
+    * The remaining steps are discarded.
+    */
+   void cancel();
+
+   /**
+    * Execute steps of the action in progress until it completes or has to wait
+    */
+   void poll();
+};
+
+ActionScheduler scheduler;
+
 /*
  * ============================  Buttons ============================
  */
@@ -552,7 +1205,7 @@ public:
    }
 
    void doAction() const {
-      action.action();
+      scheduler.start(action);
    }
 };
 
@@ -842,13 +1495,7 @@ public:
 bool Screen::findAndExecuteHandler(unsigned x, unsigned y) {
 
    if (currentPage != nullptr) {
-
-      setBusy(true);
-
-      bool rc = currentPage->findAndExecuteHandler(x, y);
-
-      setBusy(false);
-      return rc;
+      return currentPage->findAndExecuteHandler(x, y);
    }
    return false;
 }
@@ -867,63 +1514,379 @@ void Screen::handleButton(ButtonCode code) {
    }
 }
 
+void ActionScheduler::start(const Action &action) {
+
+   cancel();
+   screen.setBusy(true);
+   frames[0] = {&action, 0};
+   depth     = 1;
+   complete  = false;
+}
+
+void ActionScheduler::cancel() {
+
+   if (depth == 0) {
+      return;
+   }
+   console.writeln("Cancelled");
+   while (depth > 0) {
+      depth--;
+      frames[depth].action->abandon(frames[depth].step);
+   }
+   screen.setBusy(false);
+}
+
+void ActionScheduler::poll() {
+
+   if (depth == 0) {
+      return;
+   }
+   while (depth > 0) {
+      Frame &frame = frames[depth-1];
+      const Action *child = nullptr;
+      if (frame.action->resume(frame.step, child)) {
+         depth--;
+      }
+      else if (child != nullptr) {
+         usbdm_assert(depth<MAX_DEPTH, "Sequences nested too deeply");
+         frames[depth++] = {child, 0};
+      }
+      else {
+         // Resume on a later poll
+         return;
+      }
+   }
+   complete = true;
+   screen.setBusy(false);
+}
+
 /*
  * Shared Actions
  * ============================================================================================
  */
-constexpr SonyTvAction   sonyTvOnOff(                     IrSonyTV::ON_OFF,          "TV On/Off",      1000_ticks);
-constexpr SonyTvAction   sonyTvOn(                        IrSonyTV::ON,              "TV On",          1000_ticks);
-constexpr SonyTvAction   sonyTvOff(                       IrSonyTV::OFF,             "TV Off"          );
-constexpr SonyTvAction   sonyTvSourceHdmi1_Chrome(        IrSonyTV::SOURCE_HDMI_1,   "TV Source HDMI 1");
-constexpr SonyTvAction   sonyTvSourceHdmi2_PVR(           IrSonyTV::SOURCE_HDMI_2,   "TV Source HDMI 2");
-constexpr SonyTvAction   sonyTvSourceHdmi3_DVD_Samsung(   IrSonyTV::SOURCE_HDMI_3,   "TV Source HDMI 3");
-constexpr SonyTvAction   sonyTvSourceHdmi4_DVD_Laser(     IrSonyTV::SOURCE_HDMI_4,   "TV Source HDMI 4");
-constexpr SonyTvAction   sonyTvSourceComp_DVD_Pioneer(    IrSonyTV::SOURCE_RGB1,     "TV Source RGB 1" );
-constexpr SonyTvAction   sonyTvMute(                      IrSonyTV::MUTE,            "TV Mute",        1'000'000_ticks);
-constexpr SonyTvAction   sonyTvVolumeUp(                  IrSonyTV::VOLUME_UP,       "TV Vol Up",      100'000_ticks);
-constexpr SonyTvAction   sonyTvVolumeDown(                IrSonyTV::VOLUME_DOWN,     "TV Vol Down",    100'000_ticks);
-constexpr SonyTvAction   sonyTvHome(                      IrSonyTV::HOME,            "TV Home"         );
-constexpr SonyTvAction   sonyTvReturn(                    IrSonyTV::RETURN,          "TV Return"       );
-constexpr SonyTvAction   sonyTvSourceTv(                  IrSonyTV::SOURCE_TV,       "TV Source TV"    );
+/// Time the Sony TV ignores commands after being turned on. This is an allowance rather than a measured time.
+static constexpr Ticks SONY_TV_START_UP_TIME = 5'000'000_ticks;
+
+constexpr SonyTvRenderedAction<IrRegistry::ON_OFF>        sonyTvOnOff(                    "TV On/Off",         1000_ticks);
+constexpr SonyTvRenderedAction<IrRegistry::ON>            sonyTvOn(                       "TV On",             SONY_TV_START_UP_TIME);
+constexpr SonyTvRenderedAction<IrRegistry::OFF>           sonyTvOff(                      "TV Off");
+constexpr SonyTvRenderedAction<IrRegistry::SOURCE_HDMI_1> sonyTvSourceHdmi1_Chrome(       "TV Source HDMI 1");
+constexpr SonyTvRenderedAction<IrRegistry::SOURCE_HDMI_2> sonyTvSourceHdmi2_PVR(          "TV Source HDMI 2");
+constexpr SonyTvRenderedAction<IrRegistry::SOURCE_HDMI_3> sonyTvSourceHdmi3_DVD_Samsung(  "TV Source HDMI 3");
+constexpr SonyTvRenderedAction<IrRegistry::SOURCE_HDMI_4> sonyTvSourceHdmi4_DVD_Laser(    "TV Source HDMI 4");
+constexpr SonyTvRenderedAction<IrRegistry::SOURCE_RGB1>   sonyTvSourceComp_DVD_Pioneer(   "TV Source RGB 1");
+constexpr SonyTvRenderedAction<IrRegistry::MUTE>          sonyTvMute(                     "TV Mute",           1'000'000_ticks);
+constexpr SonyTvHoldAction                                sonyTvVolumeUp(IrRegistry::VOLUME_UP,     "TV Vol Up",   100'000_ticks);
+constexpr SonyTvHoldAction                                sonyTvVolumeDown(IrRegistry::VOLUME_DOWN, "TV Vol Down", 100'000_ticks);
+constexpr SonyTvRenderedAction<IrRegistry::HOME>          sonyTvHome(                     "TV Home");
+constexpr SonyTvRenderedAction<IrRegistry::RETURN>        sonyTvReturn(                   "TV Return");
+constexpr SonyTvRenderedAction<IrRegistry::SOURCE_TV>     sonyTvSourceTv(                 "TV Source TV");
+
+constexpr LearnAction learnCode("Learn Code");
+
+/**
+ * Sony TV Home, Return, Source sent as a single burst.
+ * This dismisses the start-up page of the TV and selects the source.
+ *
+ * @tparam source Source to select
+ */
+template<IrRegistry::Key source>
+constexpr auto sonyTvStartSource = IrRemote::renderBurst<
+      IrRemote::BurstStep<IrSonyTV::rendered<registryCode<IrSonyTV, IrRegistry::HOME>>,   100_ticks>,
+      IrRemote::BurstStep<IrSonyTV::rendered<registryCode<IrSonyTV, IrRegistry::RETURN>>, 100_ticks>,
+      IrRemote::BurstStep<IrSonyTV::rendered<registryCode<IrSonyTV, source>>,             100_ticks>>();
+
+/**
+ * Sony TV Home, Return, Source sent as a single burst.
+ * The modelled state of the TV is updated.
+ *
+ * @tparam source Source to select
+ */
+template<IrRegistry::Key source>
+class SonyTvStartSourceAction : public BurstIrAction<IrSonyTV, sonyTvStartSource<source>> {
+
+public:
+
+   using BurstIrAction<IrSonyTV, sonyTvStartSource<source>>::BurstIrAction;
+
+   virtual ~SonyTvStartSourceAction() = default;
+
+   void action() const override {
+
+      BurstIrAction<IrSonyTV, sonyTvStartSource<source>>::action();
+      sonyTvState.update(source);
+   }
+};
+
+/**
+ * Action to turn on the Sony TV if the modelled state of the TV is off.
+ *
+ * The TV then ignores commands while it starts up (SONY_TV_START_UP_TIME).
+ * Used as the first step of a sequence so the steps for other devices are sent
+ * while the TV starts up (see SequenceAction).
+ */
+class SonyTvPowerOnAction : public Action {
+
+public:
+
+   /**
+    * Create TV power on action
+    *
+    * @param title         Title for logging
+    */
+   constexpr SonyTvPowerOnAction(const char *title) : Action(title) {
+   }
+
+   bool resume(unsigned &step, const Action *&child) const override {
+
+      if ((step != 0) || sonyTvState.power) {
+         // On sent or already on
+         return true;
+      }
+      step  = 1;
+      child = &sonyTvOn;
+      return false;
+   }
+
+   IrDevice *getDevice() const override {
+      return &irDevice<IrSonyTV>;
+   }
+};
+
+constexpr SonyTvPowerOnAction sonyTvPowerOn("TV Power On");
+
+/**
+ * Action to bring the Sony TV to a source using the fewest commands given the modelled state of the TV
+ *  - TV off                  - On is sent then Home, Return and source as a burst once the TV has started
+ *  - TV starting up          - Home, Return and source are sent as a burst
+ *  - TV on, different source - Only the source is sent
+ *  - TV on, same source      - Nothing is sent
+ *
+ * @tparam source Source to select
+ */
+template<IrRegistry::Key source>
+class SonyTvSelectAction : public Action {
+
+private:
+
+   static constexpr SonyTvStartSourceAction<source> startAction{"TV Start, Source"};
+   static constexpr SequenceAction<2>               powerOnAction{"TV On, Source", sonyTvOn, startAction};
+   static constexpr SonyTvRenderedAction<source>    sourceAction{"TV Source"};
+
+   /**
+    * Determine the action needed to reach the target state
+    *
+    * @return Action to execute or nullptr if none needed
+    */
+   const Action *plan() const {
+
+      // The model is updated by the action when it is sent
+      if (!sonyTvState.power) {
+         return &powerOnAction;
+      }
+      if (sonyTvState.starting) {
+         return &startAction;
+      }
+      if (sonyTvState.source != source) {
+         return &sourceAction;
+      }
+      console.writeln("SonyTvSelectAction: ", title, " - no action needed");
+      return nullptr;
+   }
+
+public:
+
+   /**
+    * Create TV select action
+    *
+    * @param title         Title for logging
+    */
+   constexpr SonyTvSelectAction(const char *title) : Action(title) {
+   }
+
+   virtual ~SonyTvSelectAction() = default;
+
+   bool resume(unsigned &step, const Action *&child) const override {
+
+      if (step != 0) {
+         // Planned action complete
+         return true;
+      }
+      step  = 1;
+      child = plan();
+      return child == nullptr;
+   }
+
+   IrDevice *getDevice() const override {
+      return &irDevice<IrSonyTV>;
+   }
+};
+
+constexpr SonyTvSelectAction<IrRegistry::SOURCE_TV>     sonyTvWatchTv(     "TV Select Source TV");
+constexpr SonyTvSelectAction<IrRegistry::SOURCE_HDMI_2> sonyTvWatchHdmi2(  "TV Select Source HDMI 2");
+constexpr SonyTvSelectAction<IrRegistry::SOURCE_HDMI_3> sonyTvWatchHdmi3(  "TV Select Source HDMI 3");
+constexpr SonyTvSelectAction<IrRegistry::SOURCE_HDMI_4> sonyTvWatchHdmi4(  "TV Select Source HDMI 4");
 
 bool teacPvrPowerStatus  = false;
-constexpr TeacPvrAction        teacPvrOnOff(     IrTeacPVR::ON_OFF,   "Teac PVR On/Off",  100_ticks);
-constexpr TeacPvrStatusAction  teacPvrOn(        IrTeacPVR::ON_OFF,   "Teac PVR On",      100_ticks,     teacPvrPowerStatus,   true);
-constexpr TeacPvrStatusAction  teacPvrOff(       IrTeacPVR::ON_OFF,   "Teac PVR Off",     100_ticks,     teacPvrPowerStatus,   false);
+constexpr TeacPvrToggleAction  teacPvrOnOff(     IrRegistry::ON_OFF,  "Teac PVR On/Off",  100_ticks,     teacPvrPowerStatus);
+constexpr TeacPvrStatusAction  teacPvrOn(        IrRegistry::ON_OFF,  "Teac PVR On",      100_ticks,     teacPvrPowerStatus,   true);
+constexpr TeacPvrStatusAction  teacPvrOff(       IrRegistry::ON_OFF,  "Teac PVR Off",     100_ticks,     teacPvrPowerStatus,   false);
 
 bool laserDvdPowerStatus  = false;
-constexpr LaserDvdAction       laserDvdOnOff(    IrLaserDVD::ON_OFF,  "Laser DVD On/Off",  100_ticks);
-constexpr LaserDvdStatusAction laserDvdOn(       IrLaserDVD::ON_OFF,  "Laser DVD On",      100_ticks,  laserDvdPowerStatus,   true);
-constexpr LaserDvdStatusAction laserDvdOff(      IrLaserDVD::ON_OFF,  "Laser DVD Off",     100_ticks,  laserDvdPowerStatus,   false);
+constexpr LaserDvdToggleAction laserDvdOnOff(    IrRegistry::ON_OFF,  "Laser DVD On/Off",  100_ticks,  laserDvdPowerStatus);
+constexpr LaserDvdStatusAction laserDvdOn(       IrRegistry::ON_OFF,  "Laser DVD On",      100_ticks,  laserDvdPowerStatus,   true);
+constexpr LaserDvdStatusAction laserDvdOff(      IrRegistry::ON_OFF,  "Laser DVD Off",     100_ticks,  laserDvdPowerStatus,   false);
 
 bool samsungDvdPowerStatus  = false;
-constexpr SamsungDvdAction       samsungDvdOnOff(   IrSamsungDVD::ON_OFF,   "Samsung DVD On/Off",  100_ticks);
-constexpr SamsungDvdStatusAction samsungDvdOn(      IrSamsungDVD::ON_OFF,   "Samsung DVD On",      100_ticks,   samsungDvdPowerStatus,   true);
-constexpr SamsungDvdStatusAction samsungDvdOff(     IrSamsungDVD::ON_OFF,   "Samsung DVD Off",     100_ticks,   samsungDvdPowerStatus,   false);
+constexpr SamsungDvdToggleAction samsungDvdOnOff(   IrRegistry::ON_OFF,  "Samsung DVD On/Off",  100_ticks,   samsungDvdPowerStatus);
+constexpr SamsungDvdStatusAction samsungDvdOn(      IrRegistry::ON_OFF,  "Samsung DVD On",      100_ticks,   samsungDvdPowerStatus,   true);
+constexpr SamsungDvdStatusAction samsungDvdOff(     IrRegistry::ON_OFF,  "Samsung DVD Off",     100_ticks,   samsungDvdPowerStatus,   false);
 
 bool panasonicDvdPowerStatus  = false;
-constexpr PanasonicDvdAction       panasonicDvdOnOff(   IrPanasonicDVD::ON_OFF,   "Panasonic DVD On/Off",  100_ticks);
-constexpr PanasonicDVDStatusAction panasonicDvdOn(      IrPanasonicDVD::ON_OFF,   "Panasonic DVD On",      100_ticks,   panasonicDvdPowerStatus,   true);
-constexpr PanasonicDVDStatusAction panasonicDvdOff(     IrPanasonicDVD::ON_OFF,   "Panasonic DVD Off",     100_ticks,   panasonicDvdPowerStatus,   false);
+constexpr PanasonicDvdToggleAction panasonicDvdOnOff(   IrRegistry::ON_OFF,   "Panasonic DVD On/Off",  100_ticks,   panasonicDvdPowerStatus);
+constexpr PanasonicDVDStatusAction panasonicDvdOn(      IrRegistry::ON_OFF,   "Panasonic DVD On",      100_ticks,   panasonicDvdPowerStatus,   true);
+constexpr PanasonicDVDStatusAction panasonicDvdOff(     IrRegistry::ON_OFF,   "Panasonic DVD Off",     100_ticks,   panasonicDvdPowerStatus,   false);
 
 bool blaupunktDvdPowerStatus  = false;
-constexpr BlaupunktDvdAction       blaupunktDvdOnOff(   IrBlaupunktDVD::ON_OFF,   "Blaupunkt DVD On/Off",  100_ticks);
-constexpr BlaupunktDVDStatusAction blaupunktDvdOn(      IrBlaupunktDVD::ON_OFF,   "Blaupunkt DVD On",      100_ticks,   blaupunktDvdPowerStatus,   true);
-constexpr BlaupunktDVDStatusAction blaupunktDvdOff(     IrBlaupunktDVD::ON_OFF,   "Blaupunkt DVD Off",     100_ticks,   blaupunktDvdPowerStatus,   false);
+constexpr BlaupunktDvdToggleAction blaupunktDvdOnOff(   IrRegistry::ON_OFF,   "Blaupunkt DVD On/Off",  100_ticks,   blaupunktDvdPowerStatus);
+constexpr BlaupunktDVDStatusAction blaupunktDvdOn(      IrRegistry::ON_OFF,   "Blaupunkt DVD On",      100_ticks,   blaupunktDvdPowerStatus,   true);
+constexpr BlaupunktDVDStatusAction blaupunktDvdOff(     IrRegistry::ON_OFF,   "Blaupunkt DVD Off",     100_ticks,   blaupunktDvdPowerStatus,   false);
+
+/// Saved device state (see SavedDeviceState)
+__attribute__ ((section(".flexRAM")))
+Nonvolatile<uint32_t> savedState;
+
+/**
+ * Modelled state of the devices kept in the emulated EEPROM (FlexRAM backed by FlexNVM).
+ *
+ * This allows the state to survive resets, deep sleep and loss of power so the devices do not
+ * have to be re-synchronised at start-up.
+ *
+ * Only state reached by commands that have actually been sent is saved.
+ * It is saved once an action has run to completion and the IR queue is empty.
+ * A reset while an action is in progress, cancelled or still transmitting is detected
+ * using a marker in non-initialised RAM and falls back to All Off.
+ * The state saved for the last completed action is used after a loss of power.
+ *
+ * To limit wear the power status of all devices, the TV source and the layout version are packed
+ * into a single word. This is written once for each completed action and only when it changes.
+ * The FTFL spreads the writes over the 8 KiB backing store of the 32 byte EEPROM.
+ */
+class SavedDeviceState : public Flash {
+
+private:
+
+   /// Layout version kept in the top byte of the saved word. Change when the layout changes.
+   static constexpr uint32_t VERSION = 0x01;
+
+   /// Marks an action as in progress
+   static constexpr uint32_t ACTION_IN_PROGRESS = 0x41435401;
+
+   static_assert((eepromSizeInfo[eepromSize].size*MINIMUM_BACKING_RATIO) <= flashPartitionInfo[flashPartition].eeepromSize,
+         "EEPROM backing is too small for the EEPROM size");
+   static_assert(sizeof(savedState) <= eepromSizeInfo[eepromSize].size, "Saved state doesn't fit in EEPROM");
+
+   /// Action in progress marker (not cleared by start-up code)
+   __attribute__ ((section(".noinit")))
+   static inline uint32_t actionMarker;
+
+   /// EEPROM is available
+   bool available = false;
+
+   /// Power status of each device. The index is the bit number in the saved word.
+   static inline bool * const powerStatus[] = {
+         &sonyTvState.power,
+         &teacPvrPowerStatus,
+         &laserDvdPowerStatus,
+         &samsungDvdPowerStatus,
+         &panasonicDvdPowerStatus,
+         &blaupunktDvdPowerStatus,
+   };
+
+   /**
+    * Get modelled device state as a word
+    *
+    * @return Power status (bits 0-7), TV source (bits 8-15) and VERSION (bits 24-31)
+    */
+   static uint32_t getState() {
+      uint32_t state = (VERSION<<24) | (uint32_t(sonyTvState.source)<<8);
+      for (unsigned index=0; index<sizeofArray(powerStatus); index++) {
+         if (*powerStatus[index]) {
+            state |= 1U<<index;
+         }
+      }
+      return state;
+   }
+
+public:
+
+   /**
+    * Initialise the emulated EEPROM.
+    * The FlexNVM is partitioned when first run after the device is programmed.
+    */
+   SavedDeviceState() : Flash() {
+      FlashDriverError_t rc = initialiseEeprom();
+      available = (rc == FLASH_ERR_OK) || (rc == FLASH_ERR_NEW_EEPROM);
+   }
+
+   /**
+    * Restore the device state
+    *
+    * @return true  => State restored
+    * @return false => No valid saved state e.g. EEPROM just partitioned or a reset during an action
+    */
+   bool restore() {
+
+      uint32_t state = available?uint32_t(savedState):0;
+      if ((actionMarker == ACTION_IN_PROGRESS) || ((state>>24) != VERSION)) {
+         console.writeln("No saved device state");
+         return false;
+      }
+      for (unsigned index=0; index<sizeofArray(powerStatus); index++) {
+         *powerStatus[index] = (state & (1U<<index)) != 0;
+      }
+      sonyTvState.source = IrRegistry::Key((state>>8)&0xFF);
+      console.writeln("Restored device state: 0x", state, Radix_16);
+      return true;
+   }
+
+   /**
+    * Save the device state.
+    * This should only be done when all commands changing the modelled state have been sent.
+    * The EEPROM is only written if the state has changed.
+    */
+   void save() {
+
+      actionMarker = 0;
+      if (available && isFlashAvailable()) {
+         savedState = getState();
+      }
+   }
+
+   /**
+    * Record that the devices may not match the modelled state e.g. while an action is in progress.
+    * This only changes RAM so may be done on every poll.
+    */
+   void invalidate() {
+      actionMarker = ACTION_IN_PROGRESS;
+   }
+};
+
+SavedDeviceState savedDeviceState;
 
 /*
- * Action sequences
+ * Action sequences (defined after the pages they show)
  */
-SequenceAction< 8> allOff{"Seq: All Off"};
-SequenceAction<11> watchTv{"Seq: Watch TV"};
-SequenceAction<11> watchSamsungDvd{"Seq: Watch Samsung DVD"};
-SequenceAction<11> watchLaserDvd{"Seq: Watch Laser DVD"};
-SequenceAction<11> watchTeacPvr{"Seq: Watch PVR"};
-SequenceAction<11> watchPanasonicDVD{"Seq: Watch Panasonic DVD"};
-SequenceAction<11> watchBlauPunktDVD{"Seq: Watch Blaupunkt DVD"};
-SequenceAction<11> displayTeacPvrPage{"Seq: Display Teac DVD page"};
-SequenceAction< 2> teacPvrEpisodeGuide{"Seq: Display Teac DVD Numbers page"};
-SequenceAction< 1> showMainPage("Show Main Page");
+extern const SequenceAction<8> allOff;
+extern const SequenceAction<9> watchTv;
+extern const SequenceAction<9> watchSamsungDvd;
+extern const SequenceAction<9> watchLaserDvd;
+extern const SequenceAction<9> watchTeacPvr;
+extern const SequenceAction<9> watchPanasonicDVD;
+extern const SequenceAction<9> watchBlauPunktDVD;
+extern const SequenceAction<1> displayTeacPvrPage;
+extern const SequenceAction<2> teacPvrEpisodeGuide;
+extern const SequenceAction<1> showMainPage;
 
 /*
  * Common buttons
@@ -938,17 +1901,18 @@ constexpr ImageButton<32> sonyTvMuteButton       { sonyTvMute,       Mute     };
  * ============================================================================================
  */
 
-class HelpPage : public PageWithButtons<7> {
+class HelpPage : public PageWithButtons<8> {
 
 protected:
 
-   static inline constexpr TextButton buttons[6] {
+   static inline constexpr TextButton buttons[7] {
       TextButton(laserDvdOnOff,     "Laser DVD"      ),
       TextButton(samsungDvdOnOff,   "Samsung DVD"    ),
       TextButton(teacPvrOnOff,      "Teac PVR"       ),
       TextButton(blaupunktDvdOnOff, "Blaupunkt DVD"  ),
       TextButton(panasonicDvdOnOff, "Panasonic DVD"  ),
       TextButton(sonyTvOnOff,       "Sony TV"        ),
+      TextButton(learnCode,         "Learn Code"     ),
    };
 
 public:
@@ -977,7 +1941,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1027,7 +1991,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1038,26 +2002,26 @@ class SonyTvPage : public PageWithButtons<19> {
 
 protected:
 
-   static inline constexpr SonyTvAction actions[15] = {
-         SonyTvAction{IrSonyTV::Code::NUM1,  "Num 1"   },
-         SonyTvAction{IrSonyTV::Code::NUM2,  "Num 2"   },
-         SonyTvAction{IrSonyTV::Code::NUM3,  "Num 3"   },
-         SonyTvAction{IrSonyTV::Code::UP,    "TV Up"   },
+   static inline constexpr SonyTvKeyAction actions[15] = {
+         SonyTvKeyAction{IrRegistry::NUM1,  "Num 1"   },
+         SonyTvKeyAction{IrRegistry::NUM2,  "Num 2"   },
+         SonyTvKeyAction{IrRegistry::NUM3,  "Num 3"   },
+         SonyTvKeyAction{IrRegistry::UP,    "TV Up"   },
 
-         SonyTvAction{IrSonyTV::Code::NUM4,  "Num 4"   },
-         SonyTvAction{IrSonyTV::Code::NUM5,  "Num 5"   },
-         SonyTvAction{IrSonyTV::Code::NUM6,  "Num 6"   },
-         SonyTvAction{IrSonyTV::Code::DOWN,  "TV Down" },
+         SonyTvKeyAction{IrRegistry::NUM4,  "Num 4"   },
+         SonyTvKeyAction{IrRegistry::NUM5,  "Num 5"   },
+         SonyTvKeyAction{IrRegistry::NUM6,  "Num 6"   },
+         SonyTvKeyAction{IrRegistry::DOWN,  "TV Down" },
 
-         SonyTvAction{IrSonyTV::Code::NUM7,  "Num 7"   },
-         SonyTvAction{IrSonyTV::Code::NUM8,  "Num 8"   },
-         SonyTvAction{IrSonyTV::Code::NUM9,  "Num 9"   },
-         SonyTvAction{IrSonyTV::Code::LEFT,  "TV Left" },
+         SonyTvKeyAction{IrRegistry::NUM7,  "Num 7"   },
+         SonyTvKeyAction{IrRegistry::NUM8,  "Num 8"   },
+         SonyTvKeyAction{IrRegistry::NUM9,  "Num 9"   },
+         SonyTvKeyAction{IrRegistry::LEFT,  "TV Left" },
 
-         SonyTvAction{IrSonyTV::Code::GUIDE, "Guide"   },
-         SonyTvAction{IrSonyTV::Code::NUM0,  "Num 0"   },
+         SonyTvKeyAction{IrRegistry::GUIDE, "Guide"   },
+         SonyTvKeyAction{IrRegistry::NUM0,  "Num 0"   },
 
-         SonyTvAction{IrSonyTV::Code::RIGHT, "TV Right"},
+         SonyTvKeyAction{IrRegistry::RIGHT, "TV Right"},
    };
    static inline constexpr ImageButton<32> buttons[19] = {
          ImageButton<32>( actions[ 0],      One      ),
@@ -1106,7 +2070,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1116,25 +2080,25 @@ public:
 class SamsungDvdPage : public  PageWithButtons<19> {
 
 protected:
-   static inline constexpr SamsungDvdAction actions[15] = {
-      SamsungDvdAction{IrSamsungDVD::Code::REVERSE_SCENE, "DVD Reverse Scene" },
-      SamsungDvdAction{IrSamsungDVD::Code::UP           , "DVD Up"            },
-      SamsungDvdAction{IrSamsungDVD::Code::FORWARD_SCENE, "DVD Forward Scene" },
-      SamsungDvdAction{IrSamsungDVD::Code::PAUSE        , "DVD Pause"         },
-
-      SamsungDvdAction{IrSamsungDVD::Code::LEFT         , "DVD Left"          },
-      SamsungDvdAction{IrSamsungDVD::Code::OK           , "DVD OK"            },
-      SamsungDvdAction{IrSamsungDVD::Code::RIGHT        , "DVD Right"         },
-      SamsungDvdAction{IrSamsungDVD::Code::PLAY         , "DVD Play"          },
-
-      SamsungDvdAction{IrSamsungDVD::Code::REVERSE      , "DVD Fast Reverse"  },
-      SamsungDvdAction{IrSamsungDVD::Code::DOWN         , "DVD Down"          },
-      SamsungDvdAction{IrSamsungDVD::Code::FORWARD      , "DVD Fast Forward"  },
-      SamsungDvdAction{IrSamsungDVD::Code::STOP         , "DVD Halt"          },
-
-      SamsungDvdAction{IrSamsungDVD::Code::EJECT        , "DVD Eject"         },
-      SamsungDvdAction{IrSamsungDVD::Code::MENU         , "DVD Menu"          },
-      SamsungDvdAction{IrSamsungDVD::Code::INFO         , "DVD Info"          },
+   static inline constexpr SamsungDvdKeyAction actions[15] = {
+      SamsungDvdKeyAction{IrRegistry::REVERSE_SCENE, "DVD Reverse Scene" },
+      SamsungDvdKeyAction{IrRegistry::UP           , "DVD Up"            },
+      SamsungDvdKeyAction{IrRegistry::FORWARD_SCENE, "DVD Forward Scene" },
+      SamsungDvdKeyAction{IrRegistry::PAUSE        , "DVD Pause"         },
+
+      SamsungDvdKeyAction{IrRegistry::LEFT         , "DVD Left"          },
+      SamsungDvdKeyAction{IrRegistry::OK           , "DVD OK"            },
+      SamsungDvdKeyAction{IrRegistry::RIGHT        , "DVD Right"         },
+      SamsungDvdKeyAction{IrRegistry::PLAY         , "DVD Play"          },
+
+      SamsungDvdKeyAction{IrRegistry::REVERSE      , "DVD Fast Reverse"  },
+      SamsungDvdKeyAction{IrRegistry::DOWN         , "DVD Down"          },
+      SamsungDvdKeyAction{IrRegistry::FORWARD      , "DVD Fast Forward"  },
+      SamsungDvdKeyAction{IrRegistry::STOP         , "DVD Halt"          },
+
+      SamsungDvdKeyAction{IrRegistry::EJECT        , "DVD Eject"         },
+      SamsungDvdKeyAction{IrRegistry::MENU         , "DVD Menu"          },
+      SamsungDvdKeyAction{IrRegistry::INFO         , "DVD Info"          },
    };
 
    static inline constexpr ImageButton<32> buttons[19] {
@@ -1185,7 +2149,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1195,25 +2159,25 @@ public:
 class LaserDvdPage : public  PageWithButtons<19> {
 
 protected:
-   static inline constexpr LaserDvdAction actions[15] = {
-         LaserDvdAction{IrLaserDVD::Code::REVERSE_SCENE, "DVD Reverse Scene" },
-         LaserDvdAction{IrLaserDVD::Code::UP           , "DVD Up"            },
-         LaserDvdAction{IrLaserDVD::Code::FORWARD_SCENE, "DVD Forward Scene" },
-         LaserDvdAction{IrLaserDVD::Code::PAUSE        , "DVD Pause"         },
-
-         LaserDvdAction{IrLaserDVD::Code::LEFT         , "DVD Left"          },
-         LaserDvdAction{IrLaserDVD::Code::OK           , "DVD OK"            },
-         LaserDvdAction{IrLaserDVD::Code::RIGHT        , "DVD Right"         },
-         LaserDvdAction{IrLaserDVD::Code::PLAY         , "DVD Play"          },
-
-         LaserDvdAction{IrLaserDVD::Code::REVERSE      , "DVD Fast Reverse"  },
-         LaserDvdAction{IrLaserDVD::Code::DOWN         , "DVD Down"          },
-         LaserDvdAction{IrLaserDVD::Code::FORWARD      , "DVD Fast Forward"  },
-         LaserDvdAction{IrLaserDVD::Code::STOP         , "DVD Halt"          },
-
-         LaserDvdAction{IrLaserDVD::Code::EJECT        , "DVD Eject"         },
-         LaserDvdAction{IrLaserDVD::Code::MENU         , "DVD Menu"          },
-         LaserDvdAction{IrLaserDVD::Code::OSD          , "DVD OSD"           },
+   static inline constexpr LaserDvdKeyAction actions[15] = {
+         LaserDvdKeyAction{IrRegistry::REVERSE_SCENE, "DVD Reverse Scene" },
+         LaserDvdKeyAction{IrRegistry::UP           , "DVD Up"            },
+         LaserDvdKeyAction{IrRegistry::FORWARD_SCENE, "DVD Forward Scene" },
+         LaserDvdKeyAction{IrRegistry::PAUSE        , "DVD Pause"         },
+
+         LaserDvdKeyAction{IrRegistry::LEFT         , "DVD Left"          },
+         LaserDvdKeyAction{IrRegistry::OK           , "DVD OK"            },
+         LaserDvdKeyAction{IrRegistry::RIGHT        , "DVD Right"         },
+         LaserDvdKeyAction{IrRegistry::PLAY         , "DVD Play"          },
+
+         LaserDvdKeyAction{IrRegistry::REVERSE      , "DVD Fast Reverse"  },
+         LaserDvdKeyAction{IrRegistry::DOWN         , "DVD Down"          },
+         LaserDvdKeyAction{IrRegistry::FORWARD      , "DVD Fast Forward"  },
+         LaserDvdKeyAction{IrRegistry::STOP         , "DVD Halt"          },
+
+         LaserDvdKeyAction{IrRegistry::EJECT        , "DVD Eject"         },
+         LaserDvdKeyAction{IrRegistry::MENU         , "DVD Menu"          },
+         LaserDvdKeyAction{IrRegistry::OSD          , "DVD OSD"           },
    };
 
    static inline constexpr ImageButton<32> buttons[19] {
@@ -1264,7 +2228,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1274,24 +2238,24 @@ public:
 class PanasonicDvdPage : public  PageWithButtons<19> {
 
 protected:
-   static inline constexpr PanasonicDvdAction actions[14] = {
-      PanasonicDvdAction( IrPanasonicDVD::Code::REVERSE_SCENE, "DVD Reverse Scene" ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::UP           , "DVD Up"            ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::FORWARD_SCENE, "DVD Forward Scene" ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::PAUSE_PLAY   , "DVD Pause"         ),
-
-      PanasonicDvdAction( IrPanasonicDVD::Code::LEFT         , "DVD Left"          ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::OK           , "DVD OK"            ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::RIGHT        , "DVD Right"         ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::PAUSE_PLAY   , "DVD Play"          ),
-
-      PanasonicDvdAction( IrPanasonicDVD::Code::REVERSE      , "DVD Fast Reverse"  ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::DOWN         , "DVD Down"          ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::FORWARD      , "DVD Fast Forward"  ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::STOP         , "DVD Halt"          ),
-
-      PanasonicDvdAction( IrPanasonicDVD::Code::EJECT        , "DVD Eject"         ),
-      PanasonicDvdAction( IrPanasonicDVD::Code::MENU         , "DVD Menu"          ),
+   static inline constexpr PanasonicDvdKeyAction actions[14] = {
+      PanasonicDvdKeyAction( IrRegistry::REVERSE_SCENE, "DVD Reverse Scene" ),
+      PanasonicDvdKeyAction( IrRegistry::UP           , "DVD Up"            ),
+      PanasonicDvdKeyAction( IrRegistry::FORWARD_SCENE, "DVD Forward Scene" ),
+      PanasonicDvdKeyAction( IrRegistry::PAUSE_PLAY   , "DVD Pause"         ),
+
+      PanasonicDvdKeyAction( IrRegistry::LEFT         , "DVD Left"          ),
+      PanasonicDvdKeyAction( IrRegistry::OK           , "DVD OK"            ),
+      PanasonicDvdKeyAction( IrRegistry::RIGHT        , "DVD Right"         ),
+      PanasonicDvdKeyAction( IrRegistry::PAUSE_PLAY   , "DVD Play"          ),
+
+      PanasonicDvdKeyAction( IrRegistry::REVERSE      , "DVD Fast Reverse"  ),
+      PanasonicDvdKeyAction( IrRegistry::DOWN         , "DVD Down"          ),
+      PanasonicDvdKeyAction( IrRegistry::FORWARD      , "DVD Fast Forward"  ),
+      PanasonicDvdKeyAction( IrRegistry::STOP         , "DVD Halt"          ),
+
+      PanasonicDvdKeyAction( IrRegistry::EJECT        , "DVD Eject"         ),
+      PanasonicDvdKeyAction( IrRegistry::MENU         , "DVD Menu"          ),
    };
 
    static inline constexpr ImageButton<32> buttons[18] {
@@ -1341,7 +2305,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1351,25 +2315,25 @@ public:
 class BlaupunktDvdPage : public  PageWithButtons<19> {
 
 protected:
-   static inline constexpr BlaupunktDvdAction actions[15] {
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::REVERSE_SCENE, "DVD Reverse Scene" },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::UP           , "DVD Up"            },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::FORWARD_SCENE, "DVD Forward Scene" },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::PLAY_PAUSE   , "DVD Play/Pause"    },
-
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::LEFT         , "DVD Left"          },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::OK           , "DVD OK"            },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::RIGHT        , "DVD Right"         },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::PLAY_PAUSE   , "DVD Play/Pause"    },
-
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::REVERSE      , "DVD Fast Reverse"  },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::DOWN         , "DVD Down"          },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::FORWARD      , "DVD Fast Forward"  },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::STOP         , "DVD Halt"          },
-
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::EJECT        , "DVD Eject"         },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::MENU         , "DVD Eject"         },
-      BlaupunktDvdAction{IrBlaupunktDVD::Code::OSD          , "DVD OSD"           },
+   static inline constexpr BlaupunktDvdKeyAction actions[15] {
+      BlaupunktDvdKeyAction{IrRegistry::REVERSE_SCENE, "DVD Reverse Scene" },
+      BlaupunktDvdKeyAction{IrRegistry::UP           , "DVD Up"            },
+      BlaupunktDvdKeyAction{IrRegistry::FORWARD_SCENE, "DVD Forward Scene" },
+      BlaupunktDvdKeyAction{IrRegistry::PLAY_PAUSE   , "DVD Play/Pause"    },
+
+      BlaupunktDvdKeyAction{IrRegistry::LEFT         , "DVD Left"          },
+      BlaupunktDvdKeyAction{IrRegistry::OK           , "DVD OK"            },
+      BlaupunktDvdKeyAction{IrRegistry::RIGHT        , "DVD Right"         },
+      BlaupunktDvdKeyAction{IrRegistry::PLAY_PAUSE   , "DVD Play/Pause"    },
+
+      BlaupunktDvdKeyAction{IrRegistry::REVERSE      , "DVD Fast Reverse"  },
+      BlaupunktDvdKeyAction{IrRegistry::DOWN         , "DVD Down"          },
+      BlaupunktDvdKeyAction{IrRegistry::FORWARD      , "DVD Fast Forward"  },
+      BlaupunktDvdKeyAction{IrRegistry::STOP         , "DVD Halt"          },
+
+      BlaupunktDvdKeyAction{IrRegistry::EJECT        , "DVD Eject"         },
+      BlaupunktDvdKeyAction{IrRegistry::MENU         , "DVD Eject"         },
+      BlaupunktDvdKeyAction{IrRegistry::OSD          , "DVD OSD"           },
    };
 
    static inline constexpr ImageButton<32> buttons[19] {
@@ -1420,7 +2384,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1430,33 +2394,33 @@ public:
 class TeacPvrEpgPage : public PageWithButtons<24> {
 
 protected:
-   static inline constexpr TeacPvrAction actions[20] {
-      TeacPvrAction{IrTeacPVR::Code::NUM1,  "Num 1"     },
-      TeacPvrAction{IrTeacPVR::Code::NUM2,  "Num 2"     },
-      TeacPvrAction{IrTeacPVR::Code::NUM3,  "Num 3"     },
-      TeacPvrAction{IrTeacPVR::Code::UP,    "PVR Up"    },
+   static inline constexpr TeacPvrKeyAction actions[20] {
+      TeacPvrKeyAction{IrRegistry::NUM1,  "Num 1"     },
+      TeacPvrKeyAction{IrRegistry::NUM2,  "Num 2"     },
+      TeacPvrKeyAction{IrRegistry::NUM3,  "Num 3"     },
+      TeacPvrKeyAction{IrRegistry::UP,    "PVR Up"    },
 
-      TeacPvrAction{IrTeacPVR::Code::NUM4,  "Num 4"     },
-      TeacPvrAction{IrTeacPVR::Code::NUM5,  "Num 5"     },
-      TeacPvrAction{IrTeacPVR::Code::NUM6,  "Num 6"     },
-      TeacPvrAction{IrTeacPVR::Code::DOWN,  "PVR Down"  },
+      TeacPvrKeyAction{IrRegistry::NUM4,  "Num 4"     },
+      TeacPvrKeyAction{IrRegistry::NUM5,  "Num 5"     },
+      TeacPvrKeyAction{IrRegistry::NUM6,  "Num 6"     },
+      TeacPvrKeyAction{IrRegistry::DOWN,  "PVR Down"  },
 
-      TeacPvrAction{IrTeacPVR::Code::NUM7,  "Num 7"     },
-      TeacPvrAction{IrTeacPVR::Code::NUM8,  "Num 8"     },
-      TeacPvrAction{IrTeacPVR::Code::NUM9,  "Num 9"     },
-      TeacPvrAction{IrTeacPVR::Code::LEFT,  "PVR Left"  },
+      TeacPvrKeyAction{IrRegistry::NUM7,  "Num 7"     },
+      TeacPvrKeyAction{IrRegistry::NUM8,  "Num 8"     },
+      TeacPvrKeyAction{IrRegistry::NUM9,  "Num 9"     },
+      TeacPvrKeyAction{IrRegistry::LEFT,  "PVR Left"  },
 
 
-      TeacPvrAction{IrTeacPVR::Code::EXIT,  "PVR Exit"  },
-      TeacPvrAction{IrTeacPVR::Code::NUM0,  "Num 0"     },
-      TeacPvrAction{IrTeacPVR::Code::OK,    "PVR OK"    },
-      TeacPvrAction{IrTeacPVR::Code::RIGHT, "PVR Right" },
+      TeacPvrKeyAction{IrRegistry::EXIT,  "PVR Exit"  },
+      TeacPvrKeyAction{IrRegistry::NUM0,  "Num 0"     },
+      TeacPvrKeyAction{IrRegistry::OK,    "PVR OK"    },
+      TeacPvrKeyAction{IrRegistry::RIGHT, "PVR Right" },
 
 
-      TeacPvrAction{IrTeacPVR::Code::RED,   "PVR Red"   },
-      TeacPvrAction{IrTeacPVR::Code::GREEN, "PVR Green" },
-      TeacPvrAction{IrTeacPVR::Code::YELLOW,"PVR Yellow"},
-      TeacPvrAction{IrTeacPVR::Code::BLUE,  "PVR Blue"  },
+      TeacPvrKeyAction{IrRegistry::RED,   "PVR Red"   },
+      TeacPvrKeyAction{IrRegistry::GREEN, "PVR Green" },
+      TeacPvrKeyAction{IrRegistry::YELLOW,"PVR Yellow"},
+      TeacPvrKeyAction{IrRegistry::BLUE,  "PVR Blue"  },
    };
 
 public:
@@ -1507,7 +2471,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1519,29 +2483,29 @@ TeacPvrEpgPage     teacPvrEpgPage;
 class TeacPvrPage : public PageWithButtons<24> {
 
 protected:
-   static inline constexpr TeacPvrAction actions[18] {
-      TeacPvrAction{IrTeacPVR::Code::REVERSE_SCENE, "PVR Reverse Scene" },
-      TeacPvrAction{IrTeacPVR::Code::UP           , "PVR Up"            },
-      TeacPvrAction{IrTeacPVR::Code::FORWARD_SCENE, "PVR Forward Scene" },
-      TeacPvrAction{IrTeacPVR::Code::PAUSE        , "PVR Pause"         },
-
-      TeacPvrAction{IrTeacPVR::Code::LEFT         , "PVR Left"          },
-      TeacPvrAction{IrTeacPVR::Code::OK           , "PVR OK"            },
-      TeacPvrAction{IrTeacPVR::Code::RIGHT        , "PVR Right"         },
-      TeacPvrAction{IrTeacPVR::Code::PLAY         , "PVR Play"          },
-
-      TeacPvrAction{IrTeacPVR::Code::REVERSE      , "PVR Fast Reverse"  },
-      TeacPvrAction{IrTeacPVR::Code::DOWN         , "PVR Down"          },
-      TeacPvrAction{IrTeacPVR::Code::FORWARD      , "PVR Fast Forward"  },
-      TeacPvrAction{IrTeacPVR::Code::STOP         , "PVR Halt"          },
-
-      TeacPvrAction{IrTeacPVR::Code::MENU         , "PVR Menu"          },
-
-      TeacPvrAction{IrTeacPVR::Code::RED          , "PVR Red"           },
-      TeacPvrAction{IrTeacPVR::Code::GREEN        , "PVR Green"         },
-      TeacPvrAction{IrTeacPVR::Code::YELLOW       , "PVR Yellow"        },
-      TeacPvrAction{IrTeacPVR::Code::BLUE         , "PVR Blue"          },
-      TeacPvrAction{IrTeacPVR::Code::EXIT         , "PVR EXIT"          }
+   static inline constexpr TeacPvrKeyAction actions[18] {
+      TeacPvrKeyAction{IrRegistry::REVERSE_SCENE, "PVR Reverse Scene" },
+      TeacPvrKeyAction{IrRegistry::UP           , "PVR Up"            },
+      TeacPvrKeyAction{IrRegistry::FORWARD_SCENE, "PVR Forward Scene" },
+      TeacPvrKeyAction{IrRegistry::PAUSE        , "PVR Pause"         },
+
+      TeacPvrKeyAction{IrRegistry::LEFT         , "PVR Left"          },
+      TeacPvrKeyAction{IrRegistry::OK           , "PVR OK"            },
+      TeacPvrKeyAction{IrRegistry::RIGHT        , "PVR Right"         },
+      TeacPvrKeyAction{IrRegistry::PLAY         , "PVR Play"          },
+
+      TeacPvrKeyAction{IrRegistry::REVERSE      , "PVR Fast Reverse"  },
+      TeacPvrKeyAction{IrRegistry::DOWN         , "PVR Down"          },
+      TeacPvrKeyAction{IrRegistry::FORWARD      , "PVR Fast Forward"  },
+      TeacPvrKeyAction{IrRegistry::STOP         , "PVR Halt"          },
+
+      TeacPvrKeyAction{IrRegistry::MENU         , "PVR Menu"          },
+
+      TeacPvrKeyAction{IrRegistry::RED          , "PVR Red"           },
+      TeacPvrKeyAction{IrRegistry::GREEN        , "PVR Green"         },
+      TeacPvrKeyAction{IrRegistry::YELLOW       , "PVR Yellow"        },
+      TeacPvrKeyAction{IrRegistry::BLUE         , "PVR Blue"          },
+      TeacPvrKeyAction{IrRegistry::EXIT         , "PVR EXIT"          }
    };
    static inline constexpr ImageButton<32> buttons[16] {
       ImageButton<32>( actions[ 0],       ReverseScene ),
@@ -1595,7 +2559,7 @@ public:
       };
       const Action *action = buttonActions[code];
       if (action != nullptr) {
-         buttonActions[code]->action();
+         scheduler.start(*action);
          return true;
       }
       return false;
@@ -1616,105 +2580,95 @@ SamsungDvdPage    samsungDvdPage;
 PanasonicDvdPage  panasonicDvdPage;
 BlaupunktDvdPage  blaupunktDvdPage;
 
-MessageAction completeMessage("Complete");
-
-void initialiseGuiAndActions() {
-
-   showMainPage.add(mainPage);
-
-   allOff.add(sonyTvOff);
-   allOff.add(mainPage);
-
-   allOff.add(laserDvdOff);
-   allOff.add(teacPvrOff);
-   allOff.add(samsungDvdOff);
-   allOff.add(panasonicDvdOff);
-   allOff.add(blaupunktDvdOff);
-   allOff.add(completeMessage);
-
-   watchTv.add(sonyTvOn);
-   watchTv.add(sonyTvHome);
-   watchTv.add(sonyTvReturn);
-   watchTv.add(sonyTvSourceTv);
-   watchTv.add(sonyTvPage);
-
-   watchTv.add(laserDvdOff);
-   watchTv.add(teacPvrOff);
-   watchTv.add(samsungDvdOff);
-   watchTv.add(panasonicDvdOff);
-   watchTv.add(blaupunktDvdOff);
-   watchTv.add(completeMessage);
-
-   watchTeacPvr.add(sonyTvOn);
-   watchTeacPvr.add(sonyTvHome);
-   watchTeacPvr.add(sonyTvReturn);
-   watchTeacPvr.add(sonyTvSourceHdmi2_PVR);
-
-   watchTeacPvr.add(teacPvrOn);
-   watchTeacPvr.add(laserDvdOff);
-   watchTeacPvr.add(teacPvrPage);
-   watchTeacPvr.add(samsungDvdOff);
-   watchTeacPvr.add(panasonicDvdOff);
-   watchTeacPvr.add(blaupunktDvdOff);
-   watchTeacPvr.add(completeMessage);
-
-   watchLaserDvd.add(sonyTvOn);
-   watchLaserDvd.add(sonyTvHome);
-   watchLaserDvd.add(sonyTvReturn);
-   watchLaserDvd.add(sonyTvSourceHdmi4_DVD_Laser);
-
-   watchLaserDvd.add(laserDvdOn);
-   watchLaserDvd.add(laserDvdPage);
-   watchLaserDvd.add(teacPvrOff);
-   watchLaserDvd.add(samsungDvdOff);
-   watchLaserDvd.add(panasonicDvdOff);
-   watchLaserDvd.add(blaupunktDvdOff);
-   watchLaserDvd.add(completeMessage);
-
-   watchSamsungDvd.add(sonyTvOn);
-   watchSamsungDvd.add(sonyTvHome);
-   watchSamsungDvd.add(sonyTvReturn);
-   watchSamsungDvd.add(sonyTvSourceHdmi3_DVD_Samsung);
-
-   watchSamsungDvd.add(laserDvdOff);
-   watchSamsungDvd.add(teacPvrOff);
-   watchSamsungDvd.add(samsungDvdOn);
-   watchSamsungDvd.add(samsungDvdPage);
-   watchSamsungDvd.add(panasonicDvdOff);
-   watchSamsungDvd.add(blaupunktDvdOff);
-   watchSamsungDvd.add(completeMessage);
-
-   watchPanasonicDVD.add(sonyTvOn);
-   watchPanasonicDVD.add(sonyTvHome);
-   watchPanasonicDVD.add(sonyTvReturn);
-   watchPanasonicDVD.add(sonyTvSourceHdmi2_PVR);
-
-   watchPanasonicDVD.add(laserDvdOff);
-   watchPanasonicDVD.add(teacPvrOff);
-   watchPanasonicDVD.add(samsungDvdOff);
-   watchPanasonicDVD.add(panasonicDvdOn);
-   watchPanasonicDVD.add(panasonicDvdPage);
-   watchPanasonicDVD.add(blaupunktDvdOff);
-   watchPanasonicDVD.add(completeMessage);
-
-   watchBlauPunktDVD.add(sonyTvOn);
-   watchBlauPunktDVD.add(sonyTvHome);
-   watchBlauPunktDVD.add(sonyTvReturn);
-   watchBlauPunktDVD.add(sonyTvSourceHdmi2_PVR);
-
-   watchBlauPunktDVD.add(laserDvdOff);
-   watchBlauPunktDVD.add(teacPvrOff);
-   watchBlauPunktDVD.add(samsungDvdOff);
-   watchBlauPunktDVD.add(panasonicDvdOff);
-   watchBlauPunktDVD.add(blaupunktDvdOn);
-   watchBlauPunktDVD.add(blaupunktDvdPage);
-   watchBlauPunktDVD.add(completeMessage);
-
-   displayTeacPvrPage.add(teacPvrPage);
-
-   teacPvrEpisodeGuide.add(*new TeacPvrAction(IrTeacPVR::Code::EPG, "PVR EPG" ));
-   teacPvrEpisodeGuide.add(teacPvrEpgPage);
-}
+constexpr MessageAction completeMessage("Complete");
+
+constexpr TeacPvrAction teacPvrEpg(IrRegistry::EPG, "PVR EPG");
+
+constexpr SequenceAction<1> showMainPage{"Show Main Page",
+      mainPage};
+
+constexpr SequenceAction<8> allOff{"Seq: All Off",
+      sonyTvOff,
+      mainPage,
+      laserDvdOff,
+      teacPvrOff,
+      samsungDvdOff,
+      panasonicDvdOff,
+      blaupunktDvdOff,
+      completeMessage};
+
+constexpr SequenceAction<9> watchTv{"Seq: Watch TV",
+      sonyTvPowerOn,
+      sonyTvWatchTv,
+      sonyTvPage,
+      laserDvdOff,
+      teacPvrOff,
+      samsungDvdOff,
+      panasonicDvdOff,
+      blaupunktDvdOff,
+      completeMessage};
+
+constexpr SequenceAction<9> watchTeacPvr{"Seq: Watch PVR",
+      sonyTvPowerOn,
+      sonyTvWatchHdmi2,
+      teacPvrOn,
+      laserDvdOff,
+      teacPvrPage,
+      samsungDvdOff,
+      panasonicDvdOff,
+      blaupunktDvdOff,
+      completeMessage};
+
+constexpr SequenceAction<9> watchLaserDvd{"Seq: Watch Laser DVD",
+      sonyTvPowerOn,
+      sonyTvWatchHdmi4,
+      laserDvdOn,
+      laserDvdPage,
+      teacPvrOff,
+      samsungDvdOff,
+      panasonicDvdOff,
+      blaupunktDvdOff,
+      completeMessage};
+
+constexpr SequenceAction<9> watchSamsungDvd{"Seq: Watch Samsung DVD",
+      sonyTvPowerOn,
+      sonyTvWatchHdmi3,
+      laserDvdOff,
+      teacPvrOff,
+      samsungDvdOn,
+      samsungDvdPage,
+      panasonicDvdOff,
+      blaupunktDvdOff,
+      completeMessage};
+
+constexpr SequenceAction<9> watchPanasonicDVD{"Seq: Watch Panasonic DVD",
+      sonyTvPowerOn,
+      sonyTvWatchHdmi2,
+      laserDvdOff,
+      teacPvrOff,
+      samsungDvdOff,
+      panasonicDvdOn,
+      panasonicDvdPage,
+      blaupunktDvdOff,
+      completeMessage};
+
+constexpr SequenceAction<9> watchBlauPunktDVD{"Seq: Watch Blaupunkt DVD",
+      sonyTvPowerOn,
+      sonyTvWatchHdmi2,
+      laserDvdOff,
+      teacPvrOff,
+      samsungDvdOff,
+      panasonicDvdOff,
+      blaupunktDvdOn,
+      blaupunktDvdPage,
+      completeMessage};
+
+constexpr SequenceAction<1> displayTeacPvrPage{"Seq: Display Teac DVD page",
+      teacPvrPage};
+
+constexpr SequenceAction<2> teacPvrEpisodeGuide{"Seq: Display Teac DVD Numbers page",
+      teacPvrEpg,
+      teacPvrEpgPage};
 
 #if 0
 void getTouch(unsigned &touchX, unsigned &touchY) {
@@ -1813,6 +2767,8 @@ void buttonCallback() {
    static uint8_t  poll  = 0;
    static unsigned count = 0;
 
+   IrClock::tick(BUTTON_TIMER_PERIOD_MS*1000);
+
    uint8_t current = Switches::read();
 
    if (current != poll) {
@@ -1852,7 +2808,7 @@ void initialiseMiscellaneous() {
 
       PitChannelEnable_Enabled ,   // (pit_tctrl_ten[0])         Timer Channel Enable - Channel enabled
       PitChannelAction_Interrupt , // (pit_tctrl_tie[0])         Action on timer event - Interrupt
-      479999_ticks,                // (pit_ldval_tsv[0])         Reload value channel 0
+      479999_ticks,                // (pit_ldval_tsv[0])         Reload value channel 0 - BUTTON_TIMER_PERIOD_MS
 
       NvicPriority_Normal ,        // (irqLevel_Ch0)             IRQ priority level for Ch0 - Normal
       buttonCallback,              // (handlerName_Ch0)          User declared event handler
@@ -1884,7 +2840,7 @@ void llwuCallback() {
 void suspend() {
 
    spi.disable();
-   Cmt::disable();
+   IrRemote::disable();
 
 //   PowerEnable::off();
 //
@@ -1913,6 +2869,13 @@ void suspend() {
 //   Smc::enterStopMode(SmcStopMode_LowLeakageStop);
 }
 
+bool isKeyHeld() {
+
+   unsigned touchX, touchY;
+
+   return (currentButton != 0) || touchInterface.checkRawTouch(touchX, touchY);
+}
+
 ButtonCode getButton() {
 
    if (buttonState == currentButton) {
@@ -2041,14 +3004,20 @@ int main() {
    unsigned touchX, touchY;
 
    initialiseMiscellaneous();
+   IrTiming::initialise();
 
    tft.setBackgroundColour(BACKGROUND_COLOUR);
    tft.clear();
 
-   initialiseGuiAndActions();
 
-   allOff.action();
-   screen.setBusy(false);
+   if (savedDeviceState.restore()) {
+      // Devices are assumed to be unchanged since the state was saved
+      scheduler.start(showMainPage);
+   }
+   else {
+      // Re-synchronise the devices
+      scheduler.start(allOff);
+   }
 
    console.setEcho(EchoMode_Off);
    console.setBlocking(BlockingMode_Off);
@@ -2057,6 +3026,7 @@ int main() {
 
    unsigned idleCount = 0;
    bool reinitialise  = true;
+   bool touchReleased = true;
 
    touchInterface.setInterruptHandler(touchHandler);
 
@@ -2091,6 +3061,27 @@ int main() {
          //      }
       }
 
+      if constexpr (IrTiming::enabled) {
+         // Console commands - 't' => report CMT interrupt timing, 'c' => clear timing
+         switch(console.readChar()) {
+            case 't': IrTiming::report(); break;
+            case 'c': IrTiming::clear();  break;
+            default: break;
+         }
+      }
+
+      if (scheduler.isComplete() && !IrRemote::isBusy()) {
+         // All commands of the last action have been sent
+         savedDeviceState.save();
+      }
+      else {
+         // Action in progress or cancelled - devices may not match the model until it completes
+         savedDeviceState.invalidate();
+      }
+
+      // Continue action in progress
+      scheduler.poll();
+
       if (reinitialise) {
          reinitialise = false;
          tft.awaken();
@@ -2098,22 +3089,30 @@ int main() {
          waitMS(500);
       }
       else if (touchInterface.checkTouch(touchX, touchY)) {
-         tft.setColour(GREEN);
-         tft.drawCircle(touchX,touchY, 10);
          idleCount = 0;
-         //         console.writeln("\nLooking for touch @(", touchX, ",", touchY, ") ");
-         if (!screen.findAndExecuteHandler(touchX, touchY)) {
-            waitMS(100);
+         if (touchReleased) {
+            // Only act on a new touch - a held touch belongs to the action it started
+            touchReleased = false;
+            tft.setColour(GREEN);
+            tft.drawCircle(touchX,touchY, 10);
+            //         console.writeln("\nLooking for touch @(", touchX, ",", touchY, ") ");
+            if (!screen.findAndExecuteHandler(touchX, touchY)) {
+               // Touch away from buttons cancels action in progress
+               scheduler.cancel();
+            }
          }
-         continue;
       }
       else if ((buttonCode = getButton()) != Button_None) {
-         screen.setBusy(true);
+         touchReleased = true;
          screen.handleButton(buttonCode);
-         screen.setBusy(false);
          idleCount = 0;
       }
       else {
+         touchReleased = true;
+         if (IrRemote::isBusy() || scheduler.isRunning()) {
+            // Don't sleep while an action is in progress or queued IR transmissions are still draining
+            idleCount = 0;
+         }
          idleCount++;
          if (idleCount>200) {
             ButtonTimerChannel::disableNvicInterrupts();
@@ -2135,7 +3134,8 @@ int main() {
             reinitialise = true;
          }
       }
-      waitMS(100);
+      // Poll more often while an action is waiting
+      waitMS(scheduler.isRunning()?10:100);
    }
    return 0;
 }
@@ -16,6 +16,8 @@
 #include "../Sources/hardware.h"
 
 #include "cmt.h"
+#include "dma.h"
+#include "ftm.h"
 #include "gpio.h"
 #include "llwu.h"
 #include "pit.h"
@@ -188,11 +190,6 @@ void SVC_Handler(void)                        WEAK_DEFAULT_HANDLER;
 void DebugMon_Handler(void)                   WEAK_DEFAULT_HANDLER;
 void PendSV_Handler(void)                     WEAK_DEFAULT_HANDLER;
 void SysTick_Handler(void)                    WEAK_DEFAULT_HANDLER;
-void DMA0_Ch0_IRQHandler(void)                WEAK_DEFAULT_HANDLER;
-void DMA0_Ch1_IRQHandler(void)                WEAK_DEFAULT_HANDLER;
-void DMA0_Ch2_IRQHandler(void)                WEAK_DEFAULT_HANDLER;
-void DMA0_Ch3_IRQHandler(void)                WEAK_DEFAULT_HANDLER;
-void DMA0_Error_IRQHandler(void)              WEAK_DEFAULT_HANDLER;
 void FTFL_Command_IRQHandler(void)            WEAK_DEFAULT_HANDLER;
 void FTFL_ReadCollision_IRQHandler(void)      WEAK_DEFAULT_HANDLER;
 void PMC_IRQHandler(void)                     WEAK_DEFAULT_HANDLER;
@@ -211,7 +208,6 @@ void UART2_Error_IRQHandler(void)             WEAK_DEFAULT_HANDLER;
 void ADC0_IRQHandler(void)                    WEAK_DEFAULT_HANDLER;
 void CMP0_IRQHandler(void)                    WEAK_DEFAULT_HANDLER;
 void CMP1_IRQHandler(void)                    WEAK_DEFAULT_HANDLER;
-void FTM0_IRQHandler(void)                    WEAK_DEFAULT_HANDLER;
 void FTM1_IRQHandler(void)                    WEAK_DEFAULT_HANDLER;
 void RTC_Alarm_IRQHandler(void)               WEAK_DEFAULT_HANDLER;
 void RTC_Seconds_IRQHandler(void)             WEAK_DEFAULT_HANDLER;
@@ -256,11 +252,11 @@ VectorTable const __vector_table = {
       SysTick_Handler,                         /*   15,   -1  System Tick Timer                                                                */
 
                                                /* External Interrupts */
-      DMA0_Ch0_IRQHandler,                     /*   16,    0  Direct memory access controller                                                  */
-      DMA0_Ch1_IRQHandler,                     /*   17,    1  Direct memory access controller                                                  */
-      DMA0_Ch2_IRQHandler,                     /*   18,    2  Direct memory access controller                                                  */
-      DMA0_Ch3_IRQHandler,                     /*   19,    3  Direct memory access controller                                                  */
-      DMA0_Error_IRQHandler,                   /*   20,    4  DMA error interrupt                                                              */
+      Dma0::irqHandler<Dma0::IrqNum_Ch0>,      /*   16,    0  Direct memory access controller                                                  */
+      Dma0::irqHandler<Dma0::IrqNum_Ch1>,      /*   17,    1  Direct memory access controller                                                  */
+      Dma0::irqHandler<Dma0::IrqNum_Ch2>,      /*   18,    2  Direct memory access controller                                                  */
+      Dma0::irqHandler<Dma0::IrqNum_Ch3>,      /*   19,    3  Direct memory access controller                                                  */
+      Dma0::irqHandler<Dma0::IrqNum_Error>,    /*   20,    4  DMA error interrupt                                                              */
       Default_Handler,                         /*   21,    5                                                                                   */
       FTFL_Command_IRQHandler,                 /*   22,    6  Flash Memory Interface                                                           */
       FTFL_ReadCollision_IRQHandler,           /*   23,    7  Flash Memory Interface                                                           */
@@ -281,7 +277,7 @@ VectorTable const __vector_table = {
       ADC0_IRQHandler,                         /*   38,   22  Analogue to Digital Converter                                                    */
       CMP0_IRQHandler,                         /*   39,   23  High-Speed Comparator                                                            */
       CMP1_IRQHandler,                         /*   40,   24  High-Speed Comparator                                                            */
-      FTM0_IRQHandler,                         /*   41,   25  FlexTimer Module                                                                 */
+      Ftm0::irqHandler,                        /*   41,   25  FlexTimer Module                                                                 */
       FTM1_IRQHandler,                         /*   42,   26  FlexTimer Module                                                                 */
       Cmt::irqHandler,                         /*   43,   27  Carrier Modulator Transmitter                                                    */
       RTC_Alarm_IRQHandler,                    /*   44,   28  Real Time Clock                                                                  */